@@ -0,0 +1,146 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "RmlUi_Backend.h"
+#include "RmlUi_Platform_Headless.h"
+#include "RmlUi_Renderer_Software.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Profiling.h>
+#include <stdlib.h>
+
+/**
+    Global data used by this backend.
+
+    Lifetime governed by the calls to Backend::Initialize() and Backend::Shutdown().
+
+    Instead of opening a window, frames are rendered on the CPU. The following environment variables control its behavior:
+     - RMLUI_HEADLESS_FRAMES: The number of frames to render before requesting exit, one by default.
+     - RMLUI_HEADLESS_OUTPUT: When set, the last rendered frame is written to a PNG file at this path during shutdown.
+ */
+struct BackendData {
+	SystemInterface_Headless system_interface;
+	RenderInterface_Software render_interface;
+	Rml::Vector2i window_size;
+	bool context_dimensions_dirty = true;
+
+	int num_frames_to_render = 1;
+	int num_frames_rendered = 0;
+	bool running = true;
+	Rml::String output_path;
+};
+static Rml::UniquePtr<BackendData> data;
+
+bool Backend::Initialize(const char* /*window_name*/, int width, int height, bool /*allow_resize*/)
+{
+	RMLUI_ASSERT(!data);
+
+	data = Rml::MakeUnique<BackendData>();
+	data->window_size = Rml::Vector2i(width, height);
+	data->render_interface.SetViewport(width, height);
+
+	if (const char* frames = getenv("RMLUI_HEADLESS_FRAMES"))
+		data->num_frames_to_render = Rml::Math::Max(atoi(frames), 1);
+	if (const char* output = getenv("RMLUI_HEADLESS_OUTPUT"))
+		data->output_path = output;
+
+	return true;
+}
+
+void Backend::Shutdown()
+{
+	RMLUI_ASSERT(data);
+
+	if (!data->output_path.empty())
+	{
+		const RenderInterface_Software& render_interface = data->render_interface;
+		if (!RmlHeadless::SaveImagePNG(data->output_path, render_interface.GetColorBuffer(), render_interface.GetViewportWidth(),
+				render_interface.GetViewportHeight()))
+			Rml::Log::Message(Rml::Log::LT_ERROR, "Could not write rendered frame to '%s'.", data->output_path.c_str());
+	}
+
+	data.reset();
+}
+
+Rml::SystemInterface* Backend::GetSystemInterface()
+{
+	RMLUI_ASSERT(data);
+	return &data->system_interface;
+}
+
+Rml::RenderInterface* Backend::GetRenderInterface()
+{
+	RMLUI_ASSERT(data);
+	return &data->render_interface;
+}
+
+bool Backend::ProcessEvents(Rml::Context* context, KeyDownCallback /*key_down_callback*/, bool /*power_save*/)
+{
+	RMLUI_ASSERT(data && context);
+
+	if (data->context_dimensions_dirty)
+	{
+		data->context_dimensions_dirty = false;
+		context->SetDimensions(data->window_size);
+	}
+
+	// There are no events to process, instead exit once the requested number of frames have been rendered.
+	if (data->num_frames_rendered >= data->num_frames_to_render)
+		data->running = false;
+
+	const bool result = data->running;
+	if (!result)
+	{
+		data->running = true;
+		data->num_frames_rendered = 0;
+	}
+	return result;
+}
+
+void Backend::RequestExit()
+{
+	RMLUI_ASSERT(data);
+	data->running = false;
+}
+
+void Backend::BeginFrame()
+{
+	RMLUI_ASSERT(data);
+	data->render_interface.BeginFrame();
+	data->render_interface.Clear();
+}
+
+void Backend::PresentFrame()
+{
+	RMLUI_ASSERT(data);
+	data->render_interface.EndFrame();
+	data->num_frames_rendered += 1;
+
+	// Optional, used to mark frames during performance profiling.
+	RMLUI_FrameMark;
+}
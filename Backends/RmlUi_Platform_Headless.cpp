@@ -0,0 +1,157 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "RmlUi_Platform_Headless.h"
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+
+SystemInterface_Headless::SystemInterface_Headless()
+{
+	start_time = std::chrono::steady_clock::now();
+}
+
+SystemInterface_Headless::~SystemInterface_Headless() {}
+
+double SystemInterface_Headless::GetElapsedTime()
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+	return elapsed.count();
+}
+
+void SystemInterface_Headless::SetClipboardText(const Rml::String& text)
+{
+	clipboard_text = text;
+}
+
+void SystemInterface_Headless::GetClipboardText(Rml::String& text)
+{
+	text = clipboard_text;
+}
+
+namespace {
+
+uint32_t UpdateCRC32(uint32_t crc, const Rml::byte* data, size_t size)
+{
+	static uint32_t table[256] = {};
+	static bool table_initialized = false;
+	if (!table_initialized)
+	{
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t value = i;
+			for (int k = 0; k < 8; k++)
+				value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+			table[i] = value;
+		}
+		table_initialized = true;
+	}
+
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++)
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+void AppendUint32(Rml::Vector<Rml::byte>& out, uint32_t value)
+{
+	out.push_back(Rml::byte(value >> 24));
+	out.push_back(Rml::byte(value >> 16));
+	out.push_back(Rml::byte(value >> 8));
+	out.push_back(Rml::byte(value));
+}
+
+void AppendChunk(Rml::Vector<Rml::byte>& out, const char* type, const Rml::Vector<Rml::byte>& chunk_data)
+{
+	AppendUint32(out, (uint32_t)chunk_data.size());
+	const size_t type_offset = out.size();
+	out.insert(out.end(), type, type + 4);
+	out.insert(out.end(), chunk_data.begin(), chunk_data.end());
+	AppendUint32(out, UpdateCRC32(0, out.data() + type_offset, out.size() - type_offset));
+}
+
+} // namespace
+
+bool RmlHeadless::SaveImagePNG(const Rml::String& path, const Rml::byte* data, int width, int height)
+{
+	if (width <= 0 || height <= 0)
+		return false;
+
+	// Each row is prefixed by its filter type, here always zero (none).
+	const size_t row_size = size_t(width) * 4;
+	Rml::Vector<Rml::byte> raw;
+	raw.reserve((row_size + 1) * size_t(height));
+	for (int y = 0; y < height; y++)
+	{
+		raw.push_back(0);
+		raw.insert(raw.end(), data + size_t(y) * row_size, data + size_t(y + 1) * row_size);
+	}
+
+	// Store the rows in a zlib stream of uncompressed deflate blocks, trading file size for speed and simplicity.
+	Rml::Vector<Rml::byte> idat = {0x78, 0x01};
+	const size_t max_block_size = 0xFFFF;
+	uint32_t adler_a = 1, adler_b = 0;
+	for (size_t offset = 0; offset < raw.size(); offset += max_block_size)
+	{
+		const size_t block_size = std::min(max_block_size, raw.size() - offset);
+		const bool final_block = (offset + block_size == raw.size());
+		idat.push_back(final_block ? 1 : 0);
+		idat.push_back(Rml::byte(block_size));
+		idat.push_back(Rml::byte(block_size >> 8));
+		idat.push_back(Rml::byte(~block_size));
+		idat.push_back(Rml::byte(~block_size >> 8));
+		idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + block_size);
+
+		for (size_t i = offset; i < offset + block_size; i++)
+		{
+			adler_a = (adler_a + raw[i]) % 65521;
+			adler_b = (adler_b + adler_a) % 65521;
+		}
+	}
+	AppendUint32(idat, (adler_b << 16) | adler_a);
+
+	Rml::Vector<Rml::byte> header;
+	AppendUint32(header, (uint32_t)width);
+	AppendUint32(header, (uint32_t)height);
+	// Bit depth 8, color type 6 (RGBA), default compression, filter, and no interlacing.
+	header.insert(header.end(), {8, 6, 0, 0, 0});
+
+	Rml::Vector<Rml::byte> file = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	AppendChunk(file, "IHDR", header);
+	AppendChunk(file, "IDAT", idat);
+	AppendChunk(file, "IEND", {});
+
+	FILE* handle = fopen(path.c_str(), "wb");
+	if (!handle)
+		return false;
+
+	const bool success = (fwrite(file.data(), 1, file.size(), handle) == file.size());
+	fclose(handle);
+
+	return success;
+}
@@ -55,6 +55,7 @@
 static const char* shader_main_vertex = RMLUI_SHADER_HEADER R"(
 uniform vec2 _translate;
 uniform mat4 _transform;
+uniform vec4 _colorModulation;
 
 in vec2 inPosition;
 in vec4 inColor0;
@@ -65,7 +66,7 @@ out vec4 fragColor;
 
 void main() {
 	fragTexCoord = inTexCoord0;
-	fragColor = inColor0;
+	fragColor = inColor0 * _colorModulation;
 
 	vec2 translatedPos = inPosition + _translate.xy;
 	vec4 outPos = _transform * vec4(translatedPos, 0, 1);
@@ -86,6 +87,21 @@ void main() {
 	finalColor = fragColor * texColor;
 }
 )";
+static const char* shader_main_fragment_distance_field = RMLUI_SHADER_HEADER R"(
+uniform sampler2D _tex;
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+out vec4 finalColor;
+
+void main() {
+	// Threshold the distance at the outline, anti-aliased over the width of a pixel on screen.
+	float distance = texture(_tex, fragTexCoord).a - 128.0 / 255.0;
+	float distance_per_pixel = max(length(vec2(dFdx(distance), dFdy(distance))), 1.0e-5);
+	float coverage = clamp(distance / distance_per_pixel + 0.5, 0.0, 1.0);
+	finalColor = vec4(fragColor.rgb, fragColor.a * coverage);
+}
+)";
 static const char* shader_main_fragment_color = RMLUI_SHADER_HEADER R"(
 in vec2 fragTexCoord;
 in vec4 fragColor;
@@ -99,8 +115,8 @@ void main() {
 
 namespace Gfx {
 
-enum class ProgramUniform { Translate, Transform, Tex, Count };
-static const char* const program_uniform_names[(size_t)ProgramUniform::Count] = {"_translate", "_transform", "_tex"};
+enum class ProgramUniform { Translate, Transform, ColorModulation, Tex, Count };
+static const char* const program_uniform_names[(size_t)ProgramUniform::Count] = {"_translate", "_transform", "_colorModulation", "_tex"};
 
 enum class VertexAttribute { Position, Color0, TexCoord0, Count };
 static const char* const vertex_attribute_names[(size_t)VertexAttribute::Count] = {"inPosition", "inColor0", "inTexCoord0"};
@@ -111,6 +127,14 @@ struct CompiledGeometryData {
 	GLuint vbo;
 	GLuint ibo;
 	GLsizei draw_count;
+	GLenum index_type;
+};
+
+// Vertex with its texture coordinates packed into normalized 16-bit integers, used when they are all within [0, 1].
+struct CompactVertex {
+	Rml::Vector2f position;
+	Rml::Colourb colour;
+	GLushort tex_coord[2];
 };
 
 struct ProgramData {
@@ -121,9 +145,11 @@ struct ProgramData {
 struct ShadersData {
 	ProgramData program_color;
 	ProgramData program_texture;
+	ProgramData program_distance_field;
 	GLuint shader_main_vertex;
 	GLuint shader_main_fragment_color;
 	GLuint shader_main_fragment_texture;
+	GLuint shader_main_fragment_distance_field;
 };
 
 static void CheckGLError(const char* operation_name)
@@ -267,6 +293,7 @@ static bool CreateShaders(ShadersData& out_shaders)
 	GLuint& main_vertex = out_shaders.shader_main_vertex;
 	GLuint& main_fragment_color = out_shaders.shader_main_fragment_color;
 	GLuint& main_fragment_texture = out_shaders.shader_main_fragment_texture;
+	GLuint& main_fragment_distance_field = out_shaders.shader_main_fragment_distance_field;
 
 	main_vertex = CreateShader(GL_VERTEX_SHADER, shader_main_vertex);
 	if (!main_vertex)
@@ -286,6 +313,12 @@ static bool CreateShaders(ShadersData& out_shaders)
 		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not create OpenGL shader: 'shader_main_fragment_texture'.");
 		return false;
 	}
+	main_fragment_distance_field = CreateShader(GL_FRAGMENT_SHADER, shader_main_fragment_distance_field);
+	if (!main_fragment_distance_field)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not create OpenGL shader: 'shader_main_fragment_distance_field'.");
+		return false;
+	}
 
 	if (!CreateProgram(main_vertex, main_fragment_color, out_shaders.program_color))
 	{
@@ -297,6 +330,11 @@ static bool CreateShaders(ShadersData& out_shaders)
 		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not create OpenGL program: 'program_texture'.");
 		return false;
 	}
+	if (!CreateProgram(main_vertex, main_fragment_distance_field, out_shaders.program_distance_field))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not create OpenGL program: 'program_distance_field'.");
+		return false;
+	}
 
 	return true;
 }
@@ -305,10 +343,12 @@ static void DestroyShaders(ShadersData& shaders)
 {
 	glDeleteProgram(shaders.program_color.id);
 	glDeleteProgram(shaders.program_texture.id);
+	glDeleteProgram(shaders.program_distance_field.id);
 
 	glDeleteShader(shaders.shader_main_vertex);
 	glDeleteShader(shaders.shader_main_fragment_color);
 	glDeleteShader(shaders.shader_main_fragment_texture);
+	glDeleteShader(shaders.shader_main_fragment_distance_field);
 
 	shaders = {};
 }
@@ -393,6 +433,7 @@ void RenderInterface_GL3::BeginFrame()
 
 	projection = Rml::Matrix4f::ProjectOrtho(0, (float)viewport_width, (float)viewport_height, 0, -10000, 10000);
 	SetTransform(nullptr);
+	SetColourModulation(Rml::Colourb(255, 255, 255, 255));
 }
 
 void RenderInterface_GL3::EndFrame()
@@ -463,6 +504,21 @@ Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Vertex* ve
 {
 	constexpr GLenum draw_usage = GL_STATIC_DRAW;
 
+	// Upload the geometry in compact form where it can be represented that way, which shrinks the index buffer by half and each vertex by a fifth.
+	// Texture coordinates are then quantized to steps of 1/65535, at most a quarter texel for textures up to 16384 pixels wide. Define
+	// RMLUI_GL3_NO_COMPACT_GEOMETRY, such as in a custom configuration file, to always upload the geometry as given.
+	bool compact_indices = false;
+	bool compact_vertices = false;
+#ifndef RMLUI_GL3_NO_COMPACT_GEOMETRY
+	compact_indices = (num_vertices <= 0x10000);
+	compact_vertices = true;
+	for (int i = 0; i < num_vertices && compact_vertices; i++)
+	{
+		const Rml::Vector2f tex_coord = vertices[i].tex_coord;
+		compact_vertices = (tex_coord.x >= 0.f && tex_coord.x <= 1.f && tex_coord.y >= 0.f && tex_coord.y <= 1.f);
+	}
+#endif
+
 	GLuint vao = 0;
 	GLuint vbo = 0;
 	GLuint ibo = 0;
@@ -473,22 +529,60 @@ Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Vertex* ve
 	glBindVertexArray(vao);
 
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Rml::Vertex) * num_vertices, (const void*)vertices, draw_usage);
+
+	GLsizei vertex_size = sizeof(Rml::Vertex);
+	size_t tex_coord_offset = offsetof(Rml::Vertex, tex_coord);
+	GLenum tex_coord_type = GL_FLOAT;
+
+	if (compact_vertices)
+	{
+		Rml::Vector<Gfx::CompactVertex> compact_vertex_data(num_vertices);
+		for (int i = 0; i < num_vertices; i++)
+		{
+			Gfx::CompactVertex& compact_vertex = compact_vertex_data[i];
+			compact_vertex.position = vertices[i].position;
+			compact_vertex.colour = vertices[i].colour;
+			compact_vertex.tex_coord[0] = GLushort(vertices[i].tex_coord.x * 65535.f + 0.5f);
+			compact_vertex.tex_coord[1] = GLushort(vertices[i].tex_coord.y * 65535.f + 0.5f);
+		}
+
+		vertex_size = sizeof(Gfx::CompactVertex);
+		tex_coord_offset = offsetof(Gfx::CompactVertex, tex_coord);
+		tex_coord_type = GL_UNSIGNED_SHORT;
+		glBufferData(GL_ARRAY_BUFFER, vertex_size * num_vertices, (const void*)compact_vertex_data.data(), draw_usage);
+	}
+	else
+	{
+		glBufferData(GL_ARRAY_BUFFER, vertex_size * num_vertices, (const void*)vertices, draw_usage);
+	}
+
+	// Both vertex layouts place the position and colour first.
+	static_assert(offsetof(Gfx::CompactVertex, position) == offsetof(Rml::Vertex, position), "Mismatched vertex layouts");
+	static_assert(offsetof(Gfx::CompactVertex, colour) == offsetof(Rml::Vertex, colour), "Mismatched vertex layouts");
 
 	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::Position);
-	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::Position, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
+	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::Position, 2, GL_FLOAT, GL_FALSE, vertex_size,
 		(const GLvoid*)(offsetof(Rml::Vertex, position)));
 
 	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::Color0);
-	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::Color0, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Rml::Vertex),
+	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::Color0, 4, GL_UNSIGNED_BYTE, GL_TRUE, vertex_size,
 		(const GLvoid*)(offsetof(Rml::Vertex, colour)));
 
 	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::TexCoord0);
-	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::TexCoord0, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
-		(const GLvoid*)(offsetof(Rml::Vertex, tex_coord)));
+	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::TexCoord0, 2, tex_coord_type, tex_coord_type != GL_FLOAT, vertex_size,
+		(const GLvoid*)tex_coord_offset);
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * num_indices, (const void*)indices, draw_usage);
+
+	if (compact_indices)
+	{
+		Rml::Vector<GLushort> compact_index_data(indices, indices + num_indices);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * num_indices, (const void*)compact_index_data.data(), draw_usage);
+	}
+	else
+	{
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * num_indices, (const void*)indices, draw_usage);
+	}
 
 	glBindVertexArray(0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -501,20 +595,55 @@ Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Vertex* ve
 	geometry->vbo = vbo;
 	geometry->ibo = ibo;
 	geometry->draw_count = num_indices;
+	geometry->index_type = (compact_indices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT);
 
 	return (Rml::CompiledGeometryHandle)geometry;
 }
 
 void RenderInterface_GL3::RenderCompiledGeometry(Rml::CompiledGeometryHandle handle, const Rml::Vector2f& translation)
+{
+	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
+	RenderCompiledGeometryChunk(handle, 0, geometry->draw_count, geometry->texture, translation);
+}
+
+void RenderInterface_GL3::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle handle)
 {
 	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
 
-	if (geometry->texture)
+	glDeleteVertexArrays(1, &geometry->vao);
+	glDeleteBuffers(1, &geometry->vbo);
+	glDeleteBuffers(1, &geometry->ibo);
+
+	delete geometry;
+}
+
+Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices)
+{
+	// Chunks share the vertex layout of regular compiled geometry, the texture is instead provided for each rendered range.
+	return CompileGeometry(vertices, num_vertices, indices, num_indices, {});
+}
+
+void RenderInterface_GL3::RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices,
+	Rml::TextureHandle texture, const Rml::Vector2f& translation)
+{
+	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)chunk;
+
+	if (texture && distance_field_textures.count(texture))
+	{
+		const Gfx::ProgramData& program = shaders->program_distance_field;
+		glUseProgram(program.id);
+		glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+		SubmitTransformUniform(ProgramId::DistanceField, program.uniform_locations[(size_t)Gfx::ProgramUniform::Transform]);
+		SubmitColorModulationUniform(ProgramId::DistanceField, program.uniform_locations[(size_t)Gfx::ProgramUniform::ColorModulation]);
+		glUniform2fv(program.uniform_locations[(size_t)Gfx::ProgramUniform::Translate], 1, &translation.x);
+	}
+	else if (texture)
 	{
 		glUseProgram(shaders->program_texture.id);
-		if (geometry->texture != TextureEnableWithoutBinding)
-			glBindTexture(GL_TEXTURE_2D, (GLuint)geometry->texture);
+		if (texture != TextureEnableWithoutBinding)
+			glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
 		SubmitTransformUniform(ProgramId::Texture, shaders->program_texture.uniform_locations[(size_t)Gfx::ProgramUniform::Transform]);
+		SubmitColorModulationUniform(ProgramId::Texture, shaders->program_texture.uniform_locations[(size_t)Gfx::ProgramUniform::ColorModulation]);
 		glUniform2fv(shaders->program_texture.uniform_locations[(size_t)Gfx::ProgramUniform::Translate], 1, &translation.x);
 	}
 	else
@@ -522,28 +651,19 @@ void RenderInterface_GL3::RenderCompiledGeometry(Rml::CompiledGeometryHandle han
 		glUseProgram(shaders->program_color.id);
 		glBindTexture(GL_TEXTURE_2D, 0);
 		SubmitTransformUniform(ProgramId::Color, shaders->program_color.uniform_locations[(size_t)Gfx::ProgramUniform::Transform]);
+		SubmitColorModulationUniform(ProgramId::Color, shaders->program_color.uniform_locations[(size_t)Gfx::ProgramUniform::ColorModulation]);
 		glUniform2fv(shaders->program_color.uniform_locations[(size_t)Gfx::ProgramUniform::Translate], 1, &translation.x);
 	}
 
 	glBindVertexArray(geometry->vao);
-	glDrawElements(GL_TRIANGLES, geometry->draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
+	const size_t index_size = (geometry->index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+	glDrawElements(GL_TRIANGLES, num_indices, geometry->index_type, (const GLvoid*)(index_size * first_index));
 
 	glBindVertexArray(0);
 	glUseProgram(0);
 	glBindTexture(GL_TEXTURE_2D, 0);
 
-	Gfx::CheckGLError("RenderCompiledGeometry");
-}
-
-void RenderInterface_GL3::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle handle)
-{
-	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
-
-	glDeleteVertexArrays(1, &geometry->vao);
-	glDeleteBuffers(1, &geometry->vbo);
-	glDeleteBuffers(1, &geometry->ibo);
-
-	delete geometry;
+	Gfx::CheckGLError("RenderCompiledGeometryChunk");
 }
 
 void RenderInterface_GL3::EnableScissorRegion(bool enable)
@@ -625,6 +745,15 @@ struct TGAHeader {
 #pragma pack()
 
 bool RenderInterface_GL3::LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::Vector<Rml::byte> texture_data;
+	if (!LoadTextureData(texture_data, texture_dimensions, source))
+		return false;
+
+	return GenerateTexture(texture_handle, texture_data.data(), texture_dimensions);
+}
+
+bool RenderInterface_GL3::LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source)
 {
 	Rml::FileInterface* file_interface = Rml::GetFileInterface();
 	Rml::FileHandle file_handle = file_interface->Open(source);
@@ -671,7 +800,8 @@ bool RenderInterface_GL3::LoadTexture(Rml::TextureHandle& texture_handle, Rml::V
 	}
 
 	const byte* image_src = buffer + sizeof(TGAHeader);
-	byte* image_dest = new byte[image_size];
+	texture_data.resize(image_size);
+	byte* image_dest = texture_data.data();
 
 	// Targa is BGR, swap to RGB and flip Y axis
 	for (long y = 0; y < header.height; y++)
@@ -706,12 +836,9 @@ bool RenderInterface_GL3::LoadTexture(Rml::TextureHandle& texture_handle, Rml::V
 	texture_dimensions.x = header.width;
 	texture_dimensions.y = header.height;
 
-	bool success = GenerateTexture(texture_handle, image_dest, texture_dimensions);
-
-	delete[] image_dest;
 	delete[] buffer;
 
-	return success;
+	return true;
 }
 
 bool RenderInterface_GL3::GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions)
@@ -741,8 +868,25 @@ bool RenderInterface_GL3::GenerateTexture(Rml::TextureHandle& texture_handle, co
 	return true;
 }
 
+bool RenderInterface_GL3::SupportsDistanceFieldTextures()
+{
+	return true;
+}
+
+bool RenderInterface_GL3::GenerateDistanceFieldTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source,
+	const Rml::Vector2i& source_dimensions)
+{
+	if (!GenerateTexture(texture_handle, source, source_dimensions))
+		return false;
+
+	// Geometry rendered with this texture uses the distance field program instead.
+	distance_field_textures.insert(texture_handle);
+	return true;
+}
+
 void RenderInterface_GL3::ReleaseTexture(Rml::TextureHandle texture_handle)
 {
+	distance_field_textures.erase(texture_handle);
 	glDeleteTextures(1, (GLuint*)&texture_handle);
 }
 
@@ -762,6 +906,26 @@ void RenderInterface_GL3::SubmitTransformUniform(ProgramId program_id, int unifo
 	}
 }
 
+bool RenderInterface_GL3::SupportsColourModulation()
+{
+	return true;
+}
+
+void RenderInterface_GL3::SetColourModulation(const Rml::Colourb& colour)
+{
+	color_modulation = Rml::Colourf(colour.red / 255.f, colour.green / 255.f, colour.blue / 255.f, colour.alpha / 255.f);
+	color_modulation_dirty_state = ProgramId::All;
+}
+
+void RenderInterface_GL3::SubmitColorModulationUniform(ProgramId program_id, int uniform_location)
+{
+	if ((int)program_id & (int)color_modulation_dirty_state)
+	{
+		glUniform4fv(uniform_location, 1, &color_modulation.red);
+		color_modulation_dirty_state = ProgramId((int)color_modulation_dirty_state & ~(int)program_id);
+	}
+}
+
 bool RmlGL3::Initialize(Rml::String* out_message)
 {
 #if defined RMLUI_PLATFORM_EMSCRIPTEN
@@ -64,26 +64,40 @@ public:
 	void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override;
 	void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override;
 
+	Rml::CompiledGeometryHandle CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices) override;
+	void RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices, Rml::TextureHandle texture,
+		const Rml::Vector2f& translation) override;
+
 	void EnableScissorRegion(bool enable) override;
 	void SetScissorRegion(int x, int y, int width, int height) override;
 
 	bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
 	bool GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
+	bool SupportsDistanceFieldTextures() override;
+	bool GenerateDistanceFieldTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
 
 	void SetTransform(const Rml::Matrix4f* transform) override;
 
+	bool SupportsColourModulation() override;
+	void SetColourModulation(const Rml::Colourb& colour) override;
+
 	// Can be passed to RenderGeometry() to enable texture rendering without changing the bound texture.
 	static const Rml::TextureHandle TextureEnableWithoutBinding = Rml::TextureHandle(-1);
 
 private:
-	enum class ProgramId { None, Texture = 1, Color = 2, All = (Texture | Color) };
+	enum class ProgramId { None, Texture = 1, Color = 2, DistanceField = 4, All = (Texture | Color | DistanceField) };
 	void SubmitTransformUniform(ProgramId program_id, int uniform_location);
+	void SubmitColorModulationUniform(ProgramId program_id, int uniform_location);
 
 	Rml::Matrix4f transform, projection;
 	ProgramId transform_dirty_state = ProgramId::All;
 	bool transform_active = false;
 
+	Rml::Colourf color_modulation = Rml::Colourf(1.f);
+	ProgramId color_modulation_dirty_state = ProgramId::All;
+
 	enum class ScissoringState { Disable, Scissor, Stencil };
 	ScissoringState scissoring_state = ScissoringState::Disable;
 
@@ -92,6 +106,9 @@ private:
 
 	Rml::UniquePtr<Gfx::ShadersData> shaders;
 
+	// Textures generated from distance fields, which are rendered with the distance field program.
+	Rml::UnorderedSet<Rml::TextureHandle> distance_field_textures;
+
 	struct GLStateBackup {
 		bool enable_cull_face;
 		bool enable_blend;
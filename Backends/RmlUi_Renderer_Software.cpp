@@ -0,0 +1,814 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "RmlUi_Renderer_Software.h"
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Platform.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define RMLUI_SOFTWARE_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace RmlSoftware {
+
+// Runs a task on a set of worker threads together with the calling thread.
+struct WorkerPool {
+	explicit WorkerPool(int num_workers)
+	{
+		for (int i = 0; i < num_workers; i++)
+			threads.emplace_back([this]() { Run(); });
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		work_condition.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	// Returns once the task has completed on all threads.
+	void Execute(const std::function<void()>& new_task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			task = new_task;
+			num_working = (int)threads.size();
+			generation += 1;
+		}
+		work_condition.notify_all();
+
+		new_task();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done_condition.wait(lock, [this]() { return num_working == 0; });
+		task = nullptr;
+	}
+
+private:
+	void Run()
+	{
+		uint64_t completed_generation = 0;
+		while (true)
+		{
+			std::function<void()> current_task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				work_condition.wait(lock, [&]() { return quit || generation != completed_generation; });
+				if (quit)
+					return;
+				completed_generation = generation;
+				current_task = task;
+			}
+
+			current_task();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			num_working -= 1;
+			if (num_working == 0)
+				done_condition.notify_one();
+		}
+	}
+
+	Rml::Vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable work_condition;
+	std::condition_variable done_condition;
+	std::function<void()> task;
+	uint64_t generation = 0;
+	int num_working = 0;
+	bool quit = false;
+};
+
+} // namespace RmlSoftware
+
+namespace {
+
+constexpr int tile_size = 64;
+constexpr int subpixel_bits = 8;
+constexpr int64_t subpixel_scale = int64_t(1) << subpixel_bits;
+constexpr int64_t pixel_center = subpixel_scale / 2;
+
+// Vertices beyond this distance from the origin are not rasterized, this keeps the fixed-point edge functions well within range.
+constexpr float guard_band = 16384.f;
+
+int64_t ToFixed(float value)
+{
+	return (int64_t)std::floor(double(value) * double(subpixel_scale) + 0.5);
+}
+
+// Pixels with their center exactly on an edge are only covered by triangles for which it is a top or left edge, thereby adjacent triangles
+// never draw the same pixel twice. Returns the edge's constant term, offset to exclude the center of such pixels otherwise.
+int64_t SetupEdge(int64_t px, int64_t py, int64_t qx, int64_t qy, int64_t& a, int64_t& b)
+{
+	a = py - qy;
+	b = qx - px;
+	const bool top_left = (a > 0 || (a == 0 && b > 0));
+	return -(a * px + b * py) - (top_left ? 0 : 1);
+}
+
+// Narrows the span [k_min, k_max] of pixels where the edge function is non-negative, given its value at the first pixel and its step
+// per pixel. Returns false if the span is empty.
+bool ClipSpanToEdge(int64_t value, int64_t step, int64_t& k_min, int64_t& k_max)
+{
+	if (step == 0)
+		return value >= 0;
+
+	if (step > 0)
+	{
+		if (value < 0)
+			k_min = std::max(k_min, (-value + step - 1) / step);
+	}
+	else
+	{
+		if (value < 0)
+			return false;
+		k_max = std::min(k_max, value / -step);
+	}
+
+	return k_min <= k_max;
+}
+
+inline Rml::byte ToByte(float value)
+{
+	return (Rml::byte)Rml::Math::Clamp(int(value + 0.5f), 0, 255);
+}
+
+// Blends the source over the destination for all channels as: (src * src_alpha + dst * (255 - src_alpha)) / 255, rounded.
+inline void BlendPixel(Rml::byte* dst, int red, int green, int blue, int alpha)
+{
+	const int inv_alpha = 255 - alpha;
+	const int src[4] = {red * alpha, green * alpha, blue * alpha, alpha * alpha};
+	for (int i = 0; i < 4; i++)
+	{
+		const int x = src[i] + dst[i] * inv_alpha + 128;
+		dst[i] = Rml::byte((x + (x >> 8)) >> 8);
+	}
+}
+
+// Blends a constant colour over a span of pixels.
+void FillSpan(Rml::byte* dst, int count, Rml::byte red, Rml::byte green, Rml::byte blue, Rml::byte alpha)
+{
+	if (alpha == 0)
+		return;
+
+	if (alpha == 255)
+	{
+		const Rml::byte pixel[4] = {red, green, blue, alpha};
+		uint32_t value;
+		memcpy(&value, pixel, 4);
+		for (int i = 0; i < count; i++)
+			memcpy(dst + 4 * i, &value, 4);
+		return;
+	}
+
+	int i = 0;
+
+#ifdef RMLUI_SOFTWARE_SSE2
+	// Blend four pixels at a time, with each channel widened to 16 bits. The result is identical to the scalar version.
+	const __m128i src_term = _mm_setr_epi16(short(red * alpha), short(green * alpha), short(blue * alpha), short(alpha * alpha),
+		short(red * alpha), short(green * alpha), short(blue * alpha), short(alpha * alpha));
+	const __m128i inv_alpha = _mm_set1_epi16(short(255 - alpha));
+	const __m128i rounding = _mm_set1_epi16(128);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i* ptr = reinterpret_cast<__m128i*>(dst + 4 * i);
+		const __m128i pixels = _mm_loadu_si128(ptr);
+
+		__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+		__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+		lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, inv_alpha), src_term), rounding);
+		hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, inv_alpha), src_term), rounding);
+
+		lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+		_mm_storeu_si128(ptr, _mm_packus_epi16(lo, hi));
+	}
+#endif
+
+	for (; i < count; i++)
+		BlendPixel(dst + 4 * i, red, green, blue, alpha);
+}
+
+// Samples the texture bilinearly at the given normalized texture coordinates, with edges clamped. Writes to an array of four channels.
+void SampleBilinear(const Rml::byte* data, int width, int height, float u, float v, float* out)
+{
+	const float fx = u * float(width) - 0.5f;
+	const float fy = v * float(height) - 0.5f;
+	const float floor_x = std::floor(fx);
+	const float floor_y = std::floor(fy);
+	const float tx = fx - floor_x;
+	const float ty = fy - floor_y;
+
+	const int x0 = Rml::Math::Clamp(int(floor_x), 0, width - 1);
+	const int y0 = Rml::Math::Clamp(int(floor_y), 0, height - 1);
+	const int x1 = Rml::Math::Clamp(int(floor_x) + 1, 0, width - 1);
+	const int y1 = Rml::Math::Clamp(int(floor_y) + 1, 0, height - 1);
+
+	const Rml::byte* p00 = data + 4 * (y0 * width + x0);
+	const Rml::byte* p10 = data + 4 * (y0 * width + x1);
+	const Rml::byte* p01 = data + 4 * (y1 * width + x0);
+	const Rml::byte* p11 = data + 4 * (y1 * width + x1);
+
+	const float w00 = (1.f - tx) * (1.f - ty);
+	const float w10 = tx * (1.f - ty);
+	const float w01 = (1.f - tx) * ty;
+	const float w11 = tx * ty;
+
+	for (int i = 0; i < 4; i++)
+		out[i] = w00 * float(p00[i]) + w10 * float(p10[i]) + w01 * float(p01[i]) + w11 * float(p11[i]);
+}
+
+} // namespace
+
+RenderInterface_Software::RenderInterface_Software()
+{
+	SetNumThreads(0);
+}
+
+RenderInterface_Software::~RenderInterface_Software()
+{
+	worker_pool.reset();
+
+	triangles.clear();
+	ReleasePendingTextures();
+}
+
+void RenderInterface_Software::SetViewport(int width, int height)
+{
+	viewport_width = std::max(width, 0);
+	viewport_height = std::max(height, 0);
+
+	color_buffer.resize(size_t(viewport_width) * size_t(viewport_height) * 4);
+
+	num_tiles_x = (viewport_width + tile_size - 1) / tile_size;
+	num_tiles_y = (viewport_height + tile_size - 1) / tile_size;
+	tile_triangles.clear();
+	tile_triangles.resize(size_t(num_tiles_x) * size_t(num_tiles_y));
+	triangles.clear();
+}
+
+void RenderInterface_Software::SetNumThreads(int num_threads)
+{
+	if (num_threads <= 0)
+		num_threads = Rml::Math::Clamp((int)std::thread::hardware_concurrency(), 1, 16);
+
+	worker_pool.reset();
+	if (num_threads > 1)
+		worker_pool = Rml::MakeUnique<RmlSoftware::WorkerPool>(num_threads - 1);
+}
+
+void RenderInterface_Software::BeginFrame()
+{
+	SetTransform(nullptr);
+	SetColourModulation(Rml::Colourb(255, 255, 255, 255));
+	scissor_enabled = false;
+	scissor_region = -1;
+
+	clip_regions.clear();
+	triangles.clear();
+	for (Rml::Vector<int>& list : tile_triangles)
+		list.clear();
+}
+
+void RenderInterface_Software::EndFrame()
+{
+	const int num_tiles = num_tiles_x * num_tiles_y;
+
+	if (!triangles.empty())
+	{
+		std::atomic<int> next_tile(0);
+		auto rasterize_tiles = [&]() {
+			for (int tile = next_tile++; tile < num_tiles; tile = next_tile++)
+				RasterizeTile(tile);
+		};
+
+		if (worker_pool && num_tiles > 1)
+			worker_pool->Execute(rasterize_tiles);
+		else
+			rasterize_tiles();
+	}
+
+	triangles.clear();
+	clip_regions.clear();
+	for (Rml::Vector<int>& list : tile_triangles)
+		list.clear();
+
+	ReleasePendingTextures();
+}
+
+void RenderInterface_Software::Clear()
+{
+	const Rml::byte black[4] = {0, 0, 0, 255};
+	for (size_t i = 0; i < color_buffer.size(); i += 4)
+		memcpy(&color_buffer[i], black, 4);
+}
+
+void RenderInterface_Software::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture,
+	const Rml::Vector2f& translation)
+{
+	SubmitTriangles(vertices, 0, num_vertices, indices, num_indices, texture, translation);
+}
+
+Rml::CompiledGeometryHandle RenderInterface_Software::CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+	Rml::TextureHandle texture)
+{
+	CompiledGeometry* geometry = new CompiledGeometry;
+	geometry->vertices.assign(vertices, vertices + num_vertices);
+	geometry->indices.assign(indices, indices + num_indices);
+	geometry->texture = texture;
+
+	return (Rml::CompiledGeometryHandle)geometry;
+}
+
+void RenderInterface_Software::RenderCompiledGeometry(Rml::CompiledGeometryHandle handle, const Rml::Vector2f& translation)
+{
+	const CompiledGeometry* geometry = (const CompiledGeometry*)handle;
+	SubmitTriangles(geometry->vertices.data(), 0, (int)geometry->vertices.size(), geometry->indices.data(), (int)geometry->indices.size(),
+		geometry->texture, translation);
+}
+
+void RenderInterface_Software::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle handle)
+{
+	delete (CompiledGeometry*)handle;
+}
+
+Rml::CompiledGeometryHandle RenderInterface_Software::CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices)
+{
+	return CompileGeometry(vertices, num_vertices, indices, num_indices, {});
+}
+
+void RenderInterface_Software::RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices,
+	Rml::TextureHandle texture, const Rml::Vector2f& translation)
+{
+	const CompiledGeometry* geometry = (const CompiledGeometry*)chunk;
+	RMLUI_ASSERT(first_index >= 0 && first_index + num_indices <= (int)geometry->indices.size());
+	if (num_indices <= 0)
+		return;
+
+	// The chunk holds the vertices of many allocations, only transform the range referenced by this one.
+	const int* indices = geometry->indices.data() + first_index;
+	const auto minmax_vertex = std::minmax_element(indices, indices + num_indices);
+
+	SubmitTriangles(geometry->vertices.data(), *minmax_vertex.first, *minmax_vertex.second - *minmax_vertex.first + 1, indices, num_indices,
+		texture, translation);
+}
+
+void RenderInterface_Software::EnableScissorRegion(bool enable)
+{
+	scissor_enabled = enable;
+}
+
+void RenderInterface_Software::SetScissorRegion(int x, int y, int width, int height)
+{
+	ClipRegion region = {};
+
+	if (!transform_active)
+	{
+		region.x_min = Rml::Math::Clamp(x, 0, viewport_width);
+		region.y_min = Rml::Math::Clamp(y, 0, viewport_height);
+		region.x_max = Rml::Math::Clamp(x + width, 0, viewport_width);
+		region.y_max = Rml::Math::Clamp(y + height, 0, viewport_height);
+	}
+	else
+	{
+		// Transformed regions are clipped to the quadrilateral formed by the transformed corners of the region.
+		const Rml::Vector2f corners[4] = {
+			Rml::Vector2f(float(x), float(y)),
+			Rml::Vector2f(float(x + width), float(y)),
+			Rml::Vector2f(float(x + width), float(y + height)),
+			Rml::Vector2f(float(x), float(y + height)),
+		};
+
+		int64_t px[4], py[4];
+		bool valid = true;
+		for (int i = 0; i < 4; i++)
+		{
+			const Rml::Vector4f position = transform * Rml::Vector4f(corners[i].x, corners[i].y, 0, 1);
+			valid &= (position.w > 0.f);
+			const float sx = (valid ? position.x / position.w : 0.f);
+			const float sy = (valid ? position.y / position.w : 0.f);
+			valid &= (std::abs(sx) < guard_band && std::abs(sy) < guard_band);
+			px[i] = ToFixed(sx);
+			py[i] = ToFixed(sy);
+		}
+
+		int64_t double_area = 0;
+		for (int i = 0; i < 4; i++)
+			double_area += px[i] * py[(i + 1) % 4] - px[(i + 1) % 4] * py[i];
+
+		if (valid && double_area != 0)
+		{
+			// Orient the edges so that the inside of the region is where all edge functions are non-negative.
+			const bool reverse = (double_area < 0);
+			region.num_edges = 4;
+			for (int i = 0; i < 4; i++)
+			{
+				const int p = (reverse ? (i + 1) % 4 : i);
+				const int q = (reverse ? i : (i + 1) % 4);
+				region.edge_c[i] = SetupEdge(px[p], py[p], px[q], py[q], region.edge_a[i], region.edge_b[i]);
+			}
+
+			region.x_min = Rml::Math::Clamp(int(*std::min_element(px, px + 4) >> subpixel_bits), 0, viewport_width);
+			region.y_min = Rml::Math::Clamp(int(*std::min_element(py, py + 4) >> subpixel_bits), 0, viewport_height);
+			region.x_max = Rml::Math::Clamp(int(*std::max_element(px, px + 4) >> subpixel_bits) + 1, 0, viewport_width);
+			region.y_max = Rml::Math::Clamp(int(*std::max_element(py, py + 4) >> subpixel_bits) + 1, 0, viewport_height);
+		}
+	}
+
+	scissor_region = (int)clip_regions.size();
+	clip_regions.push_back(region);
+}
+
+#pragma pack(1)
+struct TGAHeader {
+	char idLength;
+	char colourMapType;
+	char dataType;
+	short int colourMapOrigin;
+	short int colourMapLength;
+	char colourMapDepth;
+	short int xOrigin;
+	short int yOrigin;
+	short int width;
+	short int height;
+	char bitsPerPixel;
+	char imageDescriptor;
+};
+#pragma pack()
+
+bool RenderInterface_Software::LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::Vector<Rml::byte> texture_data;
+	if (!LoadTextureData(texture_data, texture_dimensions, source))
+		return false;
+
+	return GenerateTexture(texture_handle, texture_data.data(), texture_dimensions);
+}
+
+bool RenderInterface_Software::LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::FileInterface* file_interface = Rml::GetFileInterface();
+	Rml::FileHandle file_handle = file_interface->Open(source);
+	if (!file_handle)
+		return false;
+
+	file_interface->Seek(file_handle, 0, SEEK_END);
+	const size_t buffer_size = file_interface->Tell(file_handle);
+	file_interface->Seek(file_handle, 0, SEEK_SET);
+
+	if (buffer_size <= sizeof(TGAHeader))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file size is smaller than TGAHeader, file is not a valid TGA image.");
+		file_interface->Close(file_handle);
+		return false;
+	}
+
+	using Rml::byte;
+	Rml::Vector<byte> buffer(buffer_size);
+	file_interface->Read(buffer.data(), buffer_size, file_handle);
+	file_interface->Close(file_handle);
+
+	TGAHeader header;
+	memcpy(&header, buffer.data(), sizeof(TGAHeader));
+
+	const int color_mode = header.bitsPerPixel / 8;
+	const size_t image_size = size_t(header.width) * size_t(header.height) * 4;
+
+	if (header.dataType != 2)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24/32bit uncompressed TGAs are supported.");
+		return false;
+	}
+
+	if (color_mode < 3)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24 and 32bit textures are supported.");
+		return false;
+	}
+
+	if (sizeof(TGAHeader) + size_t(header.width) * size_t(header.height) * size_t(color_mode) > buffer_size)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file '%s' is truncated.", source.c_str());
+		return false;
+	}
+
+	const byte* image_src = buffer.data() + sizeof(TGAHeader);
+	texture_data.resize(image_size);
+	byte* image_dest = texture_data.data();
+
+	// Targa is BGR, swap to RGB and flip Y axis unless the image is stored top-down.
+	for (long y = 0; y < header.height; y++)
+	{
+		long read_index = y * header.width * color_mode;
+		long write_index = ((header.imageDescriptor & 32) != 0) ? y * header.width * 4 : (header.height - y - 1) * header.width * 4;
+		for (long x = 0; x < header.width; x++)
+		{
+			image_dest[write_index] = image_src[read_index + 2];
+			image_dest[write_index + 1] = image_src[read_index + 1];
+			image_dest[write_index + 2] = image_src[read_index];
+			image_dest[write_index + 3] = (color_mode == 4 ? image_src[read_index + 3] : 255);
+
+			write_index += 4;
+			read_index += color_mode;
+		}
+	}
+
+	texture_dimensions.x = header.width;
+	texture_dimensions.y = header.height;
+
+	return true;
+}
+
+bool RenderInterface_Software::GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions)
+{
+	if (source_dimensions.x <= 0 || source_dimensions.y <= 0)
+		return false;
+
+	Texture* texture = new Texture;
+	texture->width = source_dimensions.x;
+	texture->height = source_dimensions.y;
+	texture->data.assign(source, source + size_t(source_dimensions.x) * size_t(source_dimensions.y) * 4);
+
+	texture_handle = (Rml::TextureHandle)texture;
+	return true;
+}
+
+void RenderInterface_Software::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	pending_texture_releases.push_back((Texture*)texture_handle);
+	if (triangles.empty())
+		ReleasePendingTextures();
+}
+
+void RenderInterface_Software::SetTransform(const Rml::Matrix4f* new_transform)
+{
+	transform_active = (new_transform != nullptr);
+	transform = (new_transform ? *new_transform : Rml::Matrix4f::Identity());
+}
+
+bool RenderInterface_Software::SupportsColourModulation()
+{
+	return true;
+}
+
+void RenderInterface_Software::SetColourModulation(const Rml::Colourb& colour)
+{
+	colour_modulation = colour;
+}
+
+void RenderInterface_Software::SubmitTriangles(const Rml::Vertex* vertices, int first_vertex, int num_vertices, const int* indices, int num_indices,
+	Rml::TextureHandle texture_handle, Rml::Vector2f translation)
+{
+	if (num_tiles_x == 0 || num_tiles_y == 0)
+		return;
+
+	const ClipRegion* clip = (scissor_enabled && scissor_region >= 0 ? &clip_regions[scissor_region] : nullptr);
+	const int clip_x_min = (clip ? clip->x_min : 0);
+	const int clip_y_min = (clip ? clip->y_min : 0);
+	const int clip_x_max = (clip ? clip->x_max : viewport_width);
+	const int clip_y_max = (clip ? clip->y_max : viewport_height);
+	if (clip_x_min >= clip_x_max || clip_y_min >= clip_y_max)
+		return;
+
+	// Transform the referenced vertices into screen space.
+	screen_vertices.resize(num_vertices);
+	for (int i = 0; i < num_vertices; i++)
+	{
+		Rml::Vector2f position = vertices[first_vertex + i].position + translation;
+		bool valid = true;
+
+		if (transform_active)
+		{
+			const Rml::Vector4f result = transform * Rml::Vector4f(position.x, position.y, 0, 1);
+			valid = (result.w > 0.f);
+			if (valid)
+				position = Rml::Vector2f(result.x / result.w, result.y / result.w);
+		}
+
+		valid &= (std::abs(position.x) < guard_band && std::abs(position.y) < guard_band);
+		screen_vertices[i] = ScreenVertex{ToFixed(position.x), ToFixed(position.y), valid};
+	}
+
+	const Texture* texture = (const Texture*)texture_handle;
+	const float modulation[4] = {colour_modulation.red / 255.f, colour_modulation.green / 255.f, colour_modulation.blue / 255.f,
+		colour_modulation.alpha / 255.f};
+
+	for (int i = 0; i + 2 < num_indices; i += 3)
+	{
+		int triangle_indices[3] = {indices[i], indices[i + 1], indices[i + 2]};
+		const ScreenVertex* v[3] = {&screen_vertices[triangle_indices[0] - first_vertex], &screen_vertices[triangle_indices[1] - first_vertex],
+			&screen_vertices[triangle_indices[2] - first_vertex]};
+
+		if (!v[0]->valid || !v[1]->valid || !v[2]->valid)
+			continue;
+
+		int64_t double_area = (v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) - (v[1]->y - v[0]->y) * (v[2]->x - v[0]->x);
+		if (double_area == 0)
+			continue;
+
+		// Both windings are drawn, flip the clockwise ones.
+		if (double_area < 0)
+		{
+			std::swap(v[1], v[2]);
+			std::swap(triangle_indices[1], triangle_indices[2]);
+			double_area = -double_area;
+		}
+
+		Triangle triangle;
+		triangle.x_min = std::max(int(std::min({v[0]->x, v[1]->x, v[2]->x}) >> subpixel_bits), clip_x_min);
+		triangle.y_min = std::max(int(std::min({v[0]->y, v[1]->y, v[2]->y}) >> subpixel_bits), clip_y_min);
+		triangle.x_max = std::min(int(std::max({v[0]->x, v[1]->x, v[2]->x}) >> subpixel_bits) + 1, clip_x_max);
+		triangle.y_max = std::min(int(std::max({v[0]->y, v[1]->y, v[2]->y}) >> subpixel_bits) + 1, clip_y_max);
+		if (triangle.x_min >= triangle.x_max || triangle.y_min >= triangle.y_max)
+			continue;
+
+		// Each edge function is opposite its vertex, thereby its value relative to the doubled area is the vertex's barycentric weight.
+		for (int j = 0; j < 3; j++)
+		{
+			const ScreenVertex& p = *v[(j + 1) % 3];
+			const ScreenVertex& q = *v[(j + 2) % 3];
+			triangle.edge_c[j] = SetupEdge(p.x, p.y, q.x, q.y, triangle.edge_a[j], triangle.edge_b[j]);
+		}
+		triangle.double_area = double_area;
+
+		for (int j = 0; j < 3; j++)
+		{
+			const Rml::Vertex& vertex = vertices[triangle_indices[j]];
+			float* attributes = triangle.attributes[j];
+			attributes[0] = float(vertex.colour.red) * modulation[0];
+			attributes[1] = float(vertex.colour.green) * modulation[1];
+			attributes[2] = float(vertex.colour.blue) * modulation[2];
+			attributes[3] = float(vertex.colour.alpha) * modulation[3];
+			attributes[4] = vertex.tex_coord.x;
+			attributes[5] = vertex.tex_coord.y;
+		}
+
+		const Rml::Colourb& c0 = vertices[triangle_indices[0]].colour;
+		triangle.constant_colour = !texture && c0 == vertices[triangle_indices[1]].colour && c0 == vertices[triangle_indices[2]].colour;
+		if (triangle.constant_colour && ToByte(triangle.attributes[0][3]) == 0)
+			continue;
+
+		triangle.texture = texture;
+		triangle.clip_region = (clip && clip->num_edges > 0 ? scissor_region : -1);
+
+		const int triangle_index = (int)triangles.size();
+		triangles.push_back(triangle);
+
+		const int tile_x_end = (triangle.x_max - 1) / tile_size;
+		const int tile_y_end = (triangle.y_max - 1) / tile_size;
+		for (int tile_y = triangle.y_min / tile_size; tile_y <= tile_y_end; tile_y++)
+		{
+			for (int tile_x = triangle.x_min / tile_size; tile_x <= tile_x_end; tile_x++)
+				tile_triangles[tile_y * num_tiles_x + tile_x].push_back(triangle_index);
+		}
+	}
+}
+
+void RenderInterface_Software::RasterizeTile(int tile_index)
+{
+	const int x_begin = (tile_index % num_tiles_x) * tile_size;
+	const int y_begin = (tile_index / num_tiles_x) * tile_size;
+	const int x_end = std::min(x_begin + tile_size, viewport_width);
+	const int y_end = std::min(y_begin + tile_size, viewport_height);
+
+	for (int triangle_index : tile_triangles[tile_index])
+	{
+		const Triangle& triangle = triangles[triangle_index];
+		RasterizeTriangle(triangle, std::max(x_begin, triangle.x_min), std::max(y_begin, triangle.y_min), std::min(x_end, triangle.x_max),
+			std::min(y_end, triangle.y_max));
+	}
+}
+
+void RenderInterface_Software::RasterizeTriangle(const Triangle& triangle, int x_begin, int y_begin, int x_end, int y_end)
+{
+	const ClipRegion* clip = (triangle.clip_region >= 0 ? &clip_regions[triangle.clip_region] : nullptr);
+	const float inv_double_area = 1.f / float(triangle.double_area);
+	const int64_t x_center = int64_t(x_begin) * subpixel_scale + pixel_center;
+
+	Rml::byte constant_colour[4] = {};
+	if (triangle.constant_colour)
+	{
+		for (int i = 0; i < 4; i++)
+			constant_colour[i] = ToByte(triangle.attributes[0][i]);
+	}
+
+	for (int y = y_begin; y < y_end; y++)
+	{
+		const int64_t y_center = int64_t(y) * subpixel_scale + pixel_center;
+
+		// Find the span of pixels on this row inside all the edges.
+		int64_t k_min = 0;
+		int64_t k_max = x_end - x_begin - 1;
+		int64_t edge_values[3];
+		bool inside = true;
+
+		for (int i = 0; i < 3 && inside; i++)
+		{
+			edge_values[i] = triangle.edge_a[i] * x_center + triangle.edge_b[i] * y_center + triangle.edge_c[i];
+			inside = ClipSpanToEdge(edge_values[i], triangle.edge_a[i] * subpixel_scale, k_min, k_max);
+		}
+		for (int i = 0; clip && i < clip->num_edges && inside; i++)
+		{
+			const int64_t value = clip->edge_a[i] * x_center + clip->edge_b[i] * y_center + clip->edge_c[i];
+			inside = ClipSpanToEdge(value, clip->edge_a[i] * subpixel_scale, k_min, k_max);
+		}
+
+		if (!inside)
+			continue;
+
+		const int count = int(k_max - k_min + 1);
+		Rml::byte* dst = &color_buffer[(size_t(y) * size_t(viewport_width) + size_t(x_begin + k_min)) * 4];
+
+		if (triangle.constant_colour)
+		{
+			FillSpan(dst, count, constant_colour[0], constant_colour[1], constant_colour[2], constant_colour[3]);
+			continue;
+		}
+
+		// Interpolate the attributes from the barycentric weights at the start of the span.
+		float values[6] = {};
+		float steps[6] = {};
+		for (int i = 0; i < 3; i++)
+		{
+			const float weight = float(edge_values[i] + triangle.edge_a[i] * subpixel_scale * k_min) * inv_double_area;
+			const float weight_step = float(triangle.edge_a[i] * subpixel_scale) * inv_double_area;
+			for (int j = 0; j < 6; j++)
+			{
+				values[j] += weight * triangle.attributes[i][j];
+				steps[j] += weight_step * triangle.attributes[i][j];
+			}
+		}
+
+		const Texture* texture = triangle.texture;
+		for (int k = 0; k < count; k++)
+		{
+			float colour[4] = {values[0], values[1], values[2], values[3]};
+
+			if (texture)
+			{
+				float texel[4];
+				SampleBilinear(texture->data.data(), texture->width, texture->height, values[4], values[5], texel);
+				for (int i = 0; i < 4; i++)
+					colour[i] *= texel[i] * (1.f / 255.f);
+			}
+
+			const Rml::byte alpha = ToByte(colour[3]);
+			if (alpha > 0)
+				BlendPixel(dst + 4 * k, ToByte(colour[0]), ToByte(colour[1]), ToByte(colour[2]), alpha);
+
+			for (int j = 0; j < 6; j++)
+				values[j] += steps[j];
+		}
+	}
+}
+
+void RenderInterface_Software::ReleasePendingTextures()
+{
+	for (Texture* texture : pending_texture_releases)
+		delete texture;
+	pending_texture_releases.clear();
+}
@@ -0,0 +1,170 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_RENDERER_SOFTWARE_H
+#define RMLUI_BACKENDS_RENDERER_SOFTWARE_H
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/Types.h>
+#include <stdint.h>
+
+namespace RmlSoftware {
+struct WorkerPool;
+}
+
+/**
+    Render interface rasterizing on the CPU into an 8-bit RGBA color buffer, requires no graphics device.
+
+    Geometry submitted during a frame is transformed and set up immediately, then rasterized when the frame ends. The viewport is split
+    into tiles which are rasterized in parallel, each tile drawing its triangles in submission order. Blending matches the other renderers,
+    and textures are sampled bilinearly with clamped edges.
+ */
+class RenderInterface_Software : public Rml::RenderInterface {
+public:
+	RenderInterface_Software();
+	~RenderInterface_Software();
+
+	// The viewport should be updated whenever the window size changes.
+	void SetViewport(int viewport_width, int viewport_height);
+
+	// Sets the number of threads used for rasterization, including the calling thread. Zero selects the number of hardware threads.
+	void SetNumThreads(int num_threads);
+
+	// Resets the render state for taking rendering commands from RmlUi.
+	void BeginFrame();
+	// Rasterizes all geometry submitted since the frame began into the color buffer.
+	void EndFrame();
+
+	// Optional, can be used to clear the color buffer.
+	void Clear();
+
+	// Returns the color buffer as rows of 8-bit RGBA pixels, starting at the top of the viewport.
+	const Rml::byte* GetColorBuffer() const { return color_buffer.data(); }
+	int GetViewportWidth() const { return viewport_width; }
+	int GetViewportHeight() const { return viewport_height; }
+
+	// -- Inherited from Rml::RenderInterface --
+
+	void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture,
+		const Rml::Vector2f& translation) override;
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+		Rml::TextureHandle texture) override;
+	void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override;
+	void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override;
+
+	Rml::CompiledGeometryHandle CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices) override;
+	void RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices, Rml::TextureHandle texture,
+		const Rml::Vector2f& translation) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(int x, int y, int width, int height) override;
+
+	bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	bool SupportsColourModulation() override;
+	void SetColourModulation(const Rml::Colourb& colour) override;
+
+private:
+	struct Texture {
+		int width = 0;
+		int height = 0;
+		Rml::Vector<Rml::byte> data;
+	};
+
+	struct CompiledGeometry {
+		Rml::Vector<Rml::Vertex> vertices;
+		Rml::Vector<int> indices;
+		Rml::TextureHandle texture = 0;
+	};
+
+	// A convex region pixels are clipped to, given by edge functions in 24.8 fixed point which are non-negative inside the region.
+	struct ClipRegion {
+		int x_min, y_min, x_max, y_max;
+		int num_edges;
+		int64_t edge_a[4], edge_b[4], edge_c[4];
+	};
+
+	// A triangle set up for rasterization, covering the pixels inside its bounding box where all its edge functions are non-negative.
+	struct Triangle {
+		int x_min, y_min, x_max, y_max;
+		int64_t edge_a[3], edge_b[3], edge_c[3];
+		int64_t double_area;
+
+		// The vertex attributes are interpolated as: red, green, blue, alpha, u, v.
+		float attributes[3][6];
+		bool constant_colour;
+
+		const Texture* texture;
+		int clip_region;
+	};
+
+	// Vertex position in screen space, in 24.8 fixed point.
+	struct ScreenVertex {
+		int64_t x, y;
+		bool valid;
+	};
+
+	// Submits the triangles given by the indices, which must refer to the vertices in [first_vertex, first_vertex + num_vertices).
+	void SubmitTriangles(const Rml::Vertex* vertices, int first_vertex, int num_vertices, const int* indices, int num_indices,
+		Rml::TextureHandle texture, Rml::Vector2f translation);
+	void RasterizeTile(int tile_index);
+	void RasterizeTriangle(const Triangle& triangle, int x_begin, int y_begin, int x_end, int y_end);
+	void ReleasePendingTextures();
+
+	int viewport_width = 0;
+	int viewport_height = 0;
+	Rml::Vector<Rml::byte> color_buffer;
+
+	Rml::Matrix4f transform;
+	bool transform_active = false;
+	Rml::Colourb colour_modulation = Rml::Colourb(255, 255, 255, 255);
+
+	bool scissor_enabled = false;
+	int scissor_region = -1;
+
+	// The geometry submitted during the current frame, binned into tiles by their bounding box.
+	Rml::Vector<ClipRegion> clip_regions;
+	Rml::Vector<Triangle> triangles;
+	Rml::Vector<Rml::Vector<int>> tile_triangles;
+	Rml::Vector<ScreenVertex> screen_vertices;
+	int num_tiles_x = 0;
+	int num_tiles_y = 0;
+
+	// Textures can't be released while the frame's triangles may still refer to them.
+	Rml::Vector<Texture*> pending_texture_releases;
+
+	Rml::UniquePtr<RmlSoftware::WorkerPool> worker_pool;
+};
+
+#endif
@@ -119,3 +119,13 @@ set(GLFW_VK_HDR_FILES
 	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Platform_GLFW.h
 	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Renderer_VK.h
 )
+
+set(Headless_Software_SRC_FILES
+	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Platform_Headless.cpp
+	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Renderer_Software.cpp
+	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Backend_Headless_Software.cpp
+)
+set(Headless_Software_HDR_FILES
+	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Platform_Headless.h
+	${PROJECT_SOURCE_DIR}/Backends/RmlUi_Renderer_Software.h
+)
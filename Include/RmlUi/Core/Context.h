@@ -87,6 +87,17 @@ public:
 	/// Renders all visible elements in the context's documents.
 	bool Render();
 
+	/// Statistics gathered during a single call to Render().
+	struct RenderStatistics {
+		int num_elements_rendered = 0;           // Elements whose own contents were submitted for rendering.
+		int num_elements_culled = 0;             // Elements skipped because they were placed entirely outside their clipping region.
+		int num_subtrees_culled = 0;             // Culled elements whose local stacking context was skipped as a whole.
+		int num_stacking_contexts_built = 0;     // Local stacking contexts whose render order was rebuilt and sorted from scratch.
+		int num_stacking_context_insertions = 0; // Subtrees merged into the existing render order of their stacking context instead.
+	};
+	/// Returns the statistics gathered during the most recent call to Render().
+	const RenderStatistics& GetRenderStatistics() const;
+
 	/// Creates a new, empty document and places it into this context.
 	/// @param[in] instancer_name The name of the instancer used to create the document.
 	/// @return The new document, or nullptr if no document could be created.
@@ -372,6 +383,8 @@ private:
 	Vector2i clip_origin;
 	Vector2i clip_dimensions;
 
+	RenderStatistics render_statistics;
+
 	using DataModels = UnorderedMap<String, UniquePtr<DataModel>>;
 	DataModels data_models;
 
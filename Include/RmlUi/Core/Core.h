@@ -150,6 +150,45 @@ RMLUICORE_API EventId RegisterEventType(const String& type, bool interruptible,
 RMLUICORE_API StringList GetTextureSourceList();
 /// Forces all texture handles loaded and generated by RmlUi to be released.
 RMLUICORE_API void ReleaseTextures();
+/// Sets the maximum width and height of images placed together in the shared texture atlas, larger images are loaded as separate textures.
+/// @param[in] size The maximum size in pixels, at most 256. Set to zero to disable the texture atlas.
+/// @note Only takes effect when the render interface implements LoadTextureData(), and for images loaded after the call.
+RMLUICORE_API void SetTextureAtlasMaxImageSize(int size);
+/// Enables generating the glyphs of the default font engine from signed distance fields. Each glyph is rasterized once per font face at the
+/// reference size, and its bitmaps for all other font sizes and its outline and glow effects are generated from the distance field. When the
+/// render interface supports distance field textures, all sizes of a font face render their glyphs from a single atlas of the distance fields.
+/// @param[in] reference_size The font size to rasterize distance fields at, such as 64. Set to zero to disable (default).
+/// @note Only takes effect for font sizes first used after the call, call ReleaseFontResources() to apply it to all fonts.
+RMLUICORE_API void SetFontDistanceFieldSize(int reference_size);
+/// Sets the number of threads used by the default font engine to apply font effects to glyphs when generating their textures.
+/// @param[in] num_threads The number of threads including the calling thread, or zero to use the number of hardware threads. Default is 1.
+/// @note Font textures are still generated during the render call that first needs them, which waits until all glyphs are done. The threads
+/// only shorten this stall, they do not move texture generation off the rendering thread.
+/// @note With more than one thread, the GenerateGlyphTexture() function of all font effects in use must be thread-safe. The built-in effects are.
+/// @note Emscripten builds without pthread support always use a single thread.
+RMLUICORE_API void SetFontEffectThreads(int num_threads);
+/// Sets a directory where the default font engine stores rendered glyphs and font effect textures, so that they can be loaded instead of
+/// generated again on the next run. Cached data is identified by the font file checksum, the font size, and the font effect properties.
+/// @param[in] directory The directory to store the cache files in, created if it does not exist. Set to empty to disable (default).
+/// @param[in] max_bytes The maximum total size of the cache files, the least recently used files are removed when exceeded. Zero for no limit.
+/// @note Clear the directory when the implementation of a custom font effect changes, since cached effect textures only depend on its properties.
+RMLUICORE_API void SetFontCacheDirectory(const String& directory, size_t max_bytes = 64 * 1024 * 1024);
+/// Sets the memory budget of the font face handles in the default font engine, used by their glyph bitmaps and font textures. When exceeded,
+/// the least recently used handles not referenced by any element have their glyphs and textures released, to be generated again if needed.
+/// @param[in] max_bytes The memory budget in bytes. Set to zero for no limit (default).
+/// @note The budget is enforced whenever a handle is created or restored, fonts in use by elements can make the total exceed the budget.
+RMLUICORE_API void SetFontMemoryBudget(size_t max_bytes);
+/// Statistics of the font face handles in the default font engine, see SetFontMemoryBudget().
+struct FontHandleStatistics {
+	int num_handles = 0;          // Font face handles of all font families and sizes, including handles with released resources.
+	int num_released_handles = 0; // Handles with their glyphs and textures currently released.
+	size_t memory_usage = 0;      // Bytes used by the glyph bitmaps and font textures of all handles.
+	int hits = 0;                 // Handle requests served by a handle with its resources available.
+	int misses = 0;               // Handle requests which created a handle, or restored the resources of a released handle.
+	int evictions = 0;            // Handles which had their resources released to stay within the memory budget.
+};
+/// Returns the statistics of the font face handles in the default font engine.
+RMLUICORE_API FontHandleStatistics GetFontHandleStatistics();
 /// Forces all compiled geometry handles generated by RmlUi to be released.
 RMLUICORE_API void ReleaseCompiledGeometry();
 /// Releases unused font textures and rendered glyphs to free up memory, and regenerates actively used fonts.
@@ -676,6 +676,24 @@ private:
 	void AddToStackingContext(Vector<StackingContextChild>& stacking_children, bool is_flex_item, bool is_non_dom_element);
 	void DirtyStackingContext();
 
+	/// Queues a newly attached child for insertion into the render order of our stacking context, instead of rebuilding it.
+	void QueueStackingContextInsertion(Element* child);
+	/// Removes the subtree of a child about to be detached from the render order of our stacking context, keeping the order of all others.
+	void RemoveFromStackingContext(Element* child);
+	/// Removes any queued insertions of elements within the given subtree from our local stacking context.
+	void RemoveQueuedStackingContextInsertions(Element* subtree_root);
+	/// Removes any insertions of our descendants queued on our stacking context parent, before we become a local stacking context.
+	void DequeueDescendantStackingContextInsertions();
+	/// Rebuilds our local stacking context if dirty, otherwise inserts the subtrees queued since it was last built.
+	void UpdateLocalStackingContext();
+	/// Inserts the subtree of a descendant into our local stacking context by merging it into the existing render order.
+	/// @return False if the subtree can't be inserted on its own, in which case the stacking context must be rebuilt.
+	bool InsertIntoLocalStackingContext(Element* element);
+	/// Returns the index of the first element in our local stacking context following the given descendant's subtree in tree order.
+	int FindStackingContextIndexAfter(Element* element) const;
+	/// Returns true if all the given elements of our local stacking context are clipped by our overflow, if we clip it.
+	bool IsStackingContextClipContained(const Vector<StackingContextChild>& stacking_children);
+
 	void UpdateDefinition();
 
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
@@ -704,11 +722,19 @@ private:
 
 	/// Advances the animations (including transitions) forward in time.
 	void AdvanceAnimations();
+	/// Applies an animated value of a property which only affects how the element is composited, directly to the computed values. This
+	/// bypasses the property change and layout machinery, which would otherwise run for every animated frame.
+	/// @return False if the property or the value can't be applied this way, in which case it should be set as a regular property.
+	bool SetAnimatedCompositingProperty(PropertyId id, const Property& property);
+	/// Sets the computed opacity of the element, and of all its descendants that inherit it.
+	void SetInheritedOpacityRecursive(float opacity);
 
 	// State flags are packed together for compact data layout.
 	bool local_stacking_context;
 	bool local_stacking_context_forced;
 	bool stacking_context_dirty;
+	bool stacking_context_clip_contained; // True if every element in our stacking context is clipped by our overflow clipping region.
+	bool stacking_context_insertion_pending; // True while our subtree is queued for insertion into our stacking context parent.
 	bool computed_values_are_default_initialized;
 
 	bool visible; // True if the element is visible and active.
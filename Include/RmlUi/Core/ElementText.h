@@ -114,8 +114,8 @@ private:
 	// The decoration geometry we've generated for this string.
 	UniquePtr<Geometry> decoration;
 
+	// The text colour, opacity is applied by modulating the colour of our geometry while rendering.
 	Colourb colour;
-	float opacity;
 
 	int font_handle_version;
 
@@ -95,8 +95,17 @@ public:
 	/// Sets the clipping region from an element and its ancestors.
 	/// @param[in] element The element to generate the clipping region from.
 	/// @param[in] context The context of the element; if this is not supplied, it will be derived from the element.
-	/// @return The visibility of the given element within its clipping region.
+	/// @return The visibility of the given element within its clipping region. False if the element's bounding box lies entirely outside the
+	/// clipping region, or the context's dimensions when no clipping applies, in which case the element does not need to be rendered.
 	static bool SetClippingRegion(Element* element, Context* context = nullptr);
+	/// Returns a rectangle covering the given area of all of the element's boxes, in window coordinates.
+	/// @param[out] out_rectangle The resulting bounding box.
+	/// @param[in] element The element to find the bounding box of.
+	/// @param[in] area The area of the element's boxes to cover.
+	/// @return True if the bounding box could be determined, false if it could not, such as when parts of the element are projected behind the
+	/// viewer by a perspective transform.
+	/// @note The element's transform is applied to the box corners, thus the rectangle encloses the transformed element.
+	static bool GetBoundingBox(Rectanglef& out_rectangle, Element* element, BoxArea area);
 	/// Applies the clip region from the render interface to the renderer
 	/// @param[in] context The context to read the clip region from
 	static void ApplyActiveClipRegion(Context* context);
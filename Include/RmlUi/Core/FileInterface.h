@@ -87,6 +87,18 @@ public:
 	/// @param out_data The string contents of the file.
 	/// @return True on success.
 	virtual bool LoadFile(const String& path, String& out_data);
+
+	/// Maps a file into memory for reading, so that its contents are only loaded as they are accessed. Used for large files such as fonts.
+	/// The default implementation returns false, in which case the file is read into memory using the functions above instead.
+	/// @param path The path to the file to map.
+	/// @param out_data The start of the mapped contents of the file.
+	/// @param out_size The length of the file in bytes.
+	/// @return True if the file was mapped, it will later be released through UnmapFile().
+	virtual bool MapFile(const String& path, const byte*& out_data, size_t& out_size);
+	/// Releases a file previously mapped through MapFile().
+	/// @param data The start of the mapped contents of the file.
+	/// @param size The length of the file in bytes.
+	virtual void UnmapFile(const byte* data, size_t size);
 };
 
 } // namespace Rml
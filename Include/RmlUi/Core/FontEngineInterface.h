@@ -115,6 +115,13 @@ public:
 	/// @return The version required for using any geometry generated with the face handle.
 	virtual int GetVersion(FontFaceHandle handle);
 
+	/// Called by RmlUi when an element starts using a font face handle, such as when its font properties are resolved to the handle.
+	/// @param[in] handle The font handle.
+	virtual void AddFontFaceHandleReference(FontFaceHandle handle);
+	/// Called by RmlUi when an element stops using a font face handle it previously added a reference to, or when the element is destroyed.
+	/// @param[in] handle The font handle.
+	virtual void RemoveFontFaceHandleReference(FontFaceHandle handle);
+
 	/// Called by RmlUi when it wants to garbage collect memory used by fonts.
 	/// @note All existing FontFaceHandles and FontEffectsHandles are considered invalid after this call.
 	virtual void ReleaseFontResources();
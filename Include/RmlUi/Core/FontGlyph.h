@@ -33,6 +33,22 @@
 
 namespace Rml {
 
+/**
+    Signed distance field of a glyph's outline. It is rasterized once at a reference size, and shared by all sizes of the font face.
+ */
+
+struct FontGlyphDistanceField {
+	/// Distances sampled at pixel centers, with the outline at 128 and increasing towards the inside of the glyph.
+	UniquePtr<byte[]> data;
+	Vector2i dimensions;
+	/// The position of the top-left corner of the field relative to the glyph origin, in reference pixels with y pointing down.
+	Vector2i offset;
+	/// The distance, in reference pixels, represented by the full range of values to each side of the outline.
+	float spread = 0.f;
+	/// The font size the field was rasterized at.
+	int reference_size = 0;
+};
+
 /**
     Metrics and bitmap data for a single glyph within a font face.
 
@@ -61,6 +77,20 @@ public:
 	// bitmap_data may point to this member or another font glyph data.
 	UniquePtr<byte[]> bitmap_owned_data;
 
+	/// The distance field the bitmap was generated from when distance field rendering is enabled, otherwise nullptr.
+	const FontGlyphDistanceField* distance_field = nullptr;
+	/// The size of the glyph relative to the reference size of its distance field.
+	float distance_field_scale = 1.f;
+
+	/// Samples the signed distance to the glyph's outline at the pixel centers of a region, positive inside the glyph. Only valid with a
+	/// distance field.
+	/// @param[in] offset The top-left corner of the region relative to the top-left corner of the glyph's bitmap, in pixels.
+	/// @param[in] dimensions The dimensions of the region, in pixels.
+	/// @param[out] distances The distances in pixels at the glyph's size, one per pixel of the region stored row by row.
+	void GetDistances(Vector2i offset, Vector2i dimensions, float* distances) const;
+	/// Returns the distance from the outline, in pixels at the glyph's size, up to which distances are accurate.
+	float GetDistanceFieldSpread() const;
+
 	// Create a copy with its bitmap data owned by another glyph.
 	FontGlyph WeakCopy() const
 	{
@@ -71,6 +101,8 @@ public:
 		glyph.bitmap_data = bitmap_data;
 		glyph.bitmap_dimensions = bitmap_dimensions;
 		glyph.color_format = color_format;
+		glyph.distance_field = distance_field;
+		glyph.distance_field_scale = distance_field_scale;
 		return glyph;
 	}
 };
@@ -39,6 +39,8 @@ class Context;
 class Element;
 struct Texture;
 using GeometryDatabaseHandle = uint32_t;
+using GeometryArenaHandle = uint32_t;
+using GeometryBatchHandle = uint32_t;
 
 /**
     A helper object for holding an array of vertices and indices, and compiling it as necessary when rendered.
@@ -58,11 +60,14 @@ public:
 
 	~Geometry();
 
-	/// Attempts to compile the geometry if appropriate, then renders the geometry, compiled if it can.
+	/// Renders the geometry, compiled if it can. Geometry rendered for the first time is placed in the geometry arena or staged to be
+	/// compiled with other geometry at the start of the next context render, until then it is rendered uncompiled.
 	/// @param[in] translation The translation of the geometry.
 	void Render(Vector2f translation);
 
 	/// Returns the geometry's vertices. If these are written to, Release() should be called to force a recompile.
+	/// @note If the geometry has been moved into the shared geometry arena, it is first copied back out of it. Similarly, texture coordinates
+	/// adjusted to the texture's region in the texture atlas and vertex colours modulated during rendering are restored.
 	/// @return The geometry's vertex array.
 	Vector<Vertex>& GetVertices();
 	/// Returns the geometry's indices. If these are written to, Release() should be called to force a recompile.
@@ -85,6 +90,12 @@ public:
 private:
 	// Move members from another geometry.
 	void MoveFrom(Geometry& other) noexcept;
+	// Move our vertices and indices back out of the geometry arena, if they have been placed there.
+	void DetachFromArena(bool restore_data);
+	// Maps our original texture coordinates into the given region of the texture handle.
+	void SetTexCoordRegion(Rectanglef region);
+	// Multiplies our original vertex colours by the given colour, used when the render interface can't modulate colours itself.
+	void SetVertexColourModulation(Colourb colour);
 
 	Vector<Vertex> vertices;
 	Vector<int> indices;
@@ -93,6 +104,24 @@ private:
 	CompiledGeometryHandle compiled_geometry = 0;
 	bool compile_attempted = false;
 
+	// The texture handle our geometry was compiled with, or staged to be compiled with.
+	TextureHandle compiled_texture_handle = 0;
+
+	// Set when our data has been moved into the geometry arena, in which case the local vertices and indices are empty.
+	GeometryArenaHandle arena_handle = 0;
+
+	// Set while our data is staged to be compiled in the next batch, or the compiled result is waiting for us to take it.
+	GeometryBatchHandle batch_handle = 0;
+
+	// The region of the texture handle our texture coordinates currently map to, only differs from the full texture for atlas textures.
+	// While it differs, our original texture coordinates are kept so that they can be mapped into the region anew.
+	Rectanglef texcoord_region = Rectanglef::FromSize(Vector2f(1.f));
+	Vector<Vector2f> unmapped_tex_coords;
+
+	// The colour modulation applied to our vertex colours, and their original colours while it differs from opaque white.
+	Colourb vertex_colour_modulation = Colourb(255, 255, 255, 255);
+	Vector<Colourb> unmodulated_colours;
+
 	GeometryDatabaseHandle database_handle;
 };
 
@@ -33,6 +33,14 @@
 #include "Math.h"
 #include "Vector4.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define RMLUI_MATRIX4_SSE
+	#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define RMLUI_MATRIX4_NEON
+	#include <arm_neon.h>
+#endif
+
 namespace Rml {
 
 /**
@@ -137,6 +145,25 @@ struct RowMajorStorage;
 template <typename Component>
 struct ColumnMajorStorage;
 
+/**
+    Templated class implementing the arithmetic of matrices on their vectors, independent of the storage order.
+    Specialized for floats using SIMD instructions where available.
+ */
+template <typename Component>
+struct MatrixKernels {
+	typedef Vector4<Component> VectorType;
+
+	/// Sets each result vector to the sum of the basis vectors, weighted by the components of the corresponding weights vector.
+	static void Combine(const VectorType* basis, const VectorType* weights, VectorType* result) noexcept;
+
+	/// Returns the sum of the basis vectors weighted by the components of the weights vector.
+	static VectorType Combine(const VectorType* basis, const VectorType& weights) noexcept;
+
+	/// Writes the inverse of the matrix given by its vectors to the result, if possible.
+	/// @return true, if the matrix is invertible.
+	static bool Invert(const VectorType* vectors, VectorType* result) noexcept;
+};
+
 /**
     Templated class that defines the vectors access pattern for row-major matrices.
     @author Markus Schöngart
@@ -28,6 +28,235 @@
 
 namespace Rml {
 
+template <typename Component>
+void MatrixKernels<Component>::Combine(const VectorType* basis, const VectorType* weights, VectorType* result) noexcept
+{
+	for (int i = 0; i < 4; ++i)
+		result[i] = Combine(basis, weights[i]);
+}
+
+template <typename Component>
+typename MatrixKernels<Component>::VectorType MatrixKernels<Component>::Combine(const VectorType* basis, const VectorType& weights) noexcept
+{
+	VectorType result;
+	for (int j = 0; j < 4; ++j)
+		result[j] = weights[0] * basis[0][j] + weights[1] * basis[1][j] + weights[2] * basis[2][j] + weights[3] * basis[3][j];
+	return result;
+}
+
+template <typename Component>
+bool MatrixKernels<Component>::Invert(const VectorType* vectors, VectorType* result) noexcept
+{
+	// This is from the MESA implementation of the GLU library.
+	const Component* src = &vectors[0][0];
+	Component* dst = &result[0][0];
+
+	dst[0] = src[5] * src[10] * src[15] - src[5] * src[11] * src[14] - src[9] * src[6] * src[15] + src[9] * src[7] * src[14] +
+		src[13] * src[6] * src[11] - src[13] * src[7] * src[10];
+
+	dst[4] = -src[4] * src[10] * src[15] + src[4] * src[11] * src[14] + src[8] * src[6] * src[15] - src[8] * src[7] * src[14] -
+		src[12] * src[6] * src[11] + src[12] * src[7] * src[10];
+
+	dst[8] = src[4] * src[9] * src[15] - src[4] * src[11] * src[13] - src[8] * src[5] * src[15] + src[8] * src[7] * src[13] +
+		src[12] * src[5] * src[11] - src[12] * src[7] * src[9];
+
+	dst[12] = -src[4] * src[9] * src[14] + src[4] * src[10] * src[13] + src[8] * src[5] * src[14] - src[8] * src[6] * src[13] -
+		src[12] * src[5] * src[10] + src[12] * src[6] * src[9];
+
+	dst[1] = -src[1] * src[10] * src[15] + src[1] * src[11] * src[14] + src[9] * src[2] * src[15] - src[9] * src[3] * src[14] -
+		src[13] * src[2] * src[11] + src[13] * src[3] * src[10];
+
+	dst[5] = src[0] * src[10] * src[15] - src[0] * src[11] * src[14] - src[8] * src[2] * src[15] + src[8] * src[3] * src[14] +
+		src[12] * src[2] * src[11] - src[12] * src[3] * src[10];
+
+	dst[9] = -src[0] * src[9] * src[15] + src[0] * src[11] * src[13] + src[8] * src[1] * src[15] - src[8] * src[3] * src[13] -
+		src[12] * src[1] * src[11] + src[12] * src[3] * src[9];
+
+	dst[13] = src[0] * src[9] * src[14] - src[0] * src[10] * src[13] - src[8] * src[1] * src[14] + src[8] * src[2] * src[13] +
+		src[12] * src[1] * src[10] - src[12] * src[2] * src[9];
+
+	dst[2] = src[1] * src[6] * src[15] - src[1] * src[7] * src[14] - src[5] * src[2] * src[15] + src[5] * src[3] * src[14] +
+		src[13] * src[2] * src[7] - src[13] * src[3] * src[6];
+
+	dst[6] = -src[0] * src[6] * src[15] + src[0] * src[7] * src[14] + src[4] * src[2] * src[15] - src[4] * src[3] * src[14] -
+		src[12] * src[2] * src[7] + src[12] * src[3] * src[6];
+
+	dst[10] = src[0] * src[5] * src[15] - src[0] * src[7] * src[13] - src[4] * src[1] * src[15] + src[4] * src[3] * src[13] +
+		src[12] * src[1] * src[7] - src[12] * src[3] * src[5];
+
+	dst[14] = -src[0] * src[5] * src[14] + src[0] * src[6] * src[13] + src[4] * src[1] * src[14] - src[4] * src[2] * src[13] -
+		src[12] * src[1] * src[6] + src[12] * src[2] * src[5];
+
+	dst[3] = -src[1] * src[6] * src[11] + src[1] * src[7] * src[10] + src[5] * src[2] * src[11] - src[5] * src[3] * src[10] -
+		src[9] * src[2] * src[7] + src[9] * src[3] * src[6];
+
+	dst[7] = src[0] * src[6] * src[11] - src[0] * src[7] * src[10] - src[4] * src[2] * src[11] + src[4] * src[3] * src[10] +
+		src[8] * src[2] * src[7] - src[8] * src[3] * src[6];
+
+	dst[11] = -src[0] * src[5] * src[11] + src[0] * src[7] * src[9] + src[4] * src[1] * src[11] - src[4] * src[3] * src[9] -
+		src[8] * src[1] * src[7] + src[8] * src[3] * src[5];
+
+	dst[15] = src[0] * src[5] * src[10] - src[0] * src[6] * src[9] - src[4] * src[1] * src[10] + src[4] * src[2] * src[9] + src[8] * src[1] * src[6] -
+		src[8] * src[2] * src[5];
+
+	Component det = src[0] * dst[0] + src[1] * dst[4] + src[2] * dst[8] + src[3] * dst[12];
+
+	if (det == 0)
+	{
+		return false;
+	}
+
+	const Component inv_det = 1 / det;
+	for (int i = 0; i < 16; ++i)
+		dst[i] *= inv_det;
+
+	return true;
+}
+
+#if defined(RMLUI_MATRIX4_SSE)
+
+template <>
+inline void MatrixKernels<float>::Combine(const VectorType* basis, const VectorType* weights, VectorType* result) noexcept
+{
+	const __m128 b0 = _mm_loadu_ps(&basis[0].x);
+	const __m128 b1 = _mm_loadu_ps(&basis[1].x);
+	const __m128 b2 = _mm_loadu_ps(&basis[2].x);
+	const __m128 b3 = _mm_loadu_ps(&basis[3].x);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const __m128 w = _mm_loadu_ps(&weights[i].x);
+		__m128 r = _mm_mul_ps(b0, _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm_add_ps(r, _mm_mul_ps(b1, _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1))));
+		r = _mm_add_ps(r, _mm_mul_ps(b2, _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2))));
+		r = _mm_add_ps(r, _mm_mul_ps(b3, _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3))));
+		_mm_storeu_ps(&result[i].x, r);
+	}
+}
+
+template <>
+inline MatrixKernels<float>::VectorType MatrixKernels<float>::Combine(const VectorType* basis, const VectorType& weights) noexcept
+{
+	const __m128 w = _mm_loadu_ps(&weights.x);
+	__m128 r = _mm_mul_ps(_mm_loadu_ps(&basis[0].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&basis[1].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1))));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&basis[2].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2))));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&basis[3].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3))));
+
+	VectorType result;
+	_mm_storeu_ps(&result.x, r);
+	return result;
+}
+
+template <>
+inline bool MatrixKernels<float>::Invert(const VectorType* vectors, VectorType* result) noexcept
+{
+	// Block-wise inversion, treating the vectors as rows of the 2x2 sub-matrices A, B (top) and C, D (bottom). The inverse of the transpose is the
+	// transpose of the inverse, thus the storage order does not matter. Each sub-matrix is stored row by row in a single register.
+	const __m128 v0 = _mm_loadu_ps(&vectors[0].x);
+	const __m128 v1 = _mm_loadu_ps(&vectors[1].x);
+	const __m128 v2 = _mm_loadu_ps(&vectors[2].x);
+	const __m128 v3 = _mm_loadu_ps(&vectors[3].x);
+
+	const __m128 A = _mm_movelh_ps(v0, v1);
+	const __m128 B = _mm_movehl_ps(v1, v0);
+	const __m128 C = _mm_movelh_ps(v2, v3);
+	const __m128 D = _mm_movehl_ps(v3, v2);
+
+	// 2x2 matrix product, the adjugate of the left matrix times the right matrix, and the left matrix times the adjugate of the right matrix.
+	auto Mul2 = [](__m128 a, __m128 b) {
+		return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+	};
+	auto AdjMul2 = [](__m128 a, __m128 b) {
+		return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+	};
+	auto MulAdj2 = [](__m128 a, __m128 b) {
+		return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+	};
+
+	// Determinants of the sub-matrices as (|A|, |B|, |C|, |D|).
+	const __m128 det_sub = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(v0, v2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(v0, v2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(2, 0, 2, 0))));
+	const __m128 det_A = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(0, 0, 0, 0));
+	const __m128 det_B = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(1, 1, 1, 1));
+	const __m128 det_C = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(2, 2, 2, 2));
+	const __m128 det_D = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(3, 3, 3, 3));
+
+	const __m128 D_C = AdjMul2(D, C);
+	const __m128 A_B = AdjMul2(A, B);
+
+	// The adjugates of the blocks of the inverse, scaled by the determinant of the whole matrix.
+	__m128 X = _mm_sub_ps(_mm_mul_ps(det_D, A), Mul2(B, D_C));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(det_A, D), Mul2(C, A_B));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(det_B, C), MulAdj2(D, A_B));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(det_C, B), MulAdj2(A, D_C));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	__m128 trace = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+	trace = _mm_add_ps(trace, _mm_movehl_ps(trace, trace));
+	trace = _mm_add_ss(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 1, 1, 1)));
+	__m128 det = _mm_sub_ss(_mm_add_ss(_mm_mul_ss(det_A, det_D), _mm_mul_ss(det_B, det_C)), trace);
+
+	if (_mm_cvtss_f32(det) == 0.f)
+		return false;
+
+	det = _mm_shuffle_ps(det, det, _MM_SHUFFLE(0, 0, 0, 0));
+	const __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+	X = _mm_mul_ps(X, inv_det);
+	Y = _mm_mul_ps(Y, inv_det);
+	Z = _mm_mul_ps(Z, inv_det);
+	W = _mm_mul_ps(W, inv_det);
+
+	// Apply the adjugate shuffle of each block while storing them.
+	_mm_storeu_ps(&result[0].x, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(&result[1].x, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(&result[2].x, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(&result[3].x, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+
+	return true;
+}
+
+#elif defined(RMLUI_MATRIX4_NEON)
+
+template <>
+inline void MatrixKernels<float>::Combine(const VectorType* basis, const VectorType* weights, VectorType* result) noexcept
+{
+	const float32x4_t b0 = vld1q_f32(&basis[0].x);
+	const float32x4_t b1 = vld1q_f32(&basis[1].x);
+	const float32x4_t b2 = vld1q_f32(&basis[2].x);
+	const float32x4_t b3 = vld1q_f32(&basis[3].x);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		// Multiply and add separately, fused instructions would round differently from the scalar implementation.
+		float32x4_t r = vmulq_n_f32(b0, weights[i].x);
+		r = vaddq_f32(r, vmulq_n_f32(b1, weights[i].y));
+		r = vaddq_f32(r, vmulq_n_f32(b2, weights[i].z));
+		r = vaddq_f32(r, vmulq_n_f32(b3, weights[i].w));
+		vst1q_f32(&result[i].x, r);
+	}
+}
+
+template <>
+inline MatrixKernels<float>::VectorType MatrixKernels<float>::Combine(const VectorType* basis, const VectorType& weights) noexcept
+{
+	float32x4_t r = vmulq_n_f32(vld1q_f32(&basis[0].x), weights.x);
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(&basis[1].x), weights.y));
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(&basis[2].x), weights.z));
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(&basis[3].x), weights.w));
+
+	VectorType result;
+	vst1q_f32(&result.x, r);
+	return result;
+}
+
+#endif
+
+
 template <typename Component, class Storage>
 Matrix4<Component, Storage>::Matrix4(const typename Matrix4<Component, Storage>::VectorType& vec0,
 	const typename Matrix4<Component, Storage>::VectorType& vec1, const typename Matrix4<Component, Storage>::VectorType& vec2,
@@ -159,67 +388,11 @@ void Matrix4<Component, Storage>::SetColumns(const VectorType& vec0, const Vecto
 template <typename Component, class Storage>
 bool Matrix4<Component, Storage>::Invert() noexcept
 {
-	// This is from the MESA implementation of the GLU library.
 	Matrix4<Component, Storage>::ThisType result;
-	Component* dst = result.data();
-	const Component* src = data();
-
-	dst[0] = src[5] * src[10] * src[15] - src[5] * src[11] * src[14] - src[9] * src[6] * src[15] + src[9] * src[7] * src[14] +
-		src[13] * src[6] * src[11] - src[13] * src[7] * src[10];
-
-	dst[4] = -src[4] * src[10] * src[15] + src[4] * src[11] * src[14] + src[8] * src[6] * src[15] - src[8] * src[7] * src[14] -
-		src[12] * src[6] * src[11] + src[12] * src[7] * src[10];
-
-	dst[8] = src[4] * src[9] * src[15] - src[4] * src[11] * src[13] - src[8] * src[5] * src[15] + src[8] * src[7] * src[13] +
-		src[12] * src[5] * src[11] - src[12] * src[7] * src[9];
-
-	dst[12] = -src[4] * src[9] * src[14] + src[4] * src[10] * src[13] + src[8] * src[5] * src[14] - src[8] * src[6] * src[13] -
-		src[12] * src[5] * src[10] + src[12] * src[6] * src[9];
-
-	dst[1] = -src[1] * src[10] * src[15] + src[1] * src[11] * src[14] + src[9] * src[2] * src[15] - src[9] * src[3] * src[14] -
-		src[13] * src[2] * src[11] + src[13] * src[3] * src[10];
-
-	dst[5] = src[0] * src[10] * src[15] - src[0] * src[11] * src[14] - src[8] * src[2] * src[15] + src[8] * src[3] * src[14] +
-		src[12] * src[2] * src[11] - src[12] * src[3] * src[10];
-
-	dst[9] = -src[0] * src[9] * src[15] + src[0] * src[11] * src[13] + src[8] * src[1] * src[15] - src[8] * src[3] * src[13] -
-		src[12] * src[1] * src[11] + src[12] * src[3] * src[9];
-
-	dst[13] = src[0] * src[9] * src[14] - src[0] * src[10] * src[13] - src[8] * src[1] * src[14] + src[8] * src[2] * src[13] +
-		src[12] * src[1] * src[10] - src[12] * src[2] * src[9];
-
-	dst[2] = src[1] * src[6] * src[15] - src[1] * src[7] * src[14] - src[5] * src[2] * src[15] + src[5] * src[3] * src[14] +
-		src[13] * src[2] * src[7] - src[13] * src[3] * src[6];
-
-	dst[6] = -src[0] * src[6] * src[15] + src[0] * src[7] * src[14] + src[4] * src[2] * src[15] - src[4] * src[3] * src[14] -
-		src[12] * src[2] * src[7] + src[12] * src[3] * src[6];
-
-	dst[10] = src[0] * src[5] * src[15] - src[0] * src[7] * src[13] - src[4] * src[1] * src[15] + src[4] * src[3] * src[13] +
-		src[12] * src[1] * src[7] - src[12] * src[3] * src[5];
-
-	dst[14] = -src[0] * src[5] * src[14] + src[0] * src[6] * src[13] + src[4] * src[1] * src[14] - src[4] * src[2] * src[13] -
-		src[12] * src[1] * src[6] + src[12] * src[2] * src[5];
-
-	dst[3] = -src[1] * src[6] * src[11] + src[1] * src[7] * src[10] + src[5] * src[2] * src[11] - src[5] * src[3] * src[10] -
-		src[9] * src[2] * src[7] + src[9] * src[3] * src[6];
-
-	dst[7] = src[0] * src[6] * src[11] - src[0] * src[7] * src[10] - src[4] * src[2] * src[11] + src[4] * src[3] * src[10] +
-		src[8] * src[2] * src[7] - src[8] * src[3] * src[6];
-
-	dst[11] = -src[0] * src[5] * src[11] + src[0] * src[7] * src[9] + src[4] * src[1] * src[11] - src[4] * src[3] * src[9] -
-		src[8] * src[1] * src[7] + src[8] * src[3] * src[5];
-
-	dst[15] = src[0] * src[5] * src[10] - src[0] * src[6] * src[9] - src[4] * src[1] * src[10] + src[4] * src[2] * src[9] + src[8] * src[1] * src[6] -
-		src[8] * src[2] * src[5];
-
-	float det = src[0] * dst[0] + src[1] * dst[4] + src[2] * dst[8] + src[3] * dst[12];
-
-	if (det == 0)
-	{
+	if (!MatrixKernels<Component>::Invert(vectors, result.vectors))
 		return false;
-	}
 
-	*this = result * (1 / det);
+	*this = result;
 	return true;
 }
 
@@ -585,8 +758,7 @@ struct Matrix4<Component, Storage>::VectorMultiplier<_Component, ColumnMajorStor
 
 	static const VectorType Multiply(const MatrixAType& lhs, const VectorType& rhs) noexcept
 	{
-		typename MatrixAType::ConstRows rows(lhs.vectors);
-		return VectorType(rhs.DotProduct(rows[0]), rhs.DotProduct(rows[1]), rhs.DotProduct(rows[2]), rhs.DotProduct(rows[3]));
+		return MatrixKernels<ComponentType>::Combine(lhs.vectors, rhs);
 	}
 };
 
@@ -616,6 +788,24 @@ struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, RowMajorStorage
 	}
 };
 
+template <typename Component, class Storage>
+template <typename _Component>
+struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, RowMajorStorage<_Component>, RowMajorStorage<_Component>> {
+	typedef _Component ComponentType;
+	typedef RowMajorStorage<ComponentType> StorageAType;
+	typedef RowMajorStorage<ComponentType> StorageBType;
+	typedef Matrix4<ComponentType, StorageAType> MatrixAType;
+	typedef Matrix4<ComponentType, StorageBType> MatrixBType;
+
+	static const MatrixAType Multiply(const MatrixAType& lhs, const MatrixBType& rhs) noexcept
+	{
+		// Each row of the result combines the rows of the right-hand side, weighted by the corresponding row of the left-hand side.
+		typename MatrixAType::ThisType result;
+		MatrixKernels<ComponentType>::Combine(rhs.vectors, lhs.vectors, result.vectors);
+		return result;
+	}
+};
+
 template <typename Component, class Storage>
 template <typename _Component>
 struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, ColumnMajorStorage<_Component>, ColumnMajorStorage<_Component>> {
@@ -627,17 +817,9 @@ struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, ColumnMajorStor
 
 	static const MatrixAType Multiply(const MatrixAType& lhs, const MatrixBType& rhs) noexcept
 	{
+		// Each column of the result combines the columns of the left-hand side, weighted by the corresponding column of the right-hand side.
 		typename MatrixAType::ThisType result;
-		typename MatrixAType::Rows result_rows(result.vectors);
-		typename MatrixAType::ConstRows lhs_rows(lhs.vectors);
-		typename MatrixBType::ConstColumns rhs_columns(rhs.vectors);
-		for (int i = 0; i < 4; ++i)
-		{
-			for (int j = 0; j < 4; ++j)
-			{
-				result_rows[i][j] = rhs_columns[j].DotProduct(lhs_rows[i]);
-			}
-		}
+		MatrixKernels<ComponentType>::Combine(lhs.vectors, rhs.vectors, result.vectors);
 		return result;
 	}
 };
@@ -37,6 +37,18 @@
 
 namespace Rml {
 
+/**
+    Describes one geometry in a batch passed to RenderInterface::CompileGeometryBatch(), as ranges into the batch's shared vertex and index
+    buffers. The indices of each geometry refer to its own vertices, starting from zero at its first vertex.
+ */
+struct GeometryBatchEntry {
+	int vertex_offset;
+	int num_vertices;
+	int index_offset;
+	int num_indices;
+	TextureHandle texture;
+};
+
 /**
     The abstract base class for application-specific rendering implementation. Your application must provide a concrete
     implementation of this class and install it through Rml::SetRenderInterface() in order for anything to be rendered.
@@ -78,6 +90,39 @@ public:
 	/// Called by RmlUi when it wants to release application-compiled geometry.
 	/// @param[in] geometry The application-specific compiled geometry to release.
 	virtual void ReleaseCompiledGeometry(CompiledGeometryHandle geometry);
+	/// Called by RmlUi when it wants to compile several geometries at once, such as all geometry first rendered during the previous frame.
+	/// The data of all the geometries is placed in a single staging buffer, which may be uploaded in one go. Each geometry must still be
+	/// given its own handle, to be rendered with RenderCompiledGeometry() and released with ReleaseCompiledGeometry() as usual. If not
+	/// overridden, each geometry is compiled separately with CompileGeometry().
+	/// @param[in] vertices The vertex data of all the geometries.
+	/// @param[in] num_vertices The total number of vertices passed to the function.
+	/// @param[in] indices The index data of all the geometries.
+	/// @param[in] num_indices The total number of indices passed to the function.
+	/// @param[in] geometries The location of each geometry within the vertex and index data, and its texture.
+	/// @param[in] num_geometries The number of geometries to compile.
+	/// @param[out] compiled_geometries The array to write the compiled handle of each geometry to, or zero if it could not be compiled.
+	virtual void CompileGeometryBatch(Vertex* vertices, int num_vertices, int* indices, int num_indices, const GeometryBatchEntry* geometries,
+		int num_geometries, CompiledGeometryHandle* compiled_geometries);
+
+	/// Called by RmlUi when it wants to compile a chunk of geometry, containing the vertices and indices of many separate geometries.
+	/// If supported, this should return a handle to an optimised, application-specific version of the data. Then, RmlUi will place geometry
+	/// in shared chunks and render sub-ranges of them with RenderCompiledGeometryChunk(). If not, do not override the function or return zero;
+	/// each geometry is then compiled separately with CompileGeometry().
+	/// @param[in] vertices The chunk's vertex data.
+	/// @param[in] num_vertices The number of vertices passed to the function.
+	/// @param[in] indices The chunk's index data, referring to vertices anywhere in the chunk.
+	/// @param[in] num_indices The number of indices passed to the function. This will always be a multiple of three.
+	/// @return The application-specific compiled chunk. It will be rendered using RenderCompiledGeometryChunk(), and released with
+	/// ReleaseCompiledGeometry() when it is no longer needed.
+	virtual CompiledGeometryHandle CompileGeometryChunk(Vertex* vertices, int num_vertices, int* indices, int num_indices);
+	/// Called by RmlUi when it wants to render a range of indices from an application-compiled geometry chunk.
+	/// @param[in] chunk The application-specific compiled chunk to render from.
+	/// @param[in] first_index The first index of the range to render.
+	/// @param[in] num_indices The number of indices to render. This will always be a multiple of three.
+	/// @param[in] texture The texture to be applied to the geometry. This may be nullptr, in which case the geometry is untextured.
+	/// @param[in] translation The translation to apply to the geometry.
+	virtual void RenderCompiledGeometryChunk(CompiledGeometryHandle chunk, int first_index, int num_indices, TextureHandle texture,
+		const Vector2f& translation);
 
 	/// Called by RmlUi when it wants to enable or disable scissoring to clip content.
 	/// @param[in] enable True if scissoring is to enabled, false if it is to be disabled.
@@ -95,12 +140,34 @@ public:
 	/// @param[in] source The application-defined image source, joined with the path of the referencing document.
 	/// @return True if the load attempt succeeded and the handle and dimensions are valid, false if not.
 	virtual bool LoadTexture(TextureHandle& texture_handle, Vector2i& texture_dimensions, const String& source);
+	/// Called by RmlUi when it wants to place a small image in the shared texture atlas, instead of loading it as a separate texture.
+	/// If supported, load the image and return its pixel data. If not, do not override the function or return false; the image is then
+	/// loaded through LoadTexture() instead.
+	/// @param[out] texture_data The raw 8-bit texture data, in the same format as the source data passed to GenerateTexture().
+	/// @param[out] texture_dimensions The variable to write the dimensions of the loaded texture.
+	/// @param[in] source The application-defined image source, joined with the path of the referencing document.
+	/// @return True if the load attempt succeeded and the data and dimensions are valid, false if not.
+	virtual bool LoadTextureData(Vector<byte>& texture_data, Vector2i& texture_dimensions, const String& source);
 	/// Called by RmlUi when a texture is required to be built from an internally-generated sequence of pixels.
 	/// @param[out] texture_handle The handle to write the texture handle for the generated texture to.
 	/// @param[in] source The raw 8-bit texture data. Each pixel is made up of four 8-bit values, indicating red, green, blue and alpha in that order.
 	/// @param[in] source_dimensions The dimensions, in pixels, of the source data.
 	/// @return True if the texture generation succeeded and the handle is valid, false if not.
 	virtual bool GenerateTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions);
+	/// Called by RmlUi to find out whether the render interface can render textures generated by GenerateDistanceFieldTexture(). This lets
+	/// the default font engine render all sizes of a font face from a single glyph atlas, when distance field glyphs are enabled with
+	/// Rml::SetFontDistanceFieldSize(). If not overridden, a glyph texture is generated for each font size instead.
+	/// @return True if distance field textures are supported, false if not.
+	virtual bool SupportsDistanceFieldTextures();
+	/// Called by RmlUi when a texture holding a signed distance field is required. When geometry is rendered with this texture, threshold the
+	/// interpolated distance at the outline, smoothed over the width of a pixel on screen, and use the result in place of the texture's alpha.
+	/// Only called when SupportsDistanceFieldTextures() returns true.
+	/// @param[out] texture_handle The handle to write the texture handle for the generated texture to.
+	/// @param[in] source The raw 8-bit texture data, in the same format as for GenerateTexture(). The colour is white, while the alpha holds the
+	/// distance to the outline, which is at 128 and increases towards the inside of the shape.
+	/// @param[in] source_dimensions The dimensions, in pixels, of the source data.
+	/// @return True if the texture generation succeeded and the handle is valid, false if not.
+	virtual bool GenerateDistanceFieldTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions);
 	/// Called by RmlUi when a loaded texture is no longer required.
 	/// @param texture The texture handle to release.
 	virtual void ReleaseTexture(TextureHandle texture);
@@ -110,6 +177,17 @@ public:
 	/// is submitted. Then it expects the renderer to use an identity matrix or otherwise omit the multiplication with the transform.
 	/// @param[in] transform The new transform to apply, or nullptr if no transform applies to the current element.
 	virtual void SetTransform(const Matrix4f* transform);
+
+	/// Called by RmlUi to find out whether the render interface supports colour modulation through SetColourModulation().
+	/// This is used to apply element opacity, which lets opacity changes and animations reuse the existing geometry. If not overridden, RmlUi
+	/// applies the opacity to the vertex colours instead.
+	/// @return True if colour modulation is supported, false if not.
+	virtual bool SupportsColourModulation();
+	/// Called by RmlUi when it wants the colour of subsequently rendered geometry to be multiplied by the given colour. Multiply the vertex
+	/// colours by the given colour in all the render functions until it is changed again. Only called when SupportsColourModulation() returns
+	/// true.
+	/// @param[in] colour The colour to multiply vertex colours by, opaque white when no modulation applies.
+	virtual void SetColourModulation(const Colourb& colour);
 };
 
 } // namespace Rml
@@ -74,6 +74,9 @@ public:
 	/// Returns the texture's dimensions, will attempt to load the texture as necessary.
 	/// @return The texture's dimensions. This will be (0, 0) if the texture cannot be loaded.
 	Vector2i GetDimensions() const;
+	/// Returns the region of the texture handle occupied by this texture, will attempt to load the texture as necessary.
+	/// @return The region in normalized texture coordinates. This covers the whole texture, unless the texture has been placed in the texture atlas.
+	Rectanglef GetAtlasRegion() const;
 
 	/// Returns true if the texture points to the same underlying resource.
 	bool operator==(const Texture&) const;
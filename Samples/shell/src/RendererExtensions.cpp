@@ -57,6 +57,11 @@
 
 	#include <GLES3/gl3.h>
 
+#elif defined RMLUI_RENDERER_SOFTWARE
+
+	#include <RmlUi_Backend.h>
+	#include <RmlUi_Renderer_Software.h>
+
 #endif
 
 RendererExtensions::Image RendererExtensions::CaptureScreen()
@@ -92,6 +97,37 @@ RendererExtensions::Image RendererExtensions::CaptureScreen()
 
 	return image;
 
+#elif defined RMLUI_RENDERER_SOFTWARE
+
+	const RenderInterface_Software* render_interface = static_cast<RenderInterface_Software*>(Backend::GetRenderInterface());
+
+	Image image;
+	image.num_components = 3;
+	image.width = render_interface->GetViewportWidth();
+	image.height = render_interface->GetViewportHeight();
+
+	if (image.width < 1 || image.height < 1)
+		return Image();
+
+	const int byte_size = image.width * image.height * image.num_components;
+	image.data = Rml::UniquePtr<Rml::byte[]>(new Rml::byte[byte_size]);
+
+	// Match the bottom-up row order read back by the OpenGL renderers.
+	const Rml::byte* color_buffer = render_interface->GetColorBuffer();
+	for (int y = 0; y < image.height; y++)
+	{
+		const Rml::byte* src = color_buffer + (image.height - y - 1) * image.width * 4;
+		Rml::byte* dst = image.data.get() + y * image.width * image.num_components;
+		for (int x = 0; x < image.width; x++)
+		{
+			dst[3 * x + 0] = src[4 * x + 0];
+			dst[3 * x + 1] = src[4 * x + 1];
+			dst[3 * x + 2] = src[4 * x + 2];
+		}
+	}
+
+	return image;
+
 #else
 
 	return Image();
@@ -40,6 +40,7 @@
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "DataModel.h"
 #include "EventDispatcher.h"
+#include "GeometryDatabase.h"
 #include "PluginRegistry.h"
 #include "RmlUi/Core/Debug.h"
 #include "ScrollController.h"
@@ -218,6 +219,13 @@ bool Context::Render()
 {
 	RMLUI_ZoneScoped;
 
+	render_statistics = {};
+
+	// Compile the geometry placed in the arena since the last render, so that it can be rendered in its compiled form.
+	GeometryDatabase::CompileArena();
+	// Similarly, compile all other geometry first rendered since then in a single batch.
+	GeometryDatabase::CompileBatch();
+
 	ElementUtilities::ApplyActiveClipRegion(this);
 
 	root->Render();
@@ -233,9 +241,17 @@ bool Context::Render()
 		cursor_proxy->Render();
 	}
 
+	// Leave the render interface without any colour modulation for the application's own rendering.
+	GeometryDatabase::SetColourModulation(Colourb(255, 255, 255, 255));
+
 	return true;
 }
 
+const Context::RenderStatistics& Context::GetRenderStatistics() const
+{
+	return render_statistics;
+}
+
 ElementDocument* Context::CreateDocument(const String& instancer_name)
 {
 	ElementPtr element = Factory::InstanceElement(nullptr, instancer_name, documents_base_tag, XMLAttributes());
@@ -1185,8 +1201,8 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 	// that is under the cursor.
 	if (element->local_stacking_context)
 	{
-		if (element->stacking_context_dirty)
-			element->BuildLocalStackingContext();
+		// Make sure any elements queued for insertion can be found before they are rendered.
+		element->UpdateLocalStackingContext();
 
 		for (int i = (int)element->stacking_context.size() - 1; i >= 0; --i)
 		{
@@ -28,11 +28,82 @@
 
 #include "../../Include/RmlUi/Core/ConvolutionFilter.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include "Memory.h"
 #include <float.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define RMLUI_CONVOLUTION_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define RMLUI_CONVOLUTION_NEON
+	#include <arm_neon.h>
+#endif
+
 namespace Rml {
 
+// Flat spans of the dilation kernel at least this long are dilated with a sliding window maximum, shorter ones directly.
+static constexpr int sliding_max_min_length = 6;
+
+// Accumulates the weighted row into the sum, for each element: sum[i] += row[i] * weight.
+static void AccumulateSum(float* sum, const float* row, const float weight, const int count)
+{
+	int i = 0;
+#if defined(RMLUI_CONVOLUTION_SSE2)
+	const __m128 weight4 = _mm_set1_ps(weight);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(sum + i, _mm_add_ps(_mm_loadu_ps(sum + i), _mm_mul_ps(_mm_loadu_ps(row + i), weight4)));
+#elif defined(RMLUI_CONVOLUTION_NEON)
+	const float32x4_t weight4 = vdupq_n_f32(weight);
+	for (; i + 4 <= count; i += 4)
+		vst1q_f32(sum + i, vaddq_f32(vld1q_f32(sum + i), vmulq_f32(vld1q_f32(row + i), weight4)));
+#endif
+	for (; i < count; i++)
+		sum[i] += row[i] * weight;
+}
+
+// Accumulates the weighted row into the maximum, for each element: max[i] = Max(max[i], row[i] * weight).
+static void AccumulateMax(float* max, const float* row, const float weight, const int count)
+{
+	int i = 0;
+#if defined(RMLUI_CONVOLUTION_SSE2)
+	const __m128 weight4 = _mm_set1_ps(weight);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(max + i, _mm_max_ps(_mm_loadu_ps(max + i), _mm_mul_ps(_mm_loadu_ps(row + i), weight4)));
+#elif defined(RMLUI_CONVOLUTION_NEON)
+	const float32x4_t weight4 = vdupq_n_f32(weight);
+	for (; i + 4 <= count; i += 4)
+		vst1q_f32(max + i, vmaxq_f32(vld1q_f32(max + i), vmulq_f32(vld1q_f32(row + i), weight4)));
+#endif
+	for (; i < count; i++)
+		max[i] = Math::Max(max[i], row[i] * weight);
+}
+
+// Accumulates the maximum of each window of the given length along the row, for each element:
+//   max[i] = Max(max[i], row[i], row[i + 1], ..., row[i + length - 1]).
+// Uses the van Herk/Gil-Werman algorithm, which needs a constant number of comparisons per element regardless of the window length. The
+// row is split into blocks of the window length, then each window is covered by the suffix of one block and the prefix of the next.
+static void AccumulateSlidingMax(float* max, const float* row, const int count, const int length, float* prefix, float* suffix)
+{
+	const int row_size = count + length - 1;
+
+	for (int block_begin = 0; block_begin < row_size; block_begin += length)
+	{
+		const int block_end = Math::Min(block_begin + length, row_size);
+
+		prefix[block_begin] = row[block_begin];
+		for (int i = block_begin + 1; i < block_end; i++)
+			prefix[i] = Math::Max(prefix[i - 1], row[i]);
+
+		suffix[block_end - 1] = row[block_end - 1];
+		for (int i = block_end - 2; i >= block_begin; i--)
+			suffix[i] = Math::Max(suffix[i + 1], row[i]);
+	}
+
+	AccumulateMax(max, suffix, 1.f, count);
+	AccumulateMax(max, prefix + length - 1, 1.f, count);
+}
+
 ConvolutionFilter::ConvolutionFilter() {}
 
 ConvolutionFilter::~ConvolutionFilter() {}
@@ -73,6 +144,9 @@ void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimens
 {
 	RMLUI_ZoneScopedNC("ConvFilter::Run", 0xd6bf49);
 
+	if (destination_dimensions.x <= 0 || destination_dimensions.y <= 0)
+		return;
+
 	const int destination_bytes_per_pixel = (destination_color_format == ColorFormat::RGBA8 ? 4 : 1);
 	const int destination_alpha_offset = (destination_color_format == ColorFormat::RGBA8 ? 3 : 0);
 	const int source_bytes_per_pixel = (source_color_format == ColorFormat::RGBA8 ? 4 : 1);
@@ -80,37 +154,88 @@ void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimens
 
 	const Vector2i kernel_radius = (kernel_size - Vector2i(1)) / 2;
 
+	// Gather the source opacity into a plane where the kernel applied at any position is aligned with the corresponding destination pixel.
+	// Pixels outside the source are set to zero, which is equivalent to skipping them for both operations, thereby the kernel can be applied
+	// to whole rows of the plane at a time.
+	const Vector2i plane_dimensions = destination_dimensions + kernel_size - Vector2i(1);
+	const Vector2i plane_origin = -source_offset - kernel_radius;
+	const int row_size = plane_dimensions.x;
+
+	DynamicArray<float, GlobalStackAllocator<float>> plane(size_t(plane_dimensions.x) * size_t(plane_dimensions.y));
+	for (int y = 0; y < plane_dimensions.y; y++)
+	{
+		float* plane_row = plane.data() + y * row_size;
+		const int source_y = plane_origin.y + y;
+
+		for (int x = 0; x < plane_dimensions.x; x++)
+		{
+			const int source_x = plane_origin.x + x;
+			if (source_y >= 0 && source_y < source_dimensions.y && source_x >= 0 && source_x < source_dimensions.x)
+				plane_row[x] = float(source[(source_y * source_dimensions.x + source_x) * source_bytes_per_pixel + source_alpha_offset]);
+			else
+				plane_row[x] = 0.f;
+		}
+	}
+
+	DynamicArray<float, GlobalStackAllocator<float>> result((size_t)destination_dimensions.x);
+	DynamicArray<float, GlobalStackAllocator<float>> prefix((size_t)row_size);
+	DynamicArray<float, GlobalStackAllocator<float>> suffix((size_t)row_size);
+
 	for (int y = 0; y < destination_dimensions.y; ++y)
 	{
 		for (int x = 0; x < destination_dimensions.x; ++x)
+			result[x] = 0.f;
+
+		for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
 		{
-			float opacity = 0.f;
+			const float* kernel_row = kernel.get() + kernel_y * kernel_size.x;
+			const float* plane_row = plane.data() + (y + kernel_y) * row_size;
 
-			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			switch (operation)
 			{
-				const int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
-
+			case FilterOperation::Sum:
+			{
+				// The weights are accumulated in kernel order for each pixel, and zero weights skipped, thus giving the same sum as
+				// visiting each kernel position in turn.
 				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
 				{
-					const int source_x = x - source_offset.x - kernel_radius.x + kernel_x;
-					if (source_y >= 0 && source_y < source_dimensions.y && source_x >= 0 && source_x < source_dimensions.x)
+					if (kernel_row[kernel_x] != 0.f)
+						AccumulateSum(result.data(), plane_row + kernel_x, kernel_row[kernel_x], destination_dimensions.x);
+				}
+			}
+			break;
+			case FilterOperation::Dilation:
+			{
+				// Spans of unit weights are flat, their maximum can be found with a sliding window. Other weights are applied directly.
+				int kernel_x = 0;
+				while (kernel_x < kernel_size.x)
+				{
+					int span_end = kernel_x;
+					while (span_end < kernel_size.x && kernel_row[span_end] == 1.f)
+						span_end += 1;
+
+					const int span_length = span_end - kernel_x;
+					if (span_length >= sliding_max_min_length)
 					{
-						const int source_index = (source_y * source_dimensions.x + source_x) * source_bytes_per_pixel + source_alpha_offset;
-						const float pixel_opacity = float(source[source_index]) * kernel[kernel_y * kernel_size.x + kernel_x];
-
-						switch (operation)
-						{
-						case FilterOperation::Sum: opacity += pixel_opacity; break;
-						case FilterOperation::Dilation: opacity = Math::Max(opacity, pixel_opacity); break;
-						}
+						AccumulateSlidingMax(result.data(), plane_row + kernel_x, destination_dimensions.x, span_length, prefix.data(),
+							suffix.data());
+						kernel_x = span_end;
+						continue;
 					}
+
+					if (kernel_row[kernel_x] > 0.f)
+						AccumulateMax(result.data(), plane_row + kernel_x, kernel_row[kernel_x], destination_dimensions.x);
+					kernel_x += 1;
 				}
 			}
+			break;
+			}
+		}
 
-			opacity = Math::Min(255.f, opacity);
-
-			const int destination_index = x * destination_bytes_per_pixel + destination_alpha_offset;
-			destination[destination_index] = byte(opacity);
+		for (int x = 0; x < destination_dimensions.x; ++x)
+		{
+			const float opacity = Math::Clamp(result[x], 0.f, 255.f);
+			destination[x * destination_bytes_per_pixel + destination_alpha_offset] = byte(opacity);
 		}
 
 		destination += destination_stride;
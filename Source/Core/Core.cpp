@@ -48,6 +48,7 @@
 
 #ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
 	#include "FontEngineDefault/FontEngineInterfaceDefault.h"
+	#include "FontEngineDefault/FontProvider.h"
 #endif
 
 #ifdef RMLUI_ENABLE_LOTTIE_PLUGIN
@@ -175,6 +176,7 @@ void Shutdown()
 	default_font_interface.reset();
 
 	TextureDatabase::Shutdown();
+	GeometryDatabase::Shutdown();
 
 	initialised = false;
 
@@ -355,6 +357,57 @@ void ReleaseTextures()
 	TextureDatabase::ReleaseTextures();
 }
 
+void SetTextureAtlasMaxImageSize(int size)
+{
+	TextureDatabase::SetAtlasMaxImageSize(size);
+}
+
+void SetFontDistanceFieldSize(int reference_size)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	FontProvider::SetDistanceFieldSize(reference_size);
+#else
+	(void)reference_size;
+#endif
+}
+
+void SetFontEffectThreads(int num_threads)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	FontProvider::SetNumEffectThreads(num_threads);
+#else
+	(void)num_threads;
+#endif
+}
+
+void SetFontCacheDirectory(const String& directory, size_t max_bytes)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	FontProvider::SetCacheDirectory(directory, max_bytes);
+#else
+	(void)directory;
+	(void)max_bytes;
+#endif
+}
+
+void SetFontMemoryBudget(size_t max_bytes)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	FontProvider::SetMemoryBudget(max_bytes);
+#else
+	(void)max_bytes;
+#endif
+}
+
+FontHandleStatistics GetFontHandleStatistics()
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	if (font_interface && font_interface == default_font_interface.get())
+		return FontProvider::GetHandleStatistics();
+#endif
+	return FontHandleStatistics();
+}
+
 void ReleaseCompiledGeometry()
 {
 	return GeometryDatabase::ReleaseAll();
@@ -0,0 +1,119 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "DecoratorDataCache.h"
+#include "GeometryDatabase.h"
+
+namespace Rml {
+
+DecoratorDataCache::DecoratorDataCache() {}
+
+DecoratorDataCache::~DecoratorDataCache() {}
+
+DecoratorDataHandle DecoratorDataCache::Find(const Key& key)
+{
+	if (!IsSharingEnabled())
+		return {};
+
+	auto it = data_map.find(key);
+	if (it == data_map.end())
+		return {};
+
+	Data* data = it->second.get();
+	data->num_references += 1;
+	return reinterpret_cast<DecoratorDataHandle>(data);
+}
+
+DecoratorDataCache::Data* DecoratorDataCache::Create(const Key& key, int num_geometries)
+{
+	RMLUI_ASSERT(data_map.find(key) == data_map.end());
+
+	UniquePtr<Data> data;
+	if (!unused.empty())
+	{
+		data = std::move(unused.back());
+		unused.pop_back();
+	}
+	else
+	{
+		data = MakeUnique<Data>();
+	}
+
+	data->key = key;
+	data->num_references = 1;
+	data->shared = IsSharingEnabled();
+	data->geometry.resize(num_geometries);
+
+	Data* result = data.get();
+	if (result->shared)
+		data_map.emplace(key, std::move(data));
+	else
+		unshared_data.emplace(result, std::move(data));
+	return result;
+}
+
+void DecoratorDataCache::Release(DecoratorDataHandle handle)
+{
+	Data* data = Get(handle);
+	RMLUI_ASSERT(data && data->num_references > 0);
+
+	data->num_references -= 1;
+	if (data->num_references > 0)
+		return;
+
+	UniquePtr<Data> released_data;
+	if (data->shared)
+	{
+		auto it = data_map.find(data->key);
+		RMLUI_ASSERT(it != data_map.end() && it->second.get() == data);
+		released_data = std::move(it->second);
+		data_map.erase(it);
+	}
+	else
+	{
+		auto it = unshared_data.find(data);
+		RMLUI_ASSERT(it != unshared_data.end());
+		released_data = std::move(it->second);
+		unshared_data.erase(it);
+	}
+
+	if (unused.size() < max_num_unused)
+	{
+		// Release the compiled geometry, but keep the allocated buffers around to generate the next data into.
+		for (Geometry& geometry : released_data->geometry)
+			geometry.Release(true);
+		unused.push_back(std::move(released_data));
+	}
+}
+
+bool DecoratorDataCache::IsSharingEnabled()
+{
+	return GeometryDatabase::IsColourModulationSupported();
+}
+
+} // namespace Rml
@@ -0,0 +1,126 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_DECORATORDATACACHE_H
+#define RMLUI_CORE_DECORATORDATACACHE_H
+
+#include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+
+namespace Rml {
+
+// The element properties that the data of a decorator depends on, in addition to the decorator itself.
+struct DecoratorDataKey {
+	Vector2f size;
+	float dp_ratio = 1.f;
+	Colourb colour;
+	// Additional values used by some decorators, such as the resolved edge lengths of a nine-patch.
+	Array<float, 4> values = {};
+
+	bool operator==(const DecoratorDataKey& other) const
+	{
+		return size == other.size && dp_ratio == other.dp_ratio && colour == other.colour && values == other.values;
+	}
+};
+
+} // namespace Rml
+
+namespace std {
+// Hash specialization for the decorator data key, so it can be used as key in UnorderedMap.
+template <>
+struct hash<::Rml::DecoratorDataKey> {
+	std::size_t operator()(const ::Rml::DecoratorDataKey& key) const noexcept
+	{
+		const ::Rml::Colourb colour = key.colour;
+		const uint32_t colour_value =
+			(uint32_t(colour.red) << 24) | (uint32_t(colour.green) << 16) | (uint32_t(colour.blue) << 8) | uint32_t(colour.alpha);
+
+		std::size_t seed = 0;
+		::Rml::Utilities::HashCombine(seed, key.size.x);
+		::Rml::Utilities::HashCombine(seed, key.size.y);
+		::Rml::Utilities::HashCombine(seed, key.dp_ratio);
+		::Rml::Utilities::HashCombine(seed, colour_value);
+		for (float value : key.values)
+			::Rml::Utilities::HashCombine(seed, value);
+		return seed;
+	}
+};
+} // namespace std
+
+namespace Rml {
+
+/**
+    Shares the element data of a decorator between all the elements it generates identical data for, such as equally sized buttons.
+
+    The data is identified by the element properties it depends on, and reference counted by the elements using it. Data which is no
+    longer in use is kept for a little while, so that its buffers can be reused for the next data generated, such as when an element is
+    resized.
+
+    When the render interface doesn't support colour modulation, the opacity of each element is applied to the vertex colours of its
+    geometry. Then the data is not shared, as elements of different opacity would otherwise alter the same geometry back and forth.
+ */
+
+class DecoratorDataCache {
+public:
+	using Key = DecoratorDataKey;
+
+	struct Data {
+		Key key;
+		int num_references = 0;
+		bool shared = true;
+		Vector<Geometry> geometry;
+	};
+
+	DecoratorDataCache();
+	~DecoratorDataCache();
+
+	/// Returns the data previously created for the given key with an added reference, or zero if there is none or sharing is disabled.
+	DecoratorDataHandle Find(const Key& key);
+	/// Creates data for the given key with a single reference, with the given number of empty geometries to be generated by the caller.
+	/// The data is only shared with later elements of the same key when sharing is enabled.
+	Data* Create(const Key& key, int num_geometries);
+	/// Removes a reference to the data, it is released when no longer referenced by any element.
+	void Release(DecoratorDataHandle handle);
+
+	static Data* Get(DecoratorDataHandle handle) { return reinterpret_cast<Data*>(handle); }
+
+private:
+	// The maximum number of unreferenced data kept for reuse.
+	static constexpr size_t max_num_unused = 8;
+
+	// Returns true if the render interface applies the opacity of each element, so that its geometry can be shared.
+	static bool IsSharingEnabled();
+
+	UnorderedMap<Key, UniquePtr<Data>> data_map;
+	UnorderedMap<Data*, UniquePtr<Data>> unshared_data;
+	Vector<UniquePtr<Data>> unused;
+};
+
+} // namespace Rml
+#endif
@@ -65,7 +65,6 @@ DecoratorDataHandle DecoratorGradient::GenerateElementData(Element* element) con
 	const Box& box = element->GetBox();
 
 	const ComputedValues& computed = element->GetComputedValues();
-	const float opacity = computed.opacity();
 
 	const Vector4f border_radius{
 		computed.border_top_left_radius(),
@@ -75,11 +74,8 @@ DecoratorDataHandle DecoratorGradient::GenerateElementData(Element* element) con
 	};
 	GeometryUtilities::GenerateBackgroundBorder(geometry, element->GetBox(), Vector2f(0), border_radius, Colourb());
 
-	// Apply opacity
-	Colourb colour_start = start;
-	colour_start.alpha = (byte)(opacity * (float)colour_start.alpha);
-	Colourb colour_stop = stop;
-	colour_stop.alpha = (byte)(opacity * (float)colour_stop.alpha);
+	const Colourb colour_start = start;
+	const Colourb colour_stop = stop;
 
 	const Vector2f padding_offset = box.GetPosition(BoxArea::Padding);
 	const Vector2f padding_size = box.GetSize(BoxArea::Padding);
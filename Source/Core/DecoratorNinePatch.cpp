@@ -58,18 +58,12 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 {
 	const auto& computed = element->GetComputedValues();
 
-	Geometry* data = new Geometry();
-
 	const Texture* texture = GetTexture();
-	data->SetTexture(texture);
 	const Vector2f texture_dimensions(texture->GetDimensions());
 
 	const Vector2f surface_dimensions = element->GetBox().GetSize(BoxArea::Padding).Round();
 
-	const float opacity = computed.opacity();
-	Colourb quad_colour = computed.image_color();
-
-	quad_colour.alpha = (byte)(opacity * (float)quad_colour.alpha);
+	const Colourb quad_colour = computed.image_color();
 
 	/* In the following, we operate on the four diagonal vertices in the grid, as they define the whole grid. */
 
@@ -88,7 +82,8 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 
 	// Natural size is determined from the raw pixel size multiplied by the dp-ratio and the sprite's
 	// display scale (determined by eg. the inverse of spritesheet's 'src-scale').
-	const float scale_raw_to_natural_dimensions = ElementUtilities::GetDensityIndependentPixelRatio(element) * display_scale;
+	const float dp_ratio = ElementUtilities::GetDensityIndependentPixelRatio(element);
+	const float scale_raw_to_natural_dimensions = dp_ratio * display_scale;
 
 	// Surface position in pixels [0, surface_dimensions]
 	// Need to keep the corner patches at their natural size, but stretch the inner patches.
@@ -99,9 +94,9 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 	surface_pos[3] = surface_dimensions;
 
 	// Change the size of the edges if specified.
+	Array<float, 4> lengths = {}; // top, right, bottom, left
 	if (edges)
 	{
-		float lengths[4]; // top, right, bottom, left
 		lengths[0] = element->ResolveNumericValue((*edges)[0], (surface_pos[1].y - surface_pos[0].y));
 		lengths[1] = element->ResolveNumericValue((*edges)[1], (surface_pos[3].x - surface_pos[2].x));
 		lengths[2] = element->ResolveNumericValue((*edges)[2], (surface_pos[3].y - surface_pos[2].y));
@@ -113,6 +108,20 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 		surface_pos[1].x = lengths[3];
 	}
 
+	// The edge lengths may depend on other properties of the element, such as its font size, so their resolved values identify the data
+	// together with the surface size.
+	DecoratorDataCache::Key key;
+	key.size = surface_dimensions;
+	key.dp_ratio = dp_ratio;
+	key.colour = quad_colour;
+	key.values = lengths;
+	if (DecoratorDataHandle handle = data_cache.Find(key))
+		return handle;
+
+	DecoratorDataCache::Data* data = data_cache.Create(key, 1);
+	Geometry& geometry = data->geometry[0];
+	geometry.SetTexture(texture);
+
 	// In case the surface dimensions are less than the size of the corners, we need to scale down the corner rectangles, one dimension at a time.
 	const Vector2f surface_center_size = surface_pos[2] - surface_pos[1];
 	for (int i = 0; i < 2; i++)
@@ -132,8 +141,8 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 
 	/* Now we have all the coordinates we need. Expand the diagonal vertices to the 16 individual vertices. */
 
-	Vector<Vertex>& vertices = data->GetVertices();
-	Vector<int>& indices = data->GetIndices();
+	Vector<Vertex>& vertices = geometry.GetVertices();
+	Vector<int>& indices = geometry.GetIndices();
 
 	vertices.resize(4 * 4);
 
@@ -170,13 +179,13 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 
 void DecoratorNinePatch::ReleaseElementData(DecoratorDataHandle element_data) const
 {
-	delete reinterpret_cast<Geometry*>(element_data);
+	data_cache.Release(element_data);
 }
 
 void DecoratorNinePatch::RenderElement(Element* element, DecoratorDataHandle element_data) const
 {
-	Geometry* data = reinterpret_cast<Geometry*>(element_data);
-	data->Render(element->GetAbsoluteOffset(BoxArea::Padding));
+	DecoratorDataCache::Data* data = DecoratorDataCache::Get(element_data);
+	data->geometry[0].Render(element->GetAbsoluteOffset(BoxArea::Padding));
 }
 
 DecoratorNinePatchInstancer::DecoratorNinePatchInstancer()
@@ -33,6 +33,7 @@
 #include "../../Include/RmlUi/Core/DecoratorInstancer.h"
 #include "../../Include/RmlUi/Core/ID.h"
 #include "../../Include/RmlUi/Core/Spritesheet.h"
+#include "DecoratorDataCache.h"
 
 namespace Rml {
 
@@ -53,6 +54,8 @@ private:
 	Rectanglef rect_outer, rect_inner;
 	float display_scale = 1;
 	UniquePtr<Array<NumericValue, 4>> edges;
+
+	mutable DecoratorDataCache data_cache;
 };
 
 class DecoratorNinePatchInstancer : public DecoratorInstancer {
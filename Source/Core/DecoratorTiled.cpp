@@ -102,11 +102,7 @@ void DecoratorTiled::Tile::GenerateGeometry(Vector<Vertex>& vertices, Vector<int
 	if (surface_dimensions.x <= 0 || surface_dimensions.y <= 0)
 		return;
 
-	float opacity = computed.opacity();
-	Colourb quad_colour = computed.image_color();
-
-	// Apply opacity
-	quad_colour.alpha = (byte)(opacity * (float)quad_colour.alpha);
+	const Colourb quad_colour = computed.image_color();
 
 	if (!tile_data_calculated)
 		return;
@@ -234,4 +230,13 @@ void DecoratorTiled::ScaleTileDimensions(Vector2f& tile_dimensions, float axis_v
 	}
 }
 
+DecoratorDataCache::Key DecoratorTiled::GetElementDataKey(Element* element)
+{
+	DecoratorDataCache::Key key;
+	key.size = element->GetBox().GetSize(BoxArea::Padding);
+	key.dp_ratio = ElementUtilities::GetDensityIndependentPixelRatio(element);
+	key.colour = element->GetComputedValues().image_color();
+	return key;
+}
+
 } // namespace Rml
@@ -32,6 +32,7 @@
 #include "../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../Include/RmlUi/Core/Decorator.h"
 #include "../../Include/RmlUi/Core/Vertex.h"
+#include "DecoratorDataCache.h"
 
 namespace Rml {
 
@@ -124,6 +125,11 @@ protected:
 	/// @param axis_value[in] The fixed value to scale against.
 	/// @param axis[in] The axis to scale against.
 	void ScaleTileDimensions(Vector2f& tile_dimensions, float axis_value, Axis axis) const;
+
+	/// Returns the properties of the element that the generated tiles depend on, elements with equal keys share their element data.
+	static DecoratorDataCache::Key GetElementDataKey(Element* element);
+
+	mutable DecoratorDataCache data_cache;
 };
 
 } // namespace Rml
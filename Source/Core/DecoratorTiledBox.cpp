@@ -32,15 +32,6 @@
 
 namespace Rml {
 
-struct DecoratorTiledBoxData {
-	DecoratorTiledBoxData(int num_textures) : num_textures(num_textures) { geometry = new Geometry[num_textures]; }
-
-	~DecoratorTiledBoxData() { delete[] geometry; }
-
-	const int num_textures;
-	Geometry* geometry;
-};
-
 DecoratorTiledBox::DecoratorTiledBox() {}
 
 DecoratorTiledBox::~DecoratorTiledBox() {}
@@ -97,6 +88,11 @@ bool DecoratorTiledBox::Initialise(const Tile* _tiles, const Texture* _textures)
 
 DecoratorDataHandle DecoratorTiledBox::GenerateElementData(Element* element) const
 {
+	// Reuse the data generated for any other element with the same size.
+	const DecoratorDataCache::Key key = GetElementDataKey(element);
+	if (DecoratorDataHandle handle = data_cache.Find(key))
+		return handle;
+
 	// Initialise the tiles for this element.
 	for (int i = 0; i < 9; i++)
 	{
@@ -104,7 +100,7 @@ DecoratorDataHandle DecoratorTiledBox::GenerateElementData(Element* element) con
 		tiles[i].CalculateDimensions(*GetTexture(tiles[i].texture_index));
 	}
 
-	Vector2f padded_size = element->GetBox().GetSize(BoxArea::Padding);
+	const Vector2f padded_size = key.size;
 
 	// Calculate the natural dimensions of tile corners and edges.
 	const Vector2f natural_top_left = tiles[TOP_LEFT_CORNER].GetNaturalDimensions(element);
@@ -191,7 +187,7 @@ DecoratorDataHandle DecoratorTiledBox::GenerateElementData(Element* element) con
 	}
 
 	const int num_textures = GetNumTextures();
-	DecoratorTiledBoxData* data = new DecoratorTiledBoxData(num_textures);
+	DecoratorDataCache::Data* data = data_cache.Create(key, num_textures);
 	const ComputedValues& computed = element->GetComputedValues();
 
 	// Generate the geometry for the top-left tile.
@@ -246,16 +242,16 @@ DecoratorDataHandle DecoratorTiledBox::GenerateElementData(Element* element) con
 
 void DecoratorTiledBox::ReleaseElementData(DecoratorDataHandle element_data) const
 {
-	delete reinterpret_cast<DecoratorTiledBoxData*>(element_data);
+	data_cache.Release(element_data);
 }
 
 void DecoratorTiledBox::RenderElement(Element* element, DecoratorDataHandle element_data) const
 {
 	Vector2f translation = element->GetAbsoluteOffset(BoxArea::Padding).Round();
-	DecoratorTiledBoxData* data = reinterpret_cast<DecoratorTiledBoxData*>(element_data);
+	DecoratorDataCache::Data* data = DecoratorDataCache::Get(element_data);
 
-	for (int i = 0; i < data->num_textures; i++)
-		data->geometry[i].Render(translation);
+	for (Geometry& geometry : data->geometry)
+		geometry.Render(translation);
 }
 
 } // namespace Rml
@@ -33,15 +33,6 @@
 
 namespace Rml {
 
-struct DecoratorTiledHorizontalData {
-	DecoratorTiledHorizontalData(int num_textures) : num_textures(num_textures) { geometry = new Geometry[num_textures]; }
-
-	~DecoratorTiledHorizontalData() { delete[] geometry; }
-
-	const int num_textures;
-	Geometry* geometry;
-};
-
 DecoratorTiledHorizontal::DecoratorTiledHorizontal() {}
 
 DecoratorTiledHorizontal::~DecoratorTiledHorizontal() {}
@@ -77,14 +68,19 @@ bool DecoratorTiledHorizontal::Initialise(const Tile* _tiles, const Texture* _te
 
 DecoratorDataHandle DecoratorTiledHorizontal::GenerateElementData(Element* element) const
 {
+	// Elements of equal size share their data.
+	const DecoratorDataCache::Key key = GetElementDataKey(element);
+	if (DecoratorDataHandle handle = data_cache.Find(key))
+		return handle;
+
 	// Initialise the tiles for this element.
 	for (int i = 0; i < 3; i++)
 		tiles[i].CalculateDimensions(*GetTexture(tiles[i].texture_index));
 
 	const int num_textures = GetNumTextures();
-	DecoratorTiledHorizontalData* data = new DecoratorTiledHorizontalData(num_textures);
+	DecoratorDataCache::Data* data = data_cache.Create(key, num_textures);
 
-	Vector2f padded_size = element->GetBox().GetSize(BoxArea::Padding);
+	const Vector2f padded_size = key.size;
 
 	Vector2f left_dimensions = tiles[LEFT].GetNaturalDimensions(element);
 	Vector2f right_dimensions = tiles[RIGHT].GetNaturalDimensions(element);
@@ -131,16 +127,16 @@ DecoratorDataHandle DecoratorTiledHorizontal::GenerateElementData(Element* eleme
 
 void DecoratorTiledHorizontal::ReleaseElementData(DecoratorDataHandle element_data) const
 {
-	delete reinterpret_cast<DecoratorTiledHorizontalData*>(element_data);
+	data_cache.Release(element_data);
 }
 
 void DecoratorTiledHorizontal::RenderElement(Element* element, DecoratorDataHandle element_data) const
 {
 	Vector2f translation = element->GetAbsoluteOffset(BoxArea::Padding).Round();
-	DecoratorTiledHorizontalData* data = reinterpret_cast<DecoratorTiledHorizontalData*>(element_data);
+	DecoratorDataCache::Data* data = DecoratorDataCache::Get(element_data);
 
-	for (int i = 0; i < data->num_textures; i++)
-		data->geometry[i].Render(translation);
+	for (Geometry& geometry : data->geometry)
+		geometry.Render(translation);
 }
 
 } // namespace Rml
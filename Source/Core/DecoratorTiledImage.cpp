@@ -46,30 +46,34 @@ bool DecoratorTiledImage::Initialise(const Tile& _tile, const Texture& _texture)
 
 DecoratorDataHandle DecoratorTiledImage::GenerateElementData(Element* element) const
 {
+	const DecoratorDataCache::Key key = GetElementDataKey(element);
+	if (DecoratorDataHandle handle = data_cache.Find(key))
+		return handle;
+
 	// Calculate the tile's dimensions for this element.
 	tile.CalculateDimensions(*GetTexture(tile.texture_index));
 
-	Geometry* data = new Geometry();
-	data->SetTexture(GetTexture());
+	DecoratorDataCache::Data* data = data_cache.Create(key, 1);
+	Geometry& geometry = data->geometry[0];
+	geometry.SetTexture(GetTexture());
 
 	const ComputedValues& computed = element->GetComputedValues();
 
 	// Generate the geometry for the tile.
-	tile.GenerateGeometry(data->GetVertices(), data->GetIndices(), computed, Vector2f(0, 0), element->GetBox().GetSize(BoxArea::Padding),
-		tile.GetNaturalDimensions(element));
+	tile.GenerateGeometry(geometry.GetVertices(), geometry.GetIndices(), computed, Vector2f(0, 0), key.size, tile.GetNaturalDimensions(element));
 
 	return reinterpret_cast<DecoratorDataHandle>(data);
 }
 
 void DecoratorTiledImage::ReleaseElementData(DecoratorDataHandle element_data) const
 {
-	delete reinterpret_cast<Geometry*>(element_data);
+	data_cache.Release(element_data);
 }
 
 void DecoratorTiledImage::RenderElement(Element* element, DecoratorDataHandle element_data) const
 {
-	Geometry* data = reinterpret_cast<Geometry*>(element_data);
-	data->Render(element->GetAbsoluteOffset(BoxArea::Padding).Round());
+	DecoratorDataCache::Data* data = DecoratorDataCache::Get(element_data);
+	data->geometry[0].Render(element->GetAbsoluteOffset(BoxArea::Padding).Round());
 }
 
 } // namespace Rml
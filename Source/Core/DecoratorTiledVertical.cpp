@@ -34,15 +34,6 @@
 
 namespace Rml {
 
-struct DecoratorTiledVerticalData {
-	DecoratorTiledVerticalData(int num_textures) : num_textures(num_textures) { geometry = new Geometry[num_textures]; }
-
-	~DecoratorTiledVerticalData() { delete[] geometry; }
-
-	const int num_textures;
-	Geometry* geometry;
-};
-
 DecoratorTiledVertical::DecoratorTiledVertical() {}
 
 DecoratorTiledVertical::~DecoratorTiledVertical() {}
@@ -78,14 +69,19 @@ bool DecoratorTiledVertical::Initialise(const Tile* _tiles, const Texture* _text
 
 DecoratorDataHandle DecoratorTiledVertical::GenerateElementData(Element* element) const
 {
+	// Elements of equal size share their data.
+	const DecoratorDataCache::Key key = GetElementDataKey(element);
+	if (DecoratorDataHandle handle = data_cache.Find(key))
+		return handle;
+
 	// Initialise the tile for this element.
 	for (int i = 0; i < 3; i++)
 		tiles[i].CalculateDimensions(*GetTexture(tiles[i].texture_index));
 
 	const int num_textures = GetNumTextures();
-	DecoratorTiledVerticalData* data = new DecoratorTiledVerticalData(num_textures);
+	DecoratorDataCache::Data* data = data_cache.Create(key, num_textures);
 
-	Vector2f padded_size = element->GetBox().GetSize(BoxArea::Padding);
+	const Vector2f padded_size = key.size;
 
 	Vector2f top_dimensions = tiles[TOP].GetNaturalDimensions(element);
 	Vector2f bottom_dimensions = tiles[BOTTOM].GetNaturalDimensions(element);
@@ -133,16 +129,16 @@ DecoratorDataHandle DecoratorTiledVertical::GenerateElementData(Element* element
 
 void DecoratorTiledVertical::ReleaseElementData(DecoratorDataHandle element_data) const
 {
-	delete reinterpret_cast<DecoratorTiledVerticalData*>(element_data);
+	data_cache.Release(element_data);
 }
 
 void DecoratorTiledVertical::RenderElement(Element* element, DecoratorDataHandle element_data) const
 {
 	Vector2f translation = element->GetAbsoluteOffset(BoxArea::Padding).Round();
-	DecoratorTiledVerticalData* data = reinterpret_cast<DecoratorTiledVerticalData*>(element_data);
+	DecoratorDataCache::Data* data = DecoratorDataCache::Get(element_data);
 
-	for (int i = 0; i < data->num_textures; i++)
-		data->geometry[i].Render(translation);
+	for (Geometry& geometry : data->geometry)
+		geometry.Render(translation);
 }
 
 } // namespace Rml
@@ -35,6 +35,7 @@
 #include "../../Include/RmlUi/Core/ElementScroll.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/FontEngineInterface.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/PropertiesIteratorView.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
@@ -52,6 +53,7 @@
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
 #include "EventSpecification.h"
+#include "GeometryDatabase.h"
 #include "Layout/LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "Pool.h"
@@ -63,6 +65,7 @@
 #include "XMLParseTools.h"
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 
 namespace Rml {
 
@@ -90,6 +93,54 @@ static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset,
 	return 0.f;
 }
 
+// Returns true if the element clips its overflowing contents, following the same rules as ElementUtilities::GetClippingRegion().
+static bool IsClippingOverflow(Element* element)
+{
+	const ComputedValues& computed = element->GetComputedValues();
+	if (computed.clip() == Style::Clip::Type::Always)
+		return true;
+
+	const bool clip_enabled = (computed.overflow_x() != Style::Overflow::Visible || computed.overflow_y() != Style::Overflow::Visible);
+	return clip_enabled &&
+		(element->GetClientWidth() < element->GetScrollWidth() - 0.5f || element->GetClientHeight() < element->GetScrollHeight() - 0.5f);
+}
+
+// Moves the reference of an element from its previous font face handle to its new one, so that the font engine knows which handles are in use.
+static void ChangeFontFaceHandleReference(FontFaceHandle old_handle, FontFaceHandle new_handle)
+{
+	if (old_handle == new_handle)
+		return;
+
+	// Elements may outlive the font engine, such as when they are held by the application during shutdown.
+	FontEngineInterface* font_engine_interface = GetFontEngineInterface();
+	if (!font_engine_interface)
+		return;
+
+	if (old_handle)
+		font_engine_interface->RemoveFontFaceHandleReference(old_handle);
+	if (new_handle)
+		font_engine_interface->AddFontFaceHandleReference(new_handle);
+}
+
+enum class RenderOrder {
+	StackNegative, // Local stacking context with z < 0.
+	Block,
+	TableColumnGroup,
+	TableColumn,
+	TableRowGroup,
+	TableRow,
+	TableCell,
+	Floating,
+	Inline,
+	Positioned,    // Positioned element, or local stacking context with z == 0.
+	StackPositive, // Local stacking context with z > 0.
+};
+struct StackingContextChild {
+	Element* element = nullptr;
+	RenderOrder order = {};
+	int index = 0; // Position in tree order, after any atomic ranges are sorted. Breaks ties in the render order.
+};
+
 // Meta objects for element collected in a single struct to reduce memory allocations
 struct ElementMeta {
 	ElementMeta(Element* el) : event_dispatcher(el), style(el), background_border(), decoration(el), scroll(el), computed_values(el) {}
@@ -100,15 +151,20 @@ struct ElementMeta {
 	ElementDecoration decoration;
 	ElementScroll scroll;
 	Style::ComputedValues computed_values;
+
+	// The render order of our local stacking context, and any children queued for insertion into it.
+	Vector<StackingContextChild> stacking_children;
+	ElementList stacking_context_insertions;
 };
 
 static Pool<ElementMeta> element_meta_chunk_pool(200, true);
 
 Element::Element(const String& tag) :
-	local_stacking_context(false), local_stacking_context_forced(false), stacking_context_dirty(false), computed_values_are_default_initialized(true),
-	visible(true), offset_fixed(false), absolute_offset_dirty(true), dirty_definition(false), dirty_child_definitions(false), dirty_animation(false),
-	dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag), relative_offset_base(0, 0), relative_offset_position(0, 0),
-	absolute_offset(0, 0), scroll_offset(0, 0)
+	local_stacking_context(false), local_stacking_context_forced(false), stacking_context_dirty(false), stacking_context_clip_contained(false),
+	stacking_context_insertion_pending(false), computed_values_are_default_initialized(true), visible(true), offset_fixed(false),
+	absolute_offset_dirty(true), dirty_definition(false), dirty_child_definitions(false), dirty_animation(false), dirty_transition(false),
+	dirty_transform(false), dirty_perspective(false), tag(tag), relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0),
+	scroll_offset(0, 0)
 {
 	RMLUI_ASSERT(tag == StringUtilities::ToLower(tag));
 	parent = nullptr;
@@ -148,6 +204,7 @@ Element::~Element()
 	children.clear();
 	num_non_dom_children = 0;
 
+	ChangeFontFaceHandleReference(meta->computed_values.font_face_handle(), 0);
 	element_meta_chunk_pool.DestroyAndDeallocate(meta);
 }
 
@@ -197,12 +254,14 @@ void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimension
 	{
 		const ComputedValues* parent_values = parent ? &parent->GetComputedValues() : nullptr;
 		const ComputedValues* document_values = owner_document ? &owner_document->GetComputedValues() : nullptr;
+		const FontFaceHandle font_face_handle_before = meta->computed_values.font_face_handle();
 
 		// Compute values and clear dirty properties
 		PropertyIdSet dirty_properties = meta->style.ComputeValues(meta->computed_values, parent_values, document_values,
 			computed_values_are_default_initialized, dp_ratio, vp_dimensions);
 
 		computed_values_are_default_initialized = false;
+		ChangeFontFaceHandleReference(font_face_handle_before, meta->computed_values.font_face_handle());
 
 		// Computed values are just calculated and can safely be used in OnPropertyChange.
 		// However, new properties set during this call will not be available until the next update loop.
@@ -224,17 +283,23 @@ void Element::Render()
 	if (absolute_offset_dirty)
 		GetAbsoluteOffset(BoxArea::Border);
 
-	// Rebuild our stacking context if necessary.
-	if (stacking_context_dirty)
-		BuildLocalStackingContext();
+	// Rebuild our stacking context if necessary, or insert any children added to it since it was built.
+	UpdateLocalStackingContext();
 
 	UpdateTransformState();
 
 	// Apply our transform
 	ElementUtilities::ApplyTransform(*this);
 
-	// Set up the clipping region for this element.
-	if (ElementUtilities::SetClippingRegion(this))
+	// Apply our opacity as a colour modulation of everything we render, thereby our geometry doesn't need to change with it.
+	const float opacity = Math::Clamp(GetComputedValues().opacity(), 0.f, 1.f);
+	GeometryDatabase::SetColourModulation(Colourb(255, 255, 255, byte(opacity * 255.f)));
+
+	Context* context = GetContext();
+
+	// Set up the clipping region for this element, and skip rendering it if it is placed entirely outside this region.
+	const bool visible_in_clip_region = ElementUtilities::SetClippingRegion(this, context);
+	if (visible_in_clip_region)
 	{
 		meta->background_border.Render(this);
 		meta->decoration.RenderDecorators();
@@ -246,6 +311,27 @@ void Element::Render()
 		}
 	}
 
+	// When we are culled and every element in our stacking context is clipped by our overflow, then they can't be visible either. Clipping
+	// regions don't take transforms into account, thus we can only make this conclusion when our bounding box is untransformed.
+	const bool transformed = (transform_state && transform_state->GetTransform());
+	if (!visible_in_clip_region && stacking_context_clip_contained && !stacking_context.empty() && !transformed && IsClippingOverflow(this))
+	{
+		if (context)
+		{
+			context->render_statistics.num_elements_culled += 1 + (int)stacking_context.size();
+			context->render_statistics.num_subtrees_culled += 1;
+		}
+		return;
+	}
+
+	if (context)
+	{
+		if (visible_in_clip_region)
+			context->render_statistics.num_elements_rendered += 1;
+		else
+			context->render_statistics.num_elements_culled += 1;
+	}
+
 	// Render all elements in our local stacking context.
 	for (Element* element : stacking_context)
 		element->Render();
@@ -1260,7 +1346,10 @@ Element* Element::AppendChild(ElementPtr child, bool dom_element)
 	for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
 		ancestor->OnChildAdd(child_ptr);
 
-	DirtyStackingContext();
+	if (dom_element)
+		QueueStackingContextInsertion(child_ptr);
+	else
+		DirtyStackingContext();
 
 	// Not only does the element definition of the newly inserted element need to be dirtied, but also our own definition and implicitly all of our
 	// children's. This ensures correct styles being applied in the presence of tree-structural selectors such as ':first-child'.
@@ -1298,10 +1387,11 @@ Element* Element::InsertBefore(ElementPtr child, Element* adjacent_element)
 	{
 		child_ptr = child.get();
 
-		if ((int)child_index >= GetNumChildren())
-			num_non_dom_children++;
-		else
+		const bool dom_element = ((int)child_index < GetNumChildren());
+		if (dom_element)
 			DirtyLayout();
+		else
+			num_non_dom_children++;
 
 		children.insert(children.begin() + child_index, std::move(child));
 		child_ptr->SetParent(this);
@@ -1310,7 +1400,10 @@ Element* Element::InsertBefore(ElementPtr child, Element* adjacent_element)
 		for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
 			ancestor->OnChildAdd(child_ptr);
 
-		DirtyStackingContext();
+		if (dom_element)
+			QueueStackingContextInsertion(child_ptr);
+		else
+			DirtyStackingContext();
 		DirtyDefinition(DirtyNodes::Self);
 	}
 	else
@@ -1340,6 +1433,7 @@ ElementPtr Element::ReplaceChild(ElementPtr inserted_element, Element* replaced_
 
 	children.insert(insertion_point, std::move(inserted_element));
 	inserted_element_ptr->SetParent(this);
+	QueueStackingContextInsertion(inserted_element_ptr);
 
 	ElementPtr result = RemoveChild(replaced_element);
 
@@ -1363,6 +1457,8 @@ ElementPtr Element::RemoveChild(Element* child)
 			for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
 				ancestor->OnChildRemove(child);
 
+			RemoveFromStackingContext(child);
+
 			if (child_index >= children.size() - num_non_dom_children)
 				num_non_dom_children--;
 
@@ -1395,7 +1491,6 @@ ElementPtr Element::RemoveChild(Element* child)
 			detached_child->SetParent(nullptr);
 
 			DirtyLayout();
-			DirtyStackingContext();
 			DirtyDefinition(DirtyNodes::Self);
 
 			return detached_child;
@@ -1552,6 +1647,9 @@ void Element::SetInstancer(ElementInstancer* _instancer)
 
 void Element::ForceLocalStackingContext()
 {
+	if (!local_stacking_context)
+		DequeueDescendantStackingContextInsertions();
+
 	local_stacking_context_forced = true;
 	local_stacking_context = true;
 
@@ -1696,7 +1794,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		{
 			visible = new_visibility;
 
-			if (parent != nullptr)
+			if (parent != nullptr && !stacking_context_insertion_pending)
 				parent->DirtyStackingContext();
 
 			if (!visible)
@@ -1704,6 +1802,14 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		}
 	}
 
+	// The render order depends on the positioning scheme, and culling of our stacking context parent may depend on our clipping behavior.
+	if (parent != nullptr && !stacking_context_insertion_pending &&
+		(changed_properties.Contains(PropertyId::Position) || changed_properties.Contains(PropertyId::Float) ||
+			changed_properties.Contains(PropertyId::Clip)))
+	{
+		parent->DirtyStackingContext();
+	}
+
 	// Update the z-index.
 	if (changed_properties.Contains(PropertyId::ZIndex))
 	{
@@ -1711,39 +1817,54 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 
 		if (z_index_property.type == Style::ZIndex::Auto)
 		{
+			bool dirty_parent_stacking_context = false;
+
 			if (local_stacking_context && !local_stacking_context_forced)
 			{
-				// We're no longer acting as a stacking context.
+				// We're no longer acting as a stacking context, our descendants are now rendered by our stacking context parent.
 				local_stacking_context = false;
+				dirty_parent_stacking_context = true;
 
 				stacking_context_dirty = false;
 				stacking_context.clear();
+				meta->stacking_children.clear();
+				for (Element* element : meta->stacking_context_insertions)
+					element->stacking_context_insertion_pending = false;
+				meta->stacking_context_insertions.clear();
 			}
 
 			// If our old z-index was not zero, then we must dirty our stacking context so we'll be re-indexed.
 			if (z_index != 0)
 			{
 				z_index = 0;
-				DirtyStackingContext();
+				dirty_parent_stacking_context = true;
 			}
+
+			if (dirty_parent_stacking_context)
+				DirtyStackingContext();
 		}
 		else
 		{
 			float new_z_index = z_index_property.value;
+			bool dirty_parent_stacking_context = false;
 
 			if (new_z_index != z_index)
 			{
 				z_index = new_z_index;
-
-				if (parent != nullptr)
-					parent->DirtyStackingContext();
+				dirty_parent_stacking_context = true;
 			}
 
 			if (!local_stacking_context)
 			{
+				// Our descendants are no longer rendered by our stacking context parent.
+				DequeueDescendantStackingContextInsertions();
 				local_stacking_context = true;
 				stacking_context_dirty = true;
+				dirty_parent_stacking_context = true;
 			}
+
+			if (dirty_parent_stacking_context && parent != nullptr && !stacking_context_insertion_pending)
+				parent->DirtyStackingContext();
 		}
 	}
 
@@ -1757,7 +1878,6 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	// Dirty the background if it's changed.
 	if (border_radius_changed ||                                    //
 		changed_properties.Contains(PropertyId::BackgroundColor) || //
-		changed_properties.Contains(PropertyId::Opacity) ||         //
 		changed_properties.Contains(PropertyId::ImageColor))        //
 	{
 		meta->background_border.DirtyBackground();
@@ -1772,8 +1892,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		changed_properties.Contains(PropertyId::BorderTopColor) ||    //
 		changed_properties.Contains(PropertyId::BorderRightColor) ||  //
 		changed_properties.Contains(PropertyId::BorderBottomColor) || //
-		changed_properties.Contains(PropertyId::BorderLeftColor) ||   //
-		changed_properties.Contains(PropertyId::Opacity))
+		changed_properties.Contains(PropertyId::BorderLeftColor))
 	{
 		meta->background_border.DirtyBorder();
 	}
@@ -1785,9 +1904,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	}
 
 	// Dirty the decoration data when its visual looks may have changed.
-	if (border_radius_changed ||                            //
-		changed_properties.Contains(PropertyId::Opacity) || //
-		changed_properties.Contains(PropertyId::ImageColor))
+	if (border_radius_changed || changed_properties.Contains(PropertyId::ImageColor))
 	{
 		meta->decoration.DirtyDecoratorsData();
 	}
@@ -2123,23 +2240,6 @@ void Element::SetBaseline(float in_baseline)
 	baseline = in_baseline;
 }
 
-enum class RenderOrder {
-	StackNegative, // Local stacking context with z < 0.
-	Block,
-	TableColumnGroup,
-	TableColumn,
-	TableRowGroup,
-	TableRow,
-	TableCell,
-	Floating,
-	Inline,
-	Positioned,    // Positioned element, or local stacking context with z == 0.
-	StackPositive, // Local stacking context with z > 0.
-};
-struct StackingContextChild {
-	Element* element = nullptr;
-	RenderOrder order = {};
-};
 static bool operator<(const StackingContextChild& lhs, const StackingContextChild& rhs)
 {
 	if (int(lhs.order) == int(rhs.order))
@@ -2147,6 +2247,16 @@ static bool operator<(const StackingContextChild& lhs, const StackingContextChil
 	return int(lhs.order) < int(rhs.order);
 }
 
+// The full render order, with ties resolved by tree order as if sorted by a stable sort.
+static bool StackingContext_IndexedLess(const StackingContextChild& lhs, const StackingContextChild& rhs)
+{
+	if (lhs < rhs)
+		return true;
+	if (rhs < lhs)
+		return false;
+	return lhs.index < rhs.index;
+}
+
 // Treat all children in the range [index_begin, end) as if the parent created a new stacking context, by sorting them
 // separately and then assigning their parent's paint order. However, positioned and descendants which create a new
 // stacking context should be considered part of the parent stacking context. See CSS 2, Appendix E.
@@ -2162,17 +2272,92 @@ static void StackingContext_MakeAtomicRange(Vector<StackingContextChild>& stacki
 	}
 }
 
+static void StackingContext_CopyElements(const Vector<StackingContextChild>& stacking_children, ElementList& stacking_context)
+{
+	stacking_context.resize(stacking_children.size());
+	for (size_t i = 0; i < stacking_children.size(); i++)
+		stacking_context[i] = stacking_children[i].element;
+}
+
+// Returns the paint order of an element which doesn't establish a local stacking context, and whether its descendants are sorted together with
+// it as an atomic unit.
+static RenderOrder StackingContext_GetRenderOrder(Element* element, bool is_flex_item, bool& render_as_atomic_unit)
+{
+	using Style::Display;
+
+	const Display display = element->GetDisplay();
+	render_as_atomic_unit = false;
+
+	// Handle internal display values taking priority over position and float.
+	switch (display)
+	{
+	case Display::TableRow: return RenderOrder::TableRow;
+	case Display::TableRowGroup: return RenderOrder::TableRowGroup;
+	case Display::TableColumn: return RenderOrder::TableColumn;
+	case Display::TableColumnGroup: return RenderOrder::TableColumnGroup;
+	default: break;
+	}
+
+	render_as_atomic_unit = true;
+
+	if (element->GetPosition() != Style::Position::Static)
+		return RenderOrder::Positioned;
+	if (element->GetFloat() != Style::Float::None)
+		return RenderOrder::Floating;
+
+	switch (display)
+	{
+	case Display::Block:
+	case Display::FlowRoot:
+	case Display::Table:
+	case Display::Flex:
+		render_as_atomic_unit = (display == Display::Table || is_flex_item);
+		return RenderOrder::Block;
+
+	case Display::Inline:
+	case Display::InlineBlock:
+	case Display::InlineFlex:
+	case Display::InlineTable:
+		render_as_atomic_unit = (display != Display::Inline || is_flex_item);
+		return RenderOrder::Inline;
+
+	case Display::TableCell: return RenderOrder::TableCell;
+
+	case Display::TableRow:
+	case Display::TableRowGroup:
+	case Display::TableColumn:
+	case Display::TableColumnGroup:
+	case Display::None: RMLUI_ERROR; break; // Handled above.
+	}
+
+	render_as_atomic_unit = false;
+	return RenderOrder::Inline;
+}
+
 void Element::BuildLocalStackingContext()
 {
 	stacking_context_dirty = false;
 
-	Vector<StackingContextChild> stacking_children;
+	// All our descendants are placed from scratch, including any queued for insertion.
+	ElementList& insertions = meta->stacking_context_insertions;
+	for (Element* element : insertions)
+		element->stacking_context_insertion_pending = false;
+	insertions.clear();
+
+	Vector<StackingContextChild>& stacking_children = meta->stacking_children;
+	stacking_children.clear();
 	AddChildrenToStackingContext(stacking_children);
-	std::stable_sort(stacking_children.begin(), stacking_children.end());
 
-	stacking_context.resize(stacking_children.size());
 	for (size_t i = 0; i < stacking_children.size(); i++)
-		stacking_context[i] = stacking_children[i].element;
+		stacking_children[i].index = (int)i;
+
+	std::stable_sort(stacking_children.begin(), stacking_children.end());
+
+	StackingContext_CopyElements(stacking_children, stacking_context);
+	stacking_context_clip_contained = IsStackingContextClipContained(stacking_children);
+
+	if (Context* context = GetContext())
+		context->render_statistics.num_stacking_contexts_built += 1;
 }
 
 void Element::AddChildrenToStackingContext(Vector<StackingContextChild>& stacking_children)
@@ -2188,13 +2373,9 @@ void Element::AddChildrenToStackingContext(Vector<StackingContextChild>& stackin
 
 void Element::AddToStackingContext(Vector<StackingContextChild>& stacking_children, bool is_flex_item, bool is_non_dom_element)
 {
-	using Style::Display;
-
 	if (!IsVisible())
 		return;
 
-	const Display display = GetDisplay();
-
 	RenderOrder order = RenderOrder::Inline;
 	bool include_children = true;
 	bool render_as_atomic_unit = false;
@@ -2210,60 +2391,9 @@ void Element::AddToStackingContext(Vector<StackingContextChild>& stacking_childr
 
 		include_children = false;
 	}
-	else if (display == Display::TableRow || display == Display::TableRowGroup || display == Display::TableColumn ||
-		display == Display::TableColumnGroup)
-	{
-		// Handle internal display values taking priority over position and float.
-		switch (display)
-		{
-		case Display::TableRow: order = RenderOrder::TableRow; break;
-		case Display::TableRowGroup: order = RenderOrder::TableRowGroup; break;
-		case Display::TableColumn: order = RenderOrder::TableColumn; break;
-		case Display::TableColumnGroup: order = RenderOrder::TableColumnGroup; break;
-		default: break;
-		}
-	}
-	else if (GetPosition() != Style::Position::Static)
-	{
-		order = RenderOrder::Positioned;
-		render_as_atomic_unit = true;
-	}
-	else if (GetFloat() != Style::Float::None)
-	{
-		order = RenderOrder::Floating;
-		render_as_atomic_unit = true;
-	}
 	else
 	{
-		switch (display)
-		{
-		case Display::Block:
-		case Display::FlowRoot:
-		case Display::Table:
-		case Display::Flex:
-			order = RenderOrder::Block;
-			render_as_atomic_unit = (display == Display::Table || is_flex_item);
-			break;
-
-		case Display::Inline:
-		case Display::InlineBlock:
-		case Display::InlineFlex:
-		case Display::InlineTable:
-			order = RenderOrder::Inline;
-			render_as_atomic_unit = (display != Display::Inline || is_flex_item);
-			break;
-
-		case Display::TableCell:
-			order = RenderOrder::TableCell;
-			render_as_atomic_unit = true;
-			break;
-
-		case Display::TableRow:
-		case Display::TableRowGroup:
-		case Display::TableColumn:
-		case Display::TableColumnGroup:
-		case Display::None: RMLUI_ERROR; break; // Handled above.
-		}
+		order = StackingContext_GetRenderOrder(this, is_flex_item, render_as_atomic_unit);
 	}
 
 	if (is_non_dom_element)
@@ -2288,6 +2418,10 @@ void Element::DirtyStackingContext()
 	Element* stacking_context_parent = this;
 	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
 	{
+		// Subtrees queued for insertion are added to the render order as a whole, thereby including any changes made within them.
+		if (stacking_context_parent->stacking_context_insertion_pending)
+			return;
+
 		stacking_context_parent = stacking_context_parent->GetParentNode();
 	}
 
@@ -2295,6 +2429,263 @@ void Element::DirtyStackingContext()
 		stacking_context_parent->stacking_context_dirty = true;
 }
 
+void Element::QueueStackingContextInsertion(Element* child)
+{
+	Element* stacking_context_parent = this;
+	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
+	{
+		// The child is already included with an ancestor queued for insertion.
+		if (stacking_context_parent->stacking_context_insertion_pending)
+			return;
+
+		stacking_context_parent = stacking_context_parent->GetParentNode();
+	}
+
+	if (!stacking_context_parent || stacking_context_parent->stacking_context_dirty)
+		return;
+
+	// Each insertion is merged into the render order separately, beyond some point it is cheaper to rebuild it once.
+	static constexpr size_t max_queued_insertions = 32;
+
+	ElementList& insertions = stacking_context_parent->meta->stacking_context_insertions;
+	if (insertions.size() >= max_queued_insertions)
+	{
+		stacking_context_parent->stacking_context_dirty = true;
+		return;
+	}
+
+	child->stacking_context_insertion_pending = true;
+	insertions.push_back(child);
+}
+
+void Element::RemoveFromStackingContext(Element* child)
+{
+	bool child_queued = child->stacking_context_insertion_pending;
+
+	Element* stacking_context_parent = this;
+	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
+	{
+		child_queued |= stacking_context_parent->stacking_context_insertion_pending;
+		stacking_context_parent = stacking_context_parent->GetParentNode();
+	}
+
+	if (!stacking_context_parent)
+		return;
+
+	// Forget about any queued insertions within the child's subtree.
+	stacking_context_parent->RemoveQueuedStackingContextInsertions(child);
+
+	// Queued subtrees are not part of the render order yet, and a dirty render order is rebuilt anyway.
+	if (child_queued || stacking_context_parent->stacking_context_dirty)
+		return;
+
+	Vector<StackingContextChild>& stacking_children = stacking_context_parent->meta->stacking_children;
+	auto it_child = std::find_if(stacking_children.begin(), stacking_children.end(),
+		[child](const StackingContextChild& stacking_child) { return stacking_child.element == child; });
+	if (it_child == stacking_children.end())
+		return;
+
+	// The child's subtree occupies a contiguous range of indices, remove it while keeping the order of everything else.
+	const int index_begin = it_child->index;
+	const int index_end = stacking_context_parent->FindStackingContextIndexAfter(child);
+
+	auto it_removed = std::remove_if(stacking_children.begin(), stacking_children.end(), [index_begin, index_end](const StackingContextChild& entry) {
+		return entry.index >= index_begin && entry.index < index_end;
+	});
+	stacking_children.erase(it_removed, stacking_children.end());
+
+	StackingContext_CopyElements(stacking_children, stacking_context_parent->stacking_context);
+}
+
+void Element::RemoveQueuedStackingContextInsertions(Element* subtree_root)
+{
+	ElementList& insertions = meta->stacking_context_insertions;
+	if (insertions.empty())
+		return;
+
+	auto it_end = std::remove_if(insertions.begin(), insertions.end(), [this, subtree_root](Element* element) {
+		for (Element* ancestor = element; ancestor && ancestor != this; ancestor = ancestor->GetParentNode())
+		{
+			if (ancestor == subtree_root)
+			{
+				element->stacking_context_insertion_pending = false;
+				return true;
+			}
+		}
+		return false;
+	});
+	insertions.erase(it_end, insertions.end());
+}
+
+void Element::DequeueDescendantStackingContextInsertions()
+{
+	RMLUI_ASSERT(!local_stacking_context);
+
+	// Our descendants will be rendered by our own stacking context, which is built from scratch, so they must no longer be inserted into the
+	// stacking context of our parent. If we or an ancestor is queued instead, none of our descendants are queued separately.
+	Element* stacking_context_parent = this;
+	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
+	{
+		if (stacking_context_parent->stacking_context_insertion_pending)
+			return;
+
+		stacking_context_parent = stacking_context_parent->GetParentNode();
+	}
+
+	if (stacking_context_parent)
+		stacking_context_parent->RemoveQueuedStackingContextInsertions(this);
+}
+
+void Element::UpdateLocalStackingContext()
+{
+	ElementList& insertions = meta->stacking_context_insertions;
+	if (!stacking_context_dirty && insertions.empty())
+		return;
+
+	for (Element* element : insertions)
+		element->stacking_context_insertion_pending = false;
+
+	int num_insertions = 0;
+	if (!stacking_context_dirty)
+	{
+		for (Element* element : insertions)
+		{
+			if (!InsertIntoLocalStackingContext(element))
+			{
+				stacking_context_dirty = true;
+				break;
+			}
+			num_insertions += 1;
+		}
+	}
+
+	if (stacking_context_dirty)
+	{
+		BuildLocalStackingContext();
+		return;
+	}
+
+	insertions.clear();
+
+	StackingContext_CopyElements(meta->stacking_children, stacking_context);
+
+	if (Context* context = GetContext())
+		context->render_statistics.num_stacking_context_insertions += num_insertions;
+}
+
+bool Element::InsertIntoLocalStackingContext(Element* element)
+{
+	Element* element_parent = element->GetParentNode();
+
+	// The descendants of elements rendered as an atomic unit are first sorted among themselves, which we can't do with part of their subtree.
+	for (Element* ancestor = element_parent; ancestor != this; ancestor = ancestor->GetParentNode())
+	{
+		if (!ancestor || ancestor->local_stacking_context)
+			return false;
+
+		// Nothing is rendered inside invisible elements.
+		if (!ancestor->IsVisible())
+			return true;
+
+		Element* ancestor_parent = ancestor->GetParentNode();
+		if (!ancestor_parent)
+			return false;
+
+		bool render_as_atomic_unit = false;
+		StackingContext_GetRenderOrder(ancestor, ancestor_parent->GetDisplay() == Style::Display::Flex, render_as_atomic_unit);
+
+		const int num_siblings = (int)ancestor_parent->children.size();
+		for (int i = num_siblings - ancestor_parent->num_non_dom_children; i < num_siblings; i++)
+		{
+			if (ancestor_parent->children[i].get() == ancestor)
+				render_as_atomic_unit = true;
+		}
+
+		if (render_as_atomic_unit)
+			return false;
+	}
+
+	Vector<StackingContextChild> new_children;
+	element->AddToStackingContext(new_children, element_parent->GetDisplay() == Style::Display::Flex, false);
+	if (new_children.empty())
+		return true;
+
+	// Make room for the new subtree in tree order, just before the element following it.
+	const int index_insert = FindStackingContextIndexAfter(element);
+	const int num_new_children = (int)new_children.size();
+
+	Vector<StackingContextChild>& stacking_children = meta->stacking_children;
+	for (StackingContextChild& stacking_child : stacking_children)
+	{
+		if (stacking_child.index >= index_insert)
+			stacking_child.index += num_new_children;
+	}
+
+	for (int i = 0; i < num_new_children; i++)
+		new_children[i].index = index_insert + i;
+
+	std::stable_sort(new_children.begin(), new_children.end());
+
+	Vector<StackingContextChild> merged_children;
+	merged_children.reserve(stacking_children.size() + new_children.size());
+	std::merge(stacking_children.begin(), stacking_children.end(), new_children.begin(), new_children.end(), std::back_inserter(merged_children),
+		StackingContext_IndexedLess);
+	stacking_children = std::move(merged_children);
+
+	stacking_context_clip_contained = (stacking_context_clip_contained && IsStackingContextClipContained(new_children));
+
+	return true;
+}
+
+int Element::FindStackingContextIndexAfter(Element* element) const
+{
+	const Vector<StackingContextChild>& stacking_children = meta->stacking_children;
+
+	// Gather the following siblings of the element and of each of its ancestors. All of them follow the element's subtree in tree order, thus the
+	// first of them in our stacking context is the one with the lowest index. Elements which are not part of it have no descendants in it either.
+	UnorderedSet<Element*> following_elements;
+	for (Element* ancestor = element; ancestor && ancestor != this; ancestor = ancestor->GetParentNode())
+	{
+		const OwnedElementList& siblings = ancestor->GetParentNode()->children;
+		auto it_sibling = std::find_if(siblings.begin(), siblings.end(), [ancestor](const ElementPtr& sibling) { return sibling.get() == ancestor; });
+		if (it_sibling == siblings.end())
+			break;
+
+		for (++it_sibling; it_sibling != siblings.end(); ++it_sibling)
+			following_elements.insert(it_sibling->get());
+	}
+
+	int index_after = -1;
+	int index_end = 0;
+	for (const StackingContextChild& stacking_child : stacking_children)
+	{
+		index_end = Math::Max(index_end, stacking_child.index + 1);
+		if ((index_after < 0 || stacking_child.index < index_after) && following_elements.find(stacking_child.element) != following_elements.end())
+			index_after = stacking_child.index;
+	}
+
+	return index_after >= 0 ? index_after : index_end;
+}
+
+bool Element::IsStackingContextClipContained(const Vector<StackingContextChild>& stacking_children)
+{
+	// Elements may escape our clipping region when they ignore clipping, when they have a containing block outside of us, or through descendants
+	// in their own local stacking context.
+	const bool is_positioned = (GetPosition() != Style::Position::Static);
+	for (const StackingContextChild& stacking_child : stacking_children)
+	{
+		Element* element = stacking_child.element;
+		const Style::Position position = element->GetPosition();
+		if (element->local_stacking_context || !(element->GetComputedValues().clip() == Style::Clip::Type::Auto) ||
+			position == Style::Position::Fixed || (position == Style::Position::Absolute && !is_positioned))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void Element::DirtyDefinition(DirtyNodes dirty_nodes)
 {
 	switch (dirty_nodes)
@@ -2600,7 +2991,7 @@ void Element::AdvanceAnimations()
 		for (auto& animation : animations)
 		{
 			Property property = animation.UpdateAndGetProperty(time, *this);
-			if (property.unit != Unit::UNKNOWN)
+			if (property.unit != Unit::UNKNOWN && !SetAnimatedCompositingProperty(animation.GetPropertyId(), property))
 				SetProperty(animation.GetPropertyId(), property);
 		}
 
@@ -2635,6 +3026,52 @@ void Element::AdvanceAnimations()
 	}
 }
 
+bool Element::SetAnimatedCompositingProperty(PropertyId id, const Property& property)
+{
+	// The animated value is still stored as a local property, so that it is seen by later style computations and property queries.
+	switch (id)
+	{
+	case PropertyId::Opacity:
+	{
+		if (computed_values_are_default_initialized || !meta->style.SetPropertyUndirtied(id, property))
+			return false;
+
+		SetInheritedOpacityRecursive(property.Get<float>());
+		return true;
+	}
+	case PropertyId::Transform:
+	{
+		// Adding or removing the transform affects layout and stacking contexts, leave that to the regular property change handling.
+		if (!meta->computed_values.has_local_transform() || !property.Get<TransformPtr>() || !meta->style.SetPropertyUndirtied(id, property))
+			return false;
+
+		// The computed transform is looked up from the local property, thus only the transform state needs to be updated.
+		DirtyTransformState(false, true);
+		return true;
+	}
+	default: break;
+	}
+
+	return false;
+}
+
+void Element::SetInheritedOpacityRecursive(float opacity)
+{
+	meta->computed_values.opacity(opacity);
+
+	const int num_children = GetNumChildren(true);
+	for (int i = 0; i < num_children; i++)
+	{
+		Element* child = GetChild(i);
+
+		// Children with their own opacity don't inherit it, and children without computed values will inherit it once computed.
+		if (child->computed_values_are_default_initialized || child->GetLocalProperty(PropertyId::Opacity))
+			continue;
+
+		child->SetInheritedOpacityRecursive(opacity);
+	}
+}
+
 void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
 	dirty_perspective |= perspective_dirty;
@@ -2719,7 +3156,7 @@ void Element::UpdateTransformState()
 			{
 				const TransformPrimitive& primitive = transform_ptr->GetPrimitive(i);
 				Matrix4f matrix = TransformUtilities::ResolveTransform(primitive, *this);
-				transform *= matrix;
+				transform = (have_transform ? transform * matrix : matrix);
 				have_transform = true;
 			}
 
@@ -2750,20 +3187,19 @@ void Element::UpdateTransformState()
 
 		if (parent && parent->transform_state)
 		{
-			// Apply the parent's local perspective and transform.
-			// @performance: If we have no local transform and no parent perspective, we can effectively just point to the parent transform instead of
-			// copying it.
+			// Apply the parent's local perspective and transform. Without a local transform, such as for most descendants of a transformed
+			// element, the parent's matrices are copied instead of being multiplied with the identity matrix.
 			const TransformState& parent_state = *parent->transform_state;
 
 			if (auto parent_perspective = parent_state.GetLocalPerspective())
 			{
-				transform = *parent_perspective * transform;
+				transform = (have_transform ? *parent_perspective * transform : *parent_perspective);
 				have_transform = true;
 			}
 
 			if (auto parent_transform = parent_state.GetTransform())
 			{
-				transform = *parent_transform * transform;
+				transform = (have_transform ? *parent_transform * transform : *parent_transform);
 				have_transform = true;
 			}
 		}
@@ -2824,6 +3260,7 @@ void Element::DirtyFontFaceRecursive()
 {
 	// Dirty the font size to force the element to update the face handle during the next Update(), and update any existing text geometry.
 	meta->style.DirtyProperty(PropertyId::FontSize);
+	ChangeFontFaceHandleReference(meta->computed_values.font_face_handle(), 0);
 	meta->computed_values.font_face_handle(0);
 
 	const int num_children = GetNumChildren(true);
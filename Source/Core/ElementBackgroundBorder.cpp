@@ -64,26 +64,17 @@ void ElementBackgroundBorder::GenerateGeometry(Element* element)
 {
 	const ComputedValues& computed = element->GetComputedValues();
 
-	Colourb background_color = computed.background_color();
-	Colourb border_colors[4] = {
+	// Opacity is not applied here, instead the element modulates the colour of its geometry while rendering.
+	const Colourb background_color = computed.background_color();
+	const Colourb border_colors[4] = {
 		computed.border_top_color(),
 		computed.border_right_color(),
 		computed.border_bottom_color(),
 		computed.border_left_color(),
 	};
 
-	// Apply opacity
-	const float opacity = computed.opacity();
-	background_color.alpha = (byte)(opacity * (float)background_color.alpha);
-
-	if (opacity < 1)
-	{
-		for (int i = 0; i < 4; ++i)
-			border_colors[i].alpha = (byte)(opacity * (float)border_colors[i].alpha);
-	}
-
-	geometry.GetVertices().clear();
-	geometry.GetIndices().clear();
+	// Clear any previous geometry, this also avoids copying it back out of the geometry arena.
+	geometry.Release(true);
 
 	const Vector4f radii(computed.border_top_left_radius(), computed.border_top_right_radius(), computed.border_bottom_right_radius(),
 		computed.border_bottom_left_radius());
@@ -94,8 +85,6 @@ void ElementBackgroundBorder::GenerateGeometry(Element* element)
 		const Box& box = element->GetBox(i, offset);
 		GeometryUtilities::GenerateBackgroundBorder(&geometry, box, offset, radii, background_color, border_colors);
 	}
-
-	geometry.Release();
 }
 
 } // namespace Rml
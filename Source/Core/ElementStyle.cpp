@@ -308,6 +308,16 @@ const StringList& ElementStyle::GetClassNameList() const
 }
 
 bool ElementStyle::SetProperty(PropertyId id, const Property& property)
+{
+	if (!SetPropertyUndirtied(id, property))
+		return false;
+
+	DirtyProperty(id);
+
+	return true;
+}
+
+bool ElementStyle::SetPropertyUndirtied(PropertyId id, const Property& property)
 {
 	Property new_property = property;
 
@@ -316,7 +326,6 @@ bool ElementStyle::SetProperty(PropertyId id, const Property& property)
 		return false;
 
 	inline_properties.SetProperty(id, new_property);
-	DirtyProperty(id);
 
 	return true;
 }
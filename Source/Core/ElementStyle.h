@@ -93,6 +93,10 @@ public:
 	/// @param[in] name The name of the new property.
 	/// @param[in] property The parsed property to set.
 	bool SetProperty(PropertyId id, const Property& property);
+	/// Sets a local property override without dirtying the property. The caller is then responsible for updating the computed value.
+	/// @param[in] name The name of the new property.
+	/// @param[in] property The parsed property to set.
+	bool SetPropertyUndirtied(PropertyId id, const Property& property);
 	/// Removes a local property override on the element; its value will revert to that defined in
 	/// the style sheet.
 	/// @param[in] name The name of the local property definition to remove.
@@ -66,7 +66,7 @@ void LogMissingFontFace(Element* element)
 }
 
 ElementText::ElementText(const String& tag) :
-	Element(tag), colour(255, 255, 255), opacity(1), font_handle_version(0), geometry_dirty(true), dirty_layout_on_change(true),
+	Element(tag), colour(255, 255, 255), font_handle_version(0), geometry_dirty(true), dirty_layout_on_change(true),
 	generated_decoration(Style::TextDecoration::None), decoration_property(Style::TextDecoration::None), font_effects_dirty(true),
 	font_effects_handle(0)
 {}
@@ -332,25 +332,12 @@ void ElementText::OnPropertyChange(const PropertyIdSet& changed_properties)
 	bool font_face_changed = false;
 	auto& computed = GetComputedValues();
 
-	if (changed_properties.Contains(PropertyId::Color) || changed_properties.Contains(PropertyId::Opacity))
+	// Changes to opacity don't affect our geometry, as opacity is applied as a colour modulation when rendering.
+	if (changed_properties.Contains(PropertyId::Color))
 	{
-		const float new_opacity = computed.opacity();
-		const bool opacity_changed = opacity != new_opacity;
-
-		Colourb new_colour = computed.color();
-		new_colour.alpha = byte(new_opacity * float(new_colour.alpha));
+		const Colourb new_colour = computed.color();
 		colour_changed = colour != new_colour;
-
-		if (colour_changed)
-		{
-			colour = new_colour;
-		}
-		if (opacity_changed)
-		{
-			opacity = new_opacity;
-			font_effects_dirty = true;
-			geometry_dirty = true;
-		}
+		colour = new_colour;
 	}
 
 	if (changed_properties.Contains(PropertyId::FontFamily) || //
@@ -462,7 +449,7 @@ void ElementText::GenerateGeometry(const FontFaceHandle font_face_handle, Line&
 {
 	const float letter_spacing = GetComputedValues().letter_spacing();
 
-	line.width = GetFontEngineInterface()->GenerateString(font_face_handle, font_effects_handle, line.text, line.position, colour, opacity,
+	line.width = GetFontEngineInterface()->GenerateString(font_face_handle, font_effects_handle, line.text, line.position, colour, 1.f,
 		letter_spacing, geometry);
 }
 
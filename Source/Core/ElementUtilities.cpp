@@ -259,6 +259,74 @@ bool ElementUtilities::SetClippingRegion(Element* element, Context* context)
 		ApplyActiveClipRegion(context);
 	}
 
+	if (element)
+	{
+		// Nothing can be seen through an empty clipping region, not even text or other contents overflowing the element's boxes.
+		if (clip && (clip_dimensions.x == 0 || clip_dimensions.y == 0))
+			return false;
+
+		Rectanglef clip_rectangle = Rectanglef::FromSize(Vector2f(context->GetDimensions()));
+		if (clip)
+			clip_rectangle = Rectanglef::FromPositionSize(Vector2f(clip_origin), Vector2f(clip_dimensions));
+
+		// The bounding box includes the transforms of the element and its ancestors, while the clipping region does not. Thus, the two can
+		// only be compared when the clipping region spans the window, otherwise leave any transformed elements unculled.
+		const TransformState* transform_state = element->GetTransformState();
+		const bool transformed = (transform_state && transform_state->GetTransform());
+
+		// Elements without any area, such as text elements, may still render contents outside their boxes. Leave those for the element to handle.
+		Rectanglef bounding_box;
+		if (!(clip && transformed) && GetBoundingBox(bounding_box, element, BoxArea::Border) && bounding_box.Width() > 0.f &&
+			bounding_box.Height() > 0.f && !bounding_box.Intersects(clip_rectangle))
+			return false;
+	}
+
+	return true;
+}
+
+bool ElementUtilities::GetBoundingBox(Rectanglef& out_rectangle, Element* element, BoxArea area)
+{
+	RMLUI_ASSERT(area != BoxArea::Auto);
+
+	const Vector2f element_origin = element->GetAbsoluteOffset(BoxArea::Border);
+
+	Rectanglef rectangle = Rectanglef::MakeInvalid();
+	const int num_boxes = element->GetNumBoxes();
+	for (int i = 0; i < num_boxes; i++)
+	{
+		Vector2f box_offset;
+		const Box& box = element->GetBox(i, box_offset);
+		const Rectanglef box_rectangle = Rectanglef::FromPositionSize(element_origin + box_offset + box.GetPosition(area), box.GetSize(area));
+		if (i == 0)
+			rectangle = box_rectangle;
+		else
+			rectangle.Join(box_rectangle);
+	}
+
+	const TransformState* transform_state = element->GetTransformState();
+	const Matrix4f* transform = (transform_state ? transform_state->GetTransform() : nullptr);
+	if (transform)
+	{
+		const Vector2f corners[4] = {rectangle.TopLeft(), {rectangle.Right(), rectangle.Top()}, rectangle.BottomRight(),
+			{rectangle.Left(), rectangle.Bottom()}};
+
+		for (int i = 0; i < 4; i++)
+		{
+			const Vector4f projected = *transform * Vector4f(corners[i].x, corners[i].y, 0, 1);
+
+			// Corners at or behind the viewer's plane can't be projected meaningfully onto the window.
+			if (projected.w <= 0.f)
+				return false;
+
+			const Vector2f point = Vector2f(projected.x, projected.y) / projected.w;
+			if (i == 0)
+				rectangle = Rectanglef::FromPosition(point);
+			else
+				rectangle.Join(point);
+		}
+	}
+
+	out_rectangle = rectangle;
 	return true;
 }
 
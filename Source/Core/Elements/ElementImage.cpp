@@ -129,7 +129,7 @@ void ElementImage::OnPropertyChange(const PropertyIdSet& changed_properties)
 {
 	Element::OnPropertyChange(changed_properties);
 
-	if (changed_properties.Contains(PropertyId::ImageColor) || changed_properties.Contains(PropertyId::Opacity))
+	if (changed_properties.Contains(PropertyId::ImageColor))
 	{
 		GenerateGeometry();
 	}
@@ -193,9 +193,7 @@ void ElementImage::GenerateGeometry()
 
 	const ComputedValues& computed = GetComputedValues();
 
-	float opacity = computed.opacity();
-	Colourb quad_colour = computed.image_color();
-	quad_colour.alpha = (byte)(opacity * (float)quad_colour.alpha);
+	const Colourb quad_colour = computed.image_color();
 
 	Vector2f quad_size = GetBox().GetSize(BoxArea::Content).Round();
 
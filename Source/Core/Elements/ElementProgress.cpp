@@ -87,7 +87,7 @@ bool ElementProgress::GetIntrinsicDimensions(Vector2f& dimensions, float& /*rati
 
 void ElementProgress::OnRender()
 {
-	// Some properties may change geometry without dirtying the layout, eg. opacity.
+	// Some properties may change geometry without dirtying the layout, eg. image color.
 	if (geometry_dirty)
 		GenerateGeometry();
 
@@ -143,7 +143,7 @@ void ElementProgress::OnPropertyChange(const PropertyIdSet& changed_properties)
 {
 	Element::OnPropertyChange(changed_properties);
 
-	if (changed_properties.Contains(PropertyId::ImageColor) || changed_properties.Contains(PropertyId::Opacity))
+	if (changed_properties.Contains(PropertyId::ImageColor))
 	{
 		geometry_dirty = true;
 	}
@@ -243,13 +243,7 @@ void ElementProgress::GenerateGeometry()
 		texcoords[1] = Vector2f(1, 1);
 	}
 
-	Colourb quad_colour;
-	{
-		const ComputedValues& computed = GetComputedValues();
-		const float opacity = computed.opacity();
-		quad_colour = computed.image_color();
-		quad_colour.alpha = (byte)(opacity * (float)quad_colour.alpha);
-	}
+	const Colourb quad_colour = GetComputedValues().image_color();
 
 	switch (direction)
 	{
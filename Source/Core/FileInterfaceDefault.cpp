@@ -30,6 +30,16 @@
 
 #ifndef RMLUI_NO_FILE_INTERFACE_DEFAULT
 
+	#if defined(RMLUI_PLATFORM_WIN32)
+		#include <windows.h>
+	#elif defined(RMLUI_PLATFORM_UNIX) && !defined(RMLUI_PLATFORM_EMSCRIPTEN)
+		#define RMLUI_FILE_INTERFACE_MMAP
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+	#endif
+
 namespace Rml {
 
 FileInterfaceDefault::~FileInterfaceDefault() {}
@@ -59,5 +69,77 @@ size_t FileInterfaceDefault::Tell(FileHandle file)
 	return ftell((FILE*)file);
 }
 
+bool FileInterfaceDefault::MapFile(const String& path, const byte*& out_data, size_t& out_size)
+{
+	#if defined(RMLUI_PLATFORM_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size = {};
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// The mapping and the view keep the file open, so the handles can be closed right away.
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data)
+		return false;
+
+	out_data = static_cast<const byte*>(data);
+	out_size = (size_t)file_size.QuadPart;
+	return true;
+
+	#elif defined(RMLUI_FILE_INTERFACE_MMAP)
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat file_status = {};
+	if (fstat(file, &file_status) != 0 || file_status.st_size <= 0)
+	{
+		close(file);
+		return false;
+	}
+
+	// The mapping keeps the file open, so the descriptor can be closed right away.
+	void* data = mmap(nullptr, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+		return false;
+
+	out_data = static_cast<const byte*>(data);
+	out_size = (size_t)file_status.st_size;
+	return true;
+
+	#else
+	(void)path;
+	(void)out_data;
+	(void)out_size;
+	return false;
+	#endif
+}
+
+void FileInterfaceDefault::UnmapFile(const byte* data, size_t size)
+{
+	#if defined(RMLUI_PLATFORM_WIN32)
+	(void)size;
+	UnmapViewOfFile(data);
+	#elif defined(RMLUI_FILE_INTERFACE_MMAP)
+	munmap(const_cast<byte*>(data), size);
+	#else
+	(void)data;
+	(void)size;
+	#endif
+}
+
 } // namespace Rml
 #endif /*RMLUI_NO_FILE_INTERFACE_DEFAULT*/
@@ -70,6 +70,17 @@ public:
 	/// @param file The handle of the file to be queried.
 	/// @return The number of bytes from the origin of the file.
 	size_t Tell(FileHandle file) override;
+
+	/// Maps a file into memory for reading, on platforms supporting it.
+	/// @param path The path to the file to map.
+	/// @param out_data The start of the mapped contents of the file.
+	/// @param out_size The length of the file in bytes.
+	/// @return True if the file was mapped.
+	bool MapFile(const String& path, const byte*& out_data, size_t& out_size) override;
+	/// Releases a file previously mapped through MapFile().
+	/// @param data The start of the mapped contents of the file.
+	/// @param size The length of the file in bytes.
+	void UnmapFile(const byte* data, size_t size) override;
 };
 
 } // namespace Rml
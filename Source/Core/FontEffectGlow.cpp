@@ -29,6 +29,7 @@
 #include "FontEffectGlow.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "Memory.h"
+#include <cmath>
 
 namespace Rml {
 
@@ -125,6 +126,36 @@ bool FontEffectGlow::GetGlyphMetrics(Vector2i& origin, Vector2i& dimensions, con
 void FontEffectGlow::GenerateGlyphTexture(byte* destination_data, const Vector2i destination_dimensions, int destination_stride,
 	const FontGlyph& glyph) const
 {
+	// Glyphs generated from a distance field are given their glow directly from their distance, as long as it is within the field's spread.
+	// The gaussian blur filter turns a straight edge into the error function of the distance to the edge, which is used as the opacity here.
+	// Thus, the result only differs from the filtered glow around corners and tight curves of the outline.
+	if (glyph.distance_field && float(combined_width) <= glyph.GetDistanceFieldSpread())
+	{
+		const float std_dev = .4f * float(width_blur);
+
+		DynamicArray<float, GlobalStackAllocator<float>> distances(destination_dimensions.x * destination_dimensions.y);
+		glyph.GetDistances(Vector2i(-combined_width), destination_dimensions, distances.data());
+
+		for (int y = 0; y < destination_dimensions.y; y++)
+		{
+			byte* destination = destination_data + y * destination_stride;
+			const float* distance = distances.data() + y * destination_dimensions.x;
+			for (int x = 0; x < destination_dimensions.x; x++)
+			{
+				const float edge_distance = distance[x] + float(width_outline);
+
+				float opacity;
+				if (width_blur == 0)
+					opacity = Math::Clamp(0.5f + edge_distance, 0.f, 1.f);
+				else
+					opacity = 0.5f + 0.5f * std::erf(edge_distance / (Math::SquareRoot(2.f) * std_dev));
+
+				destination[x * 4 + 3] = byte(opacity * 255.f + 0.5f);
+			}
+		}
+		return;
+	}
+
 	const Vector2i buf_dimensions = destination_dimensions;
 	const int buf_stride = buf_dimensions.x;
 	const int buf_size = buf_dimensions.x * buf_dimensions.y;
@@ -28,6 +28,7 @@
 
 #include "FontEffectOutline.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
+#include "Memory.h"
 
 namespace Rml {
 
@@ -91,6 +92,25 @@ bool FontEffectOutline::GetGlyphMetrics(Vector2i& origin, Vector2i& dimensions,
 void FontEffectOutline::GenerateGlyphTexture(byte* destination_data, const Vector2i destination_dimensions, int destination_stride,
 	const FontGlyph& glyph) const
 {
+	// Glyphs generated from a distance field are outlined by thresholding their distance, as long as the outline is within its spread.
+	if (glyph.distance_field && float(width) <= glyph.GetDistanceFieldSpread())
+	{
+		DynamicArray<float, GlobalStackAllocator<float>> distances(destination_dimensions.x * destination_dimensions.y);
+		glyph.GetDistances(Vector2i(-width), destination_dimensions, distances.data());
+
+		for (int y = 0; y < destination_dimensions.y; y++)
+		{
+			byte* destination = destination_data + y * destination_stride;
+			const float* distance = distances.data() + y * destination_dimensions.x;
+			for (int x = 0; x < destination_dimensions.x; x++)
+			{
+				const float opacity = Math::Clamp(0.5f + distance[x] + float(width), 0.f, 1.f);
+				destination[x * 4 + 3] = byte(opacity * 255.f + 0.5f);
+			}
+		}
+		return;
+	}
+
 	filter.Run(destination_data, destination_dimensions, destination_stride, ColorFormat::RGBA8, glyph.bitmap_data, glyph.bitmap_dimensions,
 		Vector2i(width), glyph.color_format);
 }
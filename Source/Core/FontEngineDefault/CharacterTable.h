@@ -0,0 +1,161 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_CHARACTERTABLE_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_CHARACTERTABLE_H
+
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    An associative container from characters to values, for use in place of an unordered map where lookups happen for every character of
+    every string, such as for glyphs.
+
+    Code points in the Basic Multilingual Plane are looked up directly by index in pages of 256 characters, pages are only allocated for
+    the code points actually used. Any other code points are looked up in a hash map. The values are stored contiguously in insertion order,
+    and iterate as pairs of character and value.
+
+    Unlike an unordered map, any insertion may invalidate all iterators, pointers and references to values, since the values are stored in
+    a vector. Look up values again after inserting into the table.
+ */
+
+template <typename T>
+class CharacterTable {
+public:
+	using value_type = Pair<Character, T>;
+	using iterator = typename Vector<value_type>::iterator;
+	using const_iterator = typename Vector<value_type>::const_iterator;
+
+	iterator begin() { return entries.begin(); }
+	iterator end() { return entries.end(); }
+	const_iterator begin() const { return entries.begin(); }
+	const_iterator end() const { return entries.end(); }
+
+	size_t size() const { return entries.size(); }
+	bool empty() const { return entries.empty(); }
+
+	void reserve(size_t new_capacity) { entries.reserve(new_capacity); }
+
+	void clear()
+	{
+		entries.clear();
+		pages.clear();
+		page_slots.clear();
+		sparse_indices.clear();
+	}
+
+	iterator find(Character character)
+	{
+		const int index = FindIndex(character);
+		return index < 0 ? entries.end() : entries.begin() + index;
+	}
+	const_iterator find(Character character) const
+	{
+		const int index = FindIndex(character);
+		return index < 0 ? entries.end() : entries.begin() + index;
+	}
+
+	/// Inserts the value for the given character, unless the character already exists in the table.
+	/// @return The iterator to the value of the character, and true if it was inserted.
+	Pair<iterator, bool> emplace(Character character, T&& value)
+	{
+		int& index = GetOrCreateIndex(character);
+		if (index >= 0)
+			return {entries.begin() + index, false};
+
+		index = (int)entries.size();
+		entries.emplace_back(character, std::move(value));
+		return {entries.end() - 1, true};
+	}
+
+	T& operator[](Character character)
+	{
+		int& index = GetOrCreateIndex(character);
+		if (index < 0)
+		{
+			index = (int)entries.size();
+			entries.emplace_back(character, T());
+		}
+		return entries[index].second;
+	}
+
+private:
+	static constexpr char32_t PageSize = 256;
+	static constexpr char32_t NumDensePages = 256;
+
+	int FindIndex(Character character) const
+	{
+		const char32_t code_point = char32_t(character);
+		if (code_point < PageSize * NumDensePages)
+		{
+			if (pages.empty())
+				return -1;
+			const int page_offset = pages[code_point / PageSize];
+			if (page_offset < 0)
+				return -1;
+			return page_slots[page_offset + code_point % PageSize];
+		}
+
+		auto it = sparse_indices.find(character);
+		return it == sparse_indices.end() ? -1 : it->second;
+	}
+
+	// Returns a reference to the index slot of the given character, set to -1 if the character is not in the table.
+	int& GetOrCreateIndex(Character character)
+	{
+		const char32_t code_point = char32_t(character);
+		if (code_point < PageSize * NumDensePages)
+		{
+			if (pages.empty())
+				pages.resize(NumDensePages, -1);
+
+			int& page_offset = pages[code_point / PageSize];
+			if (page_offset < 0)
+			{
+				page_offset = (int)page_slots.size();
+				page_slots.resize(page_slots.size() + PageSize, -1);
+			}
+			return page_slots[page_offset + code_point % PageSize];
+		}
+
+		return sparse_indices.emplace(character, -1).first->second;
+	}
+
+	Vector<value_type> entries;
+
+	// For each page of the Basic Multilingual Plane, its offset into the page slots, or -1 if the page is not used.
+	Vector<int> pages;
+	// The entry index of each character in the used pages, or -1 if the character is not in the table.
+	Vector<int> page_slots;
+	// The entry index of characters outside the dense pages.
+	UnorderedMap<Character, int> sparse_indices;
+};
+
+} // namespace Rml
+#endif
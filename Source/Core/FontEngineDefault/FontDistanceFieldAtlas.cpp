@@ -0,0 +1,158 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FontDistanceFieldAtlas.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+#include "../../../Include/RmlUi/Core/RenderInterface.h"
+
+namespace Rml {
+
+static constexpr int min_texture_dimensions = 512;
+static constexpr int max_texture_dimensions = 1024;
+
+FontDistanceFieldAtlas::FontDistanceFieldAtlas() {}
+
+FontDistanceFieldAtlas::~FontDistanceFieldAtlas() {}
+
+const FontDistanceFieldAtlas::Entry& FontDistanceFieldAtlas::AddField(const FontGlyphDistanceField& field)
+{
+	auto it_entry = entries.find(&field);
+	if (it_entry != entries.end())
+		return it_entry->second;
+
+	Entry& entry = entries[&field];
+
+	// Place the field in the first texture with room for it, or else start a new texture.
+	for (int i = 0; i < (int)texture_pages.size(); ++i)
+	{
+		if (texture_pages[i].skyline.Allocate(field.dimensions, entry.position))
+		{
+			entry.texture_index = i;
+			break;
+		}
+	}
+
+	if (entry.texture_index < 0)
+	{
+		const int field_size = Math::Max(field.dimensions.x, field.dimensions.y) + 2;
+		if (field_size > max_texture_dimensions)
+			return entry;
+
+		TexturePage page;
+		page.dimensions = Vector2i(Math::Max(Math::ToPowerOfTwo(field_size), min_texture_dimensions));
+		page.skyline = TextureLayoutSkyline(page.dimensions);
+		if (!page.skyline.Allocate(field.dimensions, entry.position))
+			return entry;
+
+		entry.texture_index = (int)texture_pages.size();
+		texture_pages.push_back(page);
+		textures.push_back(MakeUnique<Texture>());
+	}
+
+	const Vector2f page_dimensions = Vector2f(texture_pages[entry.texture_index].dimensions);
+	entry.texcoords[0] = Vector2f(entry.position) / page_dimensions;
+	entry.texcoords[1] = Vector2f(entry.position + field.dimensions) / page_dimensions;
+
+	// Only the texture holding the new field needs to be regenerated, it is generated once on its next use regardless of how many fields
+	// are added until then.
+	SetTextureCallback(entry.texture_index);
+
+	return entry;
+}
+
+const Texture* FontDistanceFieldAtlas::GetTexture(int index) const
+{
+	RMLUI_ASSERT(index >= 0);
+	RMLUI_ASSERT(index < GetNumTextures());
+
+	return textures[index].get();
+}
+
+int FontDistanceFieldAtlas::GetNumTextures() const
+{
+	return (int)textures.size();
+}
+
+size_t FontDistanceFieldAtlas::GetTextureMemoryUsage() const
+{
+	size_t result = 0;
+	for (const TexturePage& page : texture_pages)
+		result += size_t(page.dimensions.x) * size_t(page.dimensions.y) * 4;
+	return result;
+}
+
+bool FontDistanceFieldAtlas::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const int texture_index) const
+{
+	if (texture_index < 0 || texture_index >= (int)texture_pages.size())
+		return false;
+
+	texture_dimensions = texture_pages[texture_index].dimensions;
+
+	// Generate the texture data, initialised to white at the furthest distance outside the outlines.
+	const int texture_stride = texture_dimensions.x * 4;
+	UniquePtr<byte[]> data(new byte[texture_stride * texture_dimensions.y]);
+	for (int i = 0; i < texture_dimensions.x * texture_dimensions.y; i++)
+		((unsigned int*)(data.get()))[i] = 0x00ffffff;
+
+	for (const auto& pair : entries)
+	{
+		const FontGlyphDistanceField& field = *pair.first;
+		const Entry& entry = pair.second;
+		if (entry.texture_index != texture_index)
+			continue;
+
+		for (int y = 0; y < field.dimensions.y; y++)
+		{
+			const byte* source = field.data.get() + y * field.dimensions.x;
+			byte* destination = data.get() + (entry.position.y + y) * texture_stride + entry.position.x * 4;
+			for (int x = 0; x < field.dimensions.x; x++)
+				destination[x * 4 + 3] = source[x];
+		}
+	}
+
+	texture_data = std::move(data);
+	return true;
+}
+
+void FontDistanceFieldAtlas::SetTextureCallback(const int texture_index)
+{
+	TextureCallback texture_callback = [this, texture_index](RenderInterface* render_interface, const String& /*name*/,
+										   TextureHandle& out_texture_handle, Vector2i& out_dimensions) -> bool {
+		UniquePtr<const byte[]> data;
+		if (!GenerateTexture(data, out_dimensions, texture_index) || !data)
+			return false;
+		if (!render_interface->GenerateDistanceFieldTexture(out_texture_handle, data.get(), out_dimensions))
+			return false;
+		return true;
+	};
+
+	// Setting the callback gives the texture a new resource, any existing resource is released when no longer in use.
+	textures[texture_index]->Set("font-distance-field-atlas", texture_callback);
+}
+
+} // namespace Rml
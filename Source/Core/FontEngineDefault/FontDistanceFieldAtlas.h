@@ -0,0 +1,90 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTDISTANCEFIELDATLAS_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_FONTDISTANCEFIELDATLAS_H
+
+#include "../../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../../Include/RmlUi/Core/Texture.h"
+#include "../../../Include/RmlUi/Core/Traits.h"
+#include "../TextureLayoutSkyline.h"
+
+namespace Rml {
+
+/**
+    The textures holding the glyph distance fields of a font face, shared by all sizes of the face. The fields are rendered with distance field
+    textures, so that the same texture coordinates apply to any font size. Only used when supported by the render interface.
+ */
+
+class FontDistanceFieldAtlas final : public NonCopyMoveable {
+public:
+	// The placement of a distance field in the atlas.
+	struct Entry {
+		// The texture the field is placed in, or -1 if it could not be placed.
+		int texture_index = -1;
+		// The position, in pixels, of the field within its texture.
+		Vector2i position;
+		// The texture coordinates of the whole field.
+		Vector2f texcoords[2];
+	};
+
+	FontDistanceFieldAtlas();
+	~FontDistanceFieldAtlas();
+
+	/// Places a distance field in the first texture with room for it, or in a new texture, unless it has been placed already.
+	/// @param[in] field The distance field, which must outlive the atlas.
+	/// @return The placement of the field, with a texture index of -1 if it is too large for the atlas.
+	const Entry& AddField(const FontGlyphDistanceField& field);
+
+	/// Returns one of the atlas' textures.
+	const Texture* GetTexture(int index) const;
+	/// Returns the number of textures in the atlas.
+	int GetNumTextures() const;
+	/// Returns the number of bytes of texture data generated by the atlas.
+	size_t GetTextureMemoryUsage() const;
+
+private:
+	struct TexturePage {
+		Vector2i dimensions;
+		TextureLayoutSkyline skyline;
+	};
+
+	// Generates the texture data of a page from the fields placed in it.
+	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_index) const;
+
+	// (Re-)sets the texture callback of the given texture, so that it is regenerated on next use.
+	void SetTextureCallback(int texture_index);
+
+	UnorderedMap<const FontGlyphDistanceField*, Entry> entries;
+	Vector<TexturePage> texture_pages;
+	// Geometry refers to the textures by pointer, so they are kept stable while new textures are added.
+	Vector<UniquePtr<Texture>> textures;
+};
+
+} // namespace Rml
+#endif
@@ -90,6 +90,16 @@ int FontEngineInterfaceDefault::GetVersion(FontFaceHandle handle)
 	return handle_default->GetVersion();
 }
 
+void FontEngineInterfaceDefault::AddFontFaceHandleReference(FontFaceHandle handle)
+{
+	FontProvider::AddHandleReference(handle);
+}
+
+void FontEngineInterfaceDefault::RemoveFontFaceHandleReference(FontFaceHandle handle)
+{
+	FontProvider::RemoveHandleReference(handle);
+}
+
 void FontEngineInterfaceDefault::ReleaseFontResources()
 {
 	FontProvider::ReleaseFontResources();
@@ -65,6 +65,10 @@ public:
 	/// Returns the current version of the font face.
 	int GetVersion(FontFaceHandle handle) override;
 
+	/// Keeps the resources of handles referenced by elements from being released to stay within the memory budget.
+	void AddFontFaceHandleReference(FontFaceHandle handle) override;
+	void RemoveFontFaceHandleReference(FontFaceHandle handle) override;
+
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources() override;
 };
@@ -27,8 +27,12 @@
  */
 
 #include "FontFace.h"
+#include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/RenderInterface.h"
+#include "FontDistanceFieldAtlas.h"
 #include "FontFaceHandleDefault.h"
+#include "FontProvider.h"
 #include "FreeTypeInterface.h"
 
 namespace Rml {
@@ -60,7 +64,17 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs)
 {
 	auto it = handles.find(size);
 	if (it != handles.end())
-		return it->second.get();
+	{
+		FontFaceHandleDefault* handle = it->second.get();
+		if (handle)
+		{
+			// The resources of the handle may have been released to stay within the memory budget, generate them again in that case.
+			const bool restore = handle->IsReleased();
+			handle->RestoreResources();
+			FontProvider::MarkHandleUsed(handle, restore);
+		}
+		return handle;
+	}
 
 	// See if this face has been released.
 	if (!face)
@@ -69,9 +83,23 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs)
 		return nullptr;
 	}
 
+	// The distance fields are kept until the font resources are released, even if the reference size is changed in the meantime, since
+	// existing handles refer to them.
+	const int distance_field_size = FontProvider::GetDistanceFieldSize();
+	if (distance_field_size > 0 && !distance_fields)
+	{
+		distance_fields = MakeUnique<FontFaceDistanceFields>();
+		distance_fields->reference_size = distance_field_size;
+
+		// When the render interface can render the distance fields directly, all sizes render their glyphs from the same textures.
+		RenderInterface* render_interface = ::Rml::GetRenderInterface();
+		if (render_interface && render_interface->SupportsDistanceFieldTextures())
+			distance_field_atlas = MakeUnique<FontDistanceFieldAtlas>();
+	}
+
 	// Construct and initialise the new handle.
 	auto handle = MakeUnique<FontFaceHandleDefault>();
-	if (!handle->Initialize(face, size, load_default_glyphs))
+	if (!handle->Initialize(face, size, load_default_glyphs, distance_field_size > 0 ? distance_fields.get() : nullptr, distance_field_atlas.get()))
 	{
 		handles[size] = nullptr;
 		return nullptr;
@@ -82,12 +110,25 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs)
 	// Save the new handle to the font face
 	handles[size] = std::move(handle);
 
+	FontProvider::MarkHandleUsed(result, true);
+
 	return result;
 }
 
 void FontFace::ReleaseFontResources()
 {
 	HandleMap().swap(handles);
+	distance_field_atlas.reset();
+	distance_fields.reset();
+}
+
+void FontFace::GetHandles(Vector<FontFaceHandleDefault*>& out_handles) const
+{
+	for (const auto& size_handle : handles)
+	{
+		if (size_handle.second)
+			out_handles.push_back(size_handle.second.get());
+	}
 }
 
 } // namespace Rml
@@ -34,6 +34,7 @@
 
 namespace Rml {
 
+class FontDistanceFieldAtlas;
 class FontFaceHandleDefault;
 
 /**
@@ -54,9 +55,12 @@ public:
 	/// @return The font handle.
 	FontFaceHandleDefault* GetHandle(int size, bool load_default_glyphs);
 
-	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
+	/// Releases resources owned by sized font faces, including their textures and rendered glyphs, and the glyph distance fields and their atlas.
 	void ReleaseFontResources();
 
+	/// Appends all the handles of this face to the given list.
+	void GetHandles(Vector<FontFaceHandleDefault*>& out_handles) const;
+
 private:
 	Style::FontStyle style;
 	Style::FontWeight weight;
@@ -65,6 +69,11 @@ private:
 	using HandleMap = UnorderedMap<int, UniquePtr<FontFaceHandleDefault>>;
 	HandleMap handles;
 
+	// Shared by all handles created while distance field rendering is enabled.
+	UniquePtr<FontFaceDistanceFields> distance_fields;
+	// The textures of the distance fields, when the render interface supports rendering them.
+	UniquePtr<FontDistanceFieldAtlas> distance_field_atlas;
+
 	FontFaceHandleFreetype face;
 };
 
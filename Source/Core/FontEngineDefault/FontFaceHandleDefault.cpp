@@ -30,39 +30,70 @@
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
 #include "../TextureLayout.h"
 #include "FontFaceLayer.h"
+#include "FontFileCache.h"
 #include "FontProvider.h"
 #include "FreeTypeInterface.h"
 #include <algorithm>
 
 namespace Rml {
 
-static constexpr char32_t KerningCache_AsciiSubsetBegin = 32;
-static constexpr char32_t KerningCache_AsciiSubsetLast = 126;
+static constexpr char32_t KerningTable_AsciiSubsetBegin = 32;
+static constexpr char32_t KerningTable_AsciiSubsetLast = 126;
+static constexpr int ShapedRunCache_Capacity = 512;
+static constexpr size_t KerningPairCache_Capacity = 4096;
 
-FontFaceHandleDefault::FontFaceHandleDefault()
+FontFaceHandleDefault::FontFaceHandleDefault() : shaped_run_cache(ShapedRunCache_Capacity)
 {
 	base_layer = nullptr;
 	metrics = {};
 	ft_face = 0;
 }
 
+static size_t GetGlyphMemoryUsage(const FontGlyph& glyph)
+{
+	// Glyphs borrowed from fallback fonts are accounted for by the handle owning them.
+	if (!glyph.bitmap_owned_data)
+		return 0;
+	return size_t(glyph.bitmap_dimensions.x) * size_t(glyph.bitmap_dimensions.y) * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+}
+
 FontFaceHandleDefault::~FontFaceHandleDefault()
 {
+	if (cache_key && has_uncached_glyphs)
+		FontFileCache::SaveGlyphs(cache_key, glyphs, metrics);
+
 	glyphs.clear();
 	layers.clear();
+
+	FontProvider::UpdateMemoryUsage(reported_memory_usage, 0);
 }
 
-bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs)
+bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool _load_default_glyphs,
+	FontFaceDistanceFields* _distance_fields, FontDistanceFieldAtlas* _distance_field_atlas)
 {
 	ft_face = face;
+	distance_fields = _distance_fields;
+	distance_field_atlas = (_distance_fields ? _distance_field_atlas : nullptr);
+	load_default_glyphs = _load_default_glyphs;
+	metrics.size = font_size;
 
 	RMLUI_ASSERTMSG(layer_configurations.empty(), "Initialize must only be called once.");
 
-	if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs))
+	// Glyphs generated from distance fields are not cached, since they depend on the distance field reference size.
+	if (FontFileCache::IsEnabled() && !distance_fields)
+	{
+		cache_key = FreeType::GetFaceFingerprint(ft_face);
+		if (cache_key)
+		{
+			const int32_t size_data = font_size;
+			cache_key = FontFileCache::HashData(reinterpret_cast<const byte*>(&size_data), sizeof(size_data), cache_key);
+		}
+	}
+
+	if (!LoadGlyphs())
 		return false;
 
 	has_kerning = FreeType::HasKerning(ft_face);
-	FillKerningPairCache();
 
 	// Generate the default layer and layer configuration.
 	base_layer = GetOrCreateLayer(nullptr);
@@ -71,38 +102,44 @@ bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_siz
 	return true;
 }
 
+bool FontFaceHandleDefault::LoadGlyphs()
+{
+	const int font_size = metrics.size;
+	if (!cache_key || !FontFileCache::LoadGlyphs(cache_key, glyphs, metrics) || metrics.size != font_size)
+	{
+		glyphs.clear();
+		if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs, distance_fields))
+			return false;
+		has_uncached_glyphs = true;
+	}
+
+	glyph_memory_usage = 0;
+	for (const auto& pair : glyphs)
+		glyph_memory_usage += GetGlyphMemoryUsage(pair.second);
+	UpdateMemoryUsage();
+
+	return true;
+}
+
 const FontMetrics& FontFaceHandleDefault::GetFontMetrics() const
 {
 	return metrics;
 }
 
-const FontGlyphMap& FontFaceHandleDefault::GetGlyphs() const
+const FontGlyphTable& FontFaceHandleDefault::GetGlyphs() const
 {
 	return glyphs;
 }
 
-int FontFaceHandleDefault::GetStringWidth(const String& string, float letter_spacing, Character prior_character)
+FontDistanceFieldAtlas* FontFaceHandleDefault::GetDistanceFieldAtlas() const
 {
-	int width = 0;
-	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
-	{
-		Character character = *it_string;
-
-		const FontGlyph* glyph = GetOrAppendGlyph(character);
-		if (!glyph)
-			continue;
-
-		// Adjust the cursor for the kerning between this character and the previous one.
-		width += GetKerning(prior_character, character);
-
-		// Adjust the cursor for this character's advance.
-		width += glyph->advance;
-		width += (int)letter_spacing;
-
-		prior_character = character;
-	}
+	return distance_field_atlas;
+}
 
-	return Math::Max(width, 0);
+int FontFaceHandleDefault::GetStringWidth(const String& string, float letter_spacing, Character prior_character)
+{
+	const ShapedRun& run = GetShapedRun(string, letter_spacing, prior_character);
+	return Math::Max(run.width, 0);
 }
 
 int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font_effects)
@@ -192,11 +229,13 @@ int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String&
 	const float opacity, const float letter_spacing, const int layer_configuration_index)
 {
 	int geometry_index = 0;
-	int line_width = 0;
 
 	RMLUI_ASSERT(layer_configuration_index >= 0);
 	RMLUI_ASSERT(layer_configuration_index < (int)layer_configurations.size());
 
+	// Shape the string first, so that any new glyphs are added to the layers before their geometry is generated.
+	const ShapedRun& run = GetShapedRun(string, letter_spacing, Character::Null);
+
 	UpdateLayersOnDirty();
 
 	// Fetch the requested configuration and generate the geometry for each one.
@@ -236,32 +275,16 @@ int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String&
 		for (int tex_index = 0; tex_index < num_textures; ++tex_index)
 			geometry[geometry_index + tex_index].SetTexture(layer->GetTexture(tex_index));
 
-		line_width = 0;
-		Character prior_character = Character::Null;
+		geometry[geometry_index].GetIndices().reserve(run.glyphs.size() * 6);
+		geometry[geometry_index].GetVertices().reserve(run.glyphs.size() * 4);
 
-		geometry[geometry_index].GetIndices().reserve(string.size() * 6);
-		geometry[geometry_index].GetVertices().reserve(string.size() * 4);
+		// Use white vertex colors on RGB glyphs.
+		const Colourb color_glyph_colour = (layer == base_layer ? Colourb(255, layer_colour.alpha) : layer_colour);
 
-		for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
+		for (const ShapedGlyph& glyph : run.glyphs)
 		{
-			Character character = *it_string;
-
-			const FontGlyph* glyph = GetOrAppendGlyph(character);
-			if (!glyph)
-				continue;
-
-			// Adjust the cursor for the kerning between this character and the previous one.
-			line_width += GetKerning(prior_character, character);
-
-			// Use white vertex colors on RGB glyphs.
-			const Colourb glyph_color =
-				(layer == base_layer && glyph->color_format == ColorFormat::RGBA8 ? Colourb(255, layer_colour.alpha) : layer_colour);
-
-			layer->GenerateGeometry(&geometry[geometry_index], character, Vector2f(position.x + line_width, position.y), glyph_color);
-
-			line_width += glyph->advance;
-			line_width += (int)letter_spacing;
-			prior_character = character;
+			layer->GenerateGeometry(&geometry[geometry_index], glyph.character, Vector2f(position.x + glyph.offset, position.y),
+				glyph.is_color ? color_glyph_colour : layer_colour);
 		}
 
 		geometry_index += num_textures;
@@ -270,7 +293,7 @@ int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String&
 	// Cull any excess geometry from a previous generation.
 	geometry.resize(geometry_index);
 
-	return Math::Max(line_width, 0);
+	return Math::Max(run.width, 0);
 }
 
 bool FontFaceHandleDefault::UpdateLayersOnDirty()
@@ -297,39 +320,116 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 	return result;
 }
 
+void FontFaceHandleDefault::AppendGlyphToLayers(Character character)
+{
+	// The glyph will be included when the layers are regenerated.
+	if (is_layers_dirty)
+		return;
+
+	auto it_glyph = glyphs.find(character);
+	RMLUI_ASSERT(it_glyph != glyphs.end());
+
+	// Like when regenerating, the layers need to be updated in the order in which they were created, so that the layers we clone already
+	// contain the new glyph.
+	for (auto& pair : layers)
+	{
+		bool clone_glyph_origins = true;
+		FontFaceLayer* clone = GetCloneLayer(pair.layer.get(), clone_glyph_origins);
+
+		if (!pair.layer->AppendGlyph(this, character, it_glyph->second, clone, clone_glyph_origins))
+		{
+			is_layers_dirty = true;
+			break;
+		}
+	}
+
+	UpdateMemoryUsage();
+}
+
 int FontFaceHandleDefault::GetVersion() const
 {
 	return version;
 }
 
-bool FontFaceHandleDefault::AppendGlyph(Character character)
+size_t FontFaceHandleDefault::GetMemoryUsage() const
 {
-	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs);
+	size_t result = kerning_ascii_table.size() * sizeof(KerningIntType) + glyph_memory_usage;
+
+	for (const EffectLayerPair& pair : layers)
+		result += pair.layer->GetTextureMemoryUsage();
+
 	return result;
 }
 
-void FontFaceHandleDefault::FillKerningPairCache()
+void FontFaceHandleDefault::ReleaseResources()
 {
-	if (!has_kerning)
+	if (is_released)
 		return;
 
-	for (char32_t i = KerningCache_AsciiSubsetBegin; i <= KerningCache_AsciiSubsetLast; i++)
+	if (cache_key && has_uncached_glyphs)
 	{
-		for (char32_t j = KerningCache_AsciiSubsetBegin; j <= KerningCache_AsciiSubsetLast; j++)
-		{
-			const bool first_iteration = (i == KerningCache_AsciiSubsetBegin && j == KerningCache_AsciiSubsetBegin);
+		FontFileCache::SaveGlyphs(cache_key, glyphs, metrics);
+		has_uncached_glyphs = false;
+	}
 
-			// Fetch the kerning from the font face. Submit zero font size on subsequent iterations for performance reasons.
-			const int kerning = FreeType::GetKerning(ft_face, first_iteration ? metrics.size : 0, Character(i), Character(j));
-			if (kerning != 0)
-			{
-				kerning_pair_cache.emplace(AsciiPair((i << 8) | j), KerningIntType(kerning));
-			}
-		}
+	glyphs = FontGlyphTable();
+	glyph_memory_usage = 0;
+	Vector<KerningIntType>().swap(kerning_ascii_table);
+	KerningPairs().swap(kerning_pair_cache);
+	shaped_run_cache.Clear();
+	uncached_run = ShapedRun();
+
+	// Regenerating the layers without any glyphs releases their textures, while the layers themselves are kept since they are referenced
+	// by the layer configurations.
+	for (auto& pair : layers)
+		GenerateLayer(pair.layer.get());
+
+	is_layers_dirty = false;
+	is_released = true;
+	++version;
+
+	UpdateMemoryUsage();
+}
+
+void FontFaceHandleDefault::RestoreResources()
+{
+	if (!is_released)
+		return;
+
+	is_released = false;
+	if (LoadGlyphs())
+		is_layers_dirty = true;
+}
+
+bool FontFaceHandleDefault::IsReleased() const
+{
+	return is_released;
+}
+
+void FontFaceHandleDefault::SetLastUsed(uint64_t use_counter)
+{
+	last_used = use_counter;
+}
+
+uint64_t FontFaceHandleDefault::GetLastUsed() const
+{
+	return last_used;
+}
+
+bool FontFaceHandleDefault::AppendGlyph(Character character)
+{
+	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs, distance_fields);
+	if (result)
+	{
+		has_uncached_glyphs = true;
+		auto it_glyph = glyphs.find(character);
+		if (it_glyph != glyphs.end())
+			glyph_memory_usage += GetGlyphMemoryUsage(it_glyph->second);
 	}
+	return result;
 }
 
-int FontFaceHandleDefault::GetKerning(Character lhs, Character rhs) const
+int FontFaceHandleDefault::GetKerning(Character lhs, Character rhs)
 {
 	static_assert(' ' == 32, "Only ASCII/UTF8 character set supported.");
 
@@ -337,24 +437,33 @@ int FontFaceHandleDefault::GetKerning(Character lhs, Character rhs) const
 	if (!has_kerning || char32_t(lhs) < ' ' || char32_t(rhs) < ' ')
 		return 0;
 
-	// See if the kerning pair has been cached.
-	const bool lhs_in_cache = (char32_t(lhs) >= KerningCache_AsciiSubsetBegin && char32_t(lhs) <= KerningCache_AsciiSubsetLast);
-	const bool rhs_in_cache = (char32_t(rhs) >= KerningCache_AsciiSubsetBegin && char32_t(rhs) <= KerningCache_AsciiSubsetLast);
+	// Look up the kerning pair directly for the ASCII subset, the table is filled the first time it is needed.
+	const bool lhs_in_table = (char32_t(lhs) >= KerningTable_AsciiSubsetBegin && char32_t(lhs) <= KerningTable_AsciiSubsetLast);
+	const bool rhs_in_table = (char32_t(rhs) >= KerningTable_AsciiSubsetBegin && char32_t(rhs) <= KerningTable_AsciiSubsetLast);
 
-	if (lhs_in_cache && rhs_in_cache)
+	if (lhs_in_table && rhs_in_table)
 	{
-		const auto it = kerning_pair_cache.find(AsciiPair((int(lhs) << 8) | int(rhs)));
-
-		if (it != kerning_pair_cache.end())
+		constexpr int table_width = int(KerningTable_AsciiSubsetLast - KerningTable_AsciiSubsetBegin) + 1;
+		if (kerning_ascii_table.empty())
 		{
-			return it->second;
+			FreeType::GetKerningTable(ft_face, metrics.size, Character(KerningTable_AsciiSubsetBegin), Character(KerningTable_AsciiSubsetLast),
+				kerning_ascii_table);
+			UpdateMemoryUsage();
 		}
 
-		return 0;
+		return kerning_ascii_table[(char32_t(lhs) - KerningTable_AsciiSubsetBegin) * table_width + (char32_t(rhs) - KerningTable_AsciiSubsetBegin)];
 	}
 
-	// Fetch it from the font face instead.
+	// See if the kerning pair has been cached, otherwise fetch it from the font face.
+	const KerningPair pair = (KerningPair(lhs) << 32) | KerningPair(rhs);
+	auto it = kerning_pair_cache.find(pair);
+	if (it != kerning_pair_cache.end())
+		return it->second;
+
 	const int result = FreeType::GetKerning(ft_face, metrics.size, lhs, rhs);
+	if (kerning_pair_cache.size() >= KerningPairCache_Capacity)
+		kerning_pair_cache.clear();
+	kerning_pair_cache.emplace(pair, KerningIntType(result));
 	return result;
 }
 
@@ -378,27 +487,17 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 				return nullptr;
 			}
 
-			is_layers_dirty = true;
+			AppendGlyphToLayers(character);
 		}
 		else if (look_in_fallback_fonts)
 		{
-			const int num_fallback_faces = FontProvider::CountFallbackFontFaces();
-			for (int i = 0; i < num_fallback_faces; i++)
+			if (const FontGlyph* glyph = GetFallbackGlyph(character))
 			{
-				FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(i, metrics.size);
-				if (!fallback_face || fallback_face == this)
-					continue;
-
-				const FontGlyph* glyph = fallback_face->GetOrAppendGlyph(character, false);
-				if (glyph)
-				{
-					// Insert the new glyph into our own set of glyphs
-					auto pair = glyphs.emplace(character, glyph->WeakCopy());
-					it_glyph = pair.first;
-					if (pair.second)
-						is_layers_dirty = true;
-					break;
-				}
+				// Insert the new glyph into our own set of glyphs
+				auto pair = glyphs.emplace(character, glyph->WeakCopy());
+				it_glyph = pair.first;
+				if (pair.second)
+					AppendGlyphToLayers(character);
 			}
 
 			// If we still have not found a glyph, use the replacement character.
@@ -420,6 +519,90 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 	return glyph;
 }
 
+const FontGlyph* FontFaceHandleDefault::GetFallbackGlyph(Character character)
+{
+	// Only search through all the fallback font faces the first time a character is encountered, by any handle.
+	int face_index = -1;
+	if (FontProvider::FindFallbackFontFaceIndex(character, face_index))
+	{
+		if (face_index < 0)
+			return nullptr;
+
+		FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(face_index, metrics.size);
+		if (!fallback_face || fallback_face == this)
+			return nullptr;
+
+		return fallback_face->GetOrAppendGlyph(character, false);
+	}
+
+	const FontGlyph* glyph = nullptr;
+	const int num_fallback_faces = FontProvider::CountFallbackFontFaces();
+	for (int i = 0; i < num_fallback_faces && !glyph; i++)
+	{
+		FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(i, metrics.size);
+		if (!fallback_face || fallback_face == this)
+			continue;
+
+		glyph = fallback_face->GetOrAppendGlyph(character, false);
+		if (glyph)
+			face_index = i;
+	}
+
+	FontProvider::SetFallbackFontFaceIndex(character, face_index);
+	return glyph;
+}
+
+const ShapedRun& FontFaceHandleDefault::GetShapedRun(const String& string, const float letter_spacing, const Character run_prior_character)
+{
+	RestoreResources();
+
+	if (const ShapedRun* cached_run = shaped_run_cache.Find(string, letter_spacing, run_prior_character))
+		return *cached_run;
+
+	ShapedRun& run = uncached_run;
+	run.glyphs.clear();
+	run.width = 0;
+
+	// Runs which are missing glyphs are not cached, since a fallback font containing them may be added later.
+	bool cacheable = true;
+
+	int width = 0;
+	Character prior_character = run_prior_character;
+	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
+	{
+		const Character code_point = *it_string;
+		Character character = code_point;
+
+		const FontGlyph* glyph = GetOrAppendGlyph(character);
+		if (character != code_point || (!glyph && (char32_t)code_point >= (char32_t)' '))
+			cacheable = false;
+		if (!glyph)
+			continue;
+
+		// Adjust the cursor for the kerning between this character and the previous one.
+		width += GetKerning(prior_character, character);
+
+		run.glyphs.push_back(ShapedGlyph{character, width, glyph->color_format == ColorFormat::RGBA8});
+
+		// Adjust the cursor for this character's advance.
+		width += glyph->advance;
+		width += (int)letter_spacing;
+
+		prior_character = character;
+	}
+
+	run.width = width;
+
+	if (!cacheable)
+		return run;
+
+	// Move the glyphs into the cache, the buffer of any evicted run is left in the uncached run for reuse.
+	ShapedRun& cached_run = shaped_run_cache.Insert(string, letter_spacing, run_prior_character);
+	std::swap(cached_run.glyphs, run.glyphs);
+	cached_run.width = run.width;
+	return cached_run;
+}
+
 FontFaceLayer* FontFaceHandleDefault::GetOrCreateLayer(const SharedPtr<const FontEffect>& font_effect)
 {
 	// Search for the font effect layer first, it may have been instanced before as part of a different configuration.
@@ -452,33 +635,51 @@ bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer)
 	}
 	else
 	{
-		// Determine which, if any, layer the new layer should copy its geometry and textures from.
-		FontFaceLayer* clone = nullptr;
 		bool clone_glyph_origins = true;
-		String generation_key;
-		size_t fingerprint = font_effect->GetFingerprint();
-
-		if (!font_effect->HasUniqueTexture())
-		{
-			clone = base_layer;
-			clone_glyph_origins = false;
-		}
-		else
-		{
-			auto cache_iterator = layer_cache.find(fingerprint);
-			if (cache_iterator != layer_cache.end() && cache_iterator->second != layer)
-				clone = cache_iterator->second;
-		}
+		FontFaceLayer* clone = GetCloneLayer(layer, clone_glyph_origins);
 
 		// Create a new layer.
 		result = layer->Generate(this, clone, clone_glyph_origins);
 
 		// Cache the layer in the layer cache if it generated its own textures (ie, didn't clone).
 		if (!clone)
-			layer_cache[fingerprint] = layer;
+			layer_cache[font_effect->GetFingerprint()] = layer;
 	}
 
+	UpdateMemoryUsage();
+
 	return result;
 }
 
+FontFaceLayer* FontFaceHandleDefault::GetCloneLayer(const FontFaceLayer* layer, bool& clone_glyph_origins) const
+{
+	clone_glyph_origins = true;
+
+	const FontEffect* font_effect = layer->GetFontEffect();
+	if (!font_effect)
+		return nullptr;
+
+	if (!font_effect->HasUniqueTexture())
+	{
+		clone_glyph_origins = false;
+		return base_layer;
+	}
+
+	auto cache_iterator = layer_cache.find(font_effect->GetFingerprint());
+	if (cache_iterator != layer_cache.end() && cache_iterator->second != layer)
+		return cache_iterator->second;
+
+	return nullptr;
+}
+
+void FontFaceHandleDefault::UpdateMemoryUsage()
+{
+	const size_t memory_usage = GetMemoryUsage();
+	if (memory_usage != reported_memory_usage)
+	{
+		FontProvider::UpdateMemoryUsage(reported_memory_usage, memory_usage);
+		reported_memory_usage = memory_usage;
+	}
+}
+
 } // namespace Rml
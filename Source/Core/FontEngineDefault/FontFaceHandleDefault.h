@@ -36,9 +36,11 @@
 #include "../../../Include/RmlUi/Core/Texture.h"
 #include "../../../Include/RmlUi/Core/Traits.h"
 #include "FontTypes.h"
+#include "ShapedRunCache.h"
 
 namespace Rml {
 
+class FontDistanceFieldAtlas;
 class FontFaceLayer;
 
 /**
@@ -50,11 +52,15 @@ public:
 	FontFaceHandleDefault();
 	~FontFaceHandleDefault();
 
-	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs);
+	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, FontFaceDistanceFields* distance_fields = nullptr,
+		FontDistanceFieldAtlas* distance_field_atlas = nullptr);
 
 	const FontMetrics& GetFontMetrics() const;
 
-	const FontGlyphMap& GetGlyphs() const;
+	const FontGlyphTable& GetGlyphs() const;
+
+	/// Returns the atlas the base layer renders glyphs with distance fields from, or nullptr if each size has its own glyph textures.
+	FontDistanceFieldAtlas* GetDistanceFieldAtlas() const;
 
 	/// Returns the width a string will take up if rendered with this handle.
 	/// @param[in] string The string to measure.
@@ -87,26 +93,51 @@ public:
 	int GenerateString(GeometryList& geometry, const String& string, Vector2f position, Colourb colour, float opacity, float letter_spacing,
 		int layer_configuration = 0);
 
-	/// Version is changed whenever the layers are dirtied, requiring regeneration of string geometry.
+	/// Version is changed whenever the layers are regenerated, requiring regeneration of string geometry. New glyphs are appended to the
+	/// existing layers where possible, which leaves the geometry of strings already generated valid and does not change the version.
 	int GetVersion() const;
 
+	/// Returns the number of bytes used by the glyph bitmaps, kerning table, and layer textures of this handle.
+	size_t GetMemoryUsage() const;
+	/// Releases the glyphs and layer textures of this handle to free up memory, while keeping the handle and its layer configurations valid.
+	/// They are generated again when the handle is next used to measure or generate a string. Changes the version.
+	void ReleaseResources();
+	/// Generates the glyphs again after the resources have been released, otherwise does nothing.
+	void RestoreResources();
+	/// Returns true if the resources of this handle have been released and not yet restored.
+	bool IsReleased() const;
+
+	/// Sets the time of last use, as a strictly increasing counter, for evicting the least recently used handles.
+	void SetLastUsed(uint64_t use_counter);
+	uint64_t GetLastUsed() const;
+
 private:
+	// Load the initial glyphs and metrics, from the font file cache if available.
+	bool LoadGlyphs();
+
 	// Build and append glyph to 'glyphs'
 	bool AppendGlyph(Character character);
 
-	// Build a kerning cache for common characters.
-	void FillKerningPairCache();
-
 	// Return the kerning for a character pair.
-	int GetKerning(Character lhs, Character rhs) const;
+	int GetKerning(Character lhs, Character rhs);
+
+	/// Retrieve the glyphs and their positions for the given string, shaping it and appending any new glyphs if not already cached.
+	/// @return The shaped run, only valid until the next call.
+	const ShapedRun& GetShapedRun(const String& string, float letter_spacing, Character prior_character);
 
 	/// Retrieve a glyph from the given code point, building and appending a new glyph if not already built.
 	/// @param[in-out] character  The character, can be changed e.g. to the replacement character if no glyph is found.
 	/// @param[in] look_in_fallback_fonts  Look for the glyph in fallback fonts if not found locally, adding it to our glyphs.
-	/// @return The font glyph for the returned code point.
+	/// @return The font glyph for the returned code point, only valid until the next glyph is appended to this handle.
 	const FontGlyph* GetOrAppendGlyph(Character& character, bool look_in_fallback_fonts = true);
 
-	// Regenerate layers if dirty, such as after adding new glyphs.
+	// Retrieve a glyph from the first fallback font face containing the given code point, or nullptr if none of them do.
+	const FontGlyph* GetFallbackGlyph(Character character);
+
+	// Add a new glyph to all the layers, or dirty the layers if that fails.
+	void AppendGlyphToLayers(Character character);
+
+	// Regenerate layers if dirty, such as after failing to add new glyphs.
 	bool UpdateLayersOnDirty();
 
 	// Create a new layer from the given font effect if it does not already exist.
@@ -115,7 +146,13 @@ private:
 	// (Re-)generate a layer in this font face handle.
 	bool GenerateLayer(FontFaceLayer* layer);
 
-	FontGlyphMap glyphs;
+	// Determine which, if any, layer the given layer should copy its geometry and textures from.
+	FontFaceLayer* GetCloneLayer(const FontFaceLayer* layer, bool& clone_glyph_origins) const;
+
+	// Report any change in memory usage to the font provider, after the glyphs, kerning table, or layers have changed.
+	void UpdateMemoryUsage();
+
+	FontGlyphTable glyphs;
 
 	struct EffectLayerPair {
 		const FontEffect* font_effect;
@@ -132,15 +169,29 @@ private:
 	// Each font layer that generated geometry or textures, indexed by the font-effect's fingerprint key.
 	FontLayerCache layer_cache;
 
-	// Pre-cache kerning pairs for some ascii subset of all characters.
-	using AsciiPair = std::uint16_t;
+	// Kerning of all pairs in the ASCII subset of characters, filled on first use.
 	using KerningIntType = std::int16_t;
-	using KerningPairs = UnorderedMap<AsciiPair, KerningIntType>;
+	Vector<KerningIntType> kerning_ascii_table;
+	// Kerning of any other pairs, cached as they are encountered. Cleared once it reaches its capacity.
+	using KerningPair = std::uint64_t;
+	using KerningPairs = UnorderedMap<KerningPair, KerningIntType>;
 	KerningPairs kerning_pair_cache;
 
+	// Recently shaped strings, so that measuring and generating the same text again only requires a lookup.
+	ShapedRunCache shaped_run_cache;
+	// Holds the most recent run which could not be cached.
+	ShapedRun uncached_run;
+
 	bool has_kerning = false;
 	bool is_layers_dirty = false;
+	bool load_default_glyphs = true;
+	bool is_released = false;
 	int version = 0;
+	uint64_t last_used = 0;
+
+	// The number of bytes used by the bitmaps owned by our glyphs, and the total memory usage last reported to the font provider.
+	size_t glyph_memory_usage = 0;
+	size_t reported_memory_usage = 0;
 
 	// All configurations currently in use on this handle. New configurations will be generated as required.
 	LayerConfigurationList layer_configurations;
@@ -148,6 +199,16 @@ private:
 	FontMetrics metrics;
 
 	FontFaceHandleFreetype ft_face;
+
+	// Glyph bitmaps are generated from these when distance field rendering is enabled, otherwise nullptr.
+	FontFaceDistanceFields* distance_fields = nullptr;
+	// Shared by all sizes of the font face when the render interface supports distance field textures, otherwise nullptr.
+	FontDistanceFieldAtlas* distance_field_atlas = nullptr;
+
+	// Identifies the glyphs of this handle in the font file cache, or zero when not cached.
+	size_t cache_key = 0;
+	// Set when glyphs have been built since they were last loaded from the cache.
+	bool has_uncached_glyphs = false;
 };
 
 } // namespace Rml
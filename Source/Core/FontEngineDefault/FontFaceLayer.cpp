@@ -29,7 +29,13 @@
 #include "FontFaceLayer.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/RenderInterface.h"
+#include "../TextureLayout.h"
+#include "../WorkerPool.h"
+#include "FontDistanceFieldAtlas.h"
 #include "FontFaceHandleDefault.h"
+#include "FontFileCache.h"
+#include "FontProvider.h"
+#include <atomic>
 #include <string.h>
 
 namespace Rml {
@@ -43,28 +49,31 @@ FontFaceLayer::FontFaceLayer(const SharedPtr<const FontEffect>& _effect) : colou
 
 FontFaceLayer::~FontFaceLayer() {}
 
+static constexpr int max_texture_dimensions = 1024;
+static constexpr int min_appended_texture_dimensions = 256;
+
 bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone, bool clone_glyph_origins)
 {
 	// Clear the old layout if it exists.
 	{
-		// @performance: We could be much smarter about this, e.g. such as adding new glyphs to the existing texture layout and textures.
-		// Right now we re-generate the whole thing, including textures.
-		texture_layout = TextureLayout{};
 		character_boxes.clear();
 		textures.clear();
+		texture_pages.clear();
+		distance_field_atlas = nullptr;
 	}
 
-	const FontGlyphMap& glyphs = handle->GetGlyphs();
+	const FontGlyphTable& glyphs = handle->GetGlyphs();
 
 	// Generate the new layout.
 	if (clone)
 	{
 		// Clone the geometry and textures from the clone layer.
 		character_boxes = clone->character_boxes;
+		distance_field_atlas = clone->distance_field_atlas;
 
 		// Copy the cloned layer's textures.
 		for (size_t i = 0; i < clone->textures.size(); ++i)
-			textures.push_back(clone->textures[i]);
+			textures.push_back(MakeUnique<Texture>(*clone->textures[i]));
 
 		// Request the effect (if we have one) and adjust the origins as appropriate.
 		if (effect && !clone_glyph_origins)
@@ -83,19 +92,19 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 				}
 
 				TextureBox& box = it->second;
-
-				Vector2i glyph_origin = Vector2i(box.origin);
-				Vector2i glyph_dimensions = Vector2i(box.dimensions);
-
-				if (effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
-					box.origin = Vector2f(glyph_origin);
-				else
+				if (!ApplyEffectOrigin(glyph, box))
 					box.texture_index = -1;
 			}
 		}
 	}
 	else
 	{
+		TextureLayout texture_layout;
+
+		// Only the base layer renders from the distance field atlas, effects are generated for each font size.
+		if (!effect)
+			distance_field_atlas = handle->GetDistanceFieldAtlas();
+
 		// Initialise the texture layout for the glyphs.
 		character_boxes.reserve(glyphs.size());
 		for (auto& pair : glyphs)
@@ -103,6 +112,13 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 			Character character = pair.first;
 			const FontGlyph& glyph = pair.second;
 
+			TextureBox atlas_box;
+			if (PlaceInDistanceFieldAtlas(glyph, atlas_box))
+			{
+				character_boxes[character] = atlas_box;
+				continue;
+			}
+
 			Vector2i glyph_origin(0, 0);
 			Vector2i glyph_dimensions = glyph.bitmap_dimensions;
 
@@ -125,92 +141,242 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 			texture_layout.AddRectangle((int)character, glyph_dimensions);
 		}
 
-		constexpr int max_texture_dimensions = 1024;
-
-		// Generate the texture layout; this will position the glyph rectangles efficiently and
-		// allocate the texture data ready for writing.
-		if (!texture_layout.GenerateLayout(max_texture_dimensions))
+		// Generate the texture layout; this will position the glyph rectangles efficiently.
+		if (!texture_layout.GenerateLayout(max_texture_dimensions, TextureLayoutPacking::Skyline))
 			return false;
 
-		// Iterate over each rectangle in the layout, copying the glyph data into the rectangle as
-		// appropriate and generating geometry.
+		texture_pages.resize(texture_layout.GetNumTextures());
+		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+		{
+			texture_pages[i].dimensions = texture_layout.GetTexture(i).GetDimensions();
+			texture_pages[i].skyline = TextureLayoutSkyline(texture_pages[i].dimensions);
+		}
+
+		// Iterate over each rectangle in the layout, positioning the glyph boxes and generating their texture coordinates.
 		for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
 		{
 			TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-			const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
+			TexturePage& page = texture_pages[rectangle.GetTextureIndex()];
 			Character character = (Character)rectangle.GetId();
 			RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
 			TextureBox& box = character_boxes[character];
 
-			// Set the character's texture index.
+			// Set the character's texture index and position.
 			box.texture_index = rectangle.GetTextureIndex();
+			box.position = rectangle.GetPosition();
 
 			// Generate the character's texture coordinates.
-			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
-			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
-			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
-			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
-		}
+			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(page.dimensions.x);
+			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(page.dimensions.y);
+			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(page.dimensions.x);
+			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(page.dimensions.y);
 
-		const FontEffect* effect_ptr = effect.get();
-		const int handle_version = handle->GetVersion();
+			// Glyphs appended later are placed on top of the glyphs in the layout.
+			page.skyline.Reserve(rectangle.GetPosition(), rectangle.GetDimensions());
+		}
 
 		// Generate the textures.
-		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+		for (int i = 0; i < (int)texture_pages.size(); ++i)
 		{
-			const int texture_id = i;
-
-			TextureCallback texture_callback = [handle, effect_ptr, texture_id, handle_version](RenderInterface* render_interface,
-												   const String& /*name*/, TextureHandle& out_texture_handle, Vector2i& out_dimensions) -> bool {
-				UniquePtr<const byte[]> data;
-				if (!handle->GenerateLayerTexture(data, out_dimensions, effect_ptr, texture_id, handle_version) || !data)
-					return false;
-				if (!render_interface->GenerateTexture(out_texture_handle, data.get(), out_dimensions))
-					return false;
-				return true;
-			};
-
-			Texture texture;
-			texture.Set("font-face-layer", texture_callback);
-			textures.push_back(texture);
+			textures.push_back(MakeUnique<Texture>());
+			SetTextureCallback(handle, i);
 		}
 	}
 
 	return true;
 }
 
-bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs)
+bool FontFaceLayer::AppendGlyph(const FontFaceHandleDefault* handle, const Character character, const FontGlyph& glyph, const FontFaceLayer* clone,
+	bool clone_glyph_origins)
 {
-	if (texture_id < 0 || texture_id > texture_layout.GetNumTextures())
-		return false;
+	if (clone)
+	{
+		auto it = clone->character_boxes.find(character);
+		if (it != clone->character_boxes.end())
+		{
+			TextureBox box = it->second;
+
+			if (effect && !clone_glyph_origins && !ApplyEffectOrigin(glyph, box))
+				box.texture_index = -1;
+
+			character_boxes[character] = box;
+		}
+
+		// Pick up any textures the cloned layer added or regenerated for the glyph.
+		for (size_t i = 0; i < clone->textures.size(); ++i)
+		{
+			if (i < textures.size())
+				*textures[i] = *clone->textures[i];
+			else
+				textures.push_back(MakeUnique<Texture>(*clone->textures[i]));
+		}
+
+		return true;
+	}
+
+	Vector2i glyph_origin(0, 0);
+	Vector2i glyph_dimensions = glyph.bitmap_dimensions;
+
+	// Adjust glyph origin / dimensions for the font effect.
+	if (effect)
+	{
+		if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+			return true;
+	}
+
+	TextureBox box;
+	if (PlaceInDistanceFieldAtlas(glyph, box))
+	{
+		character_boxes[character] = box;
+		return true;
+	}
 
-	// Generate the texture data.
-	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture();
-	texture_dimensions = texture_layout.GetTexture(texture_id).GetDimensions();
+	box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+	box.dimensions = Vector2f(glyph_dimensions);
+
+	// Place the glyph in the first texture with room for it, or else start a new texture.
+	for (int i = 0; i < (int)texture_pages.size(); ++i)
+	{
+		if (texture_pages[i].skyline.Allocate(glyph_dimensions, box.position))
+		{
+			box.texture_index = i;
+			break;
+		}
+	}
 
-	for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+	if (box.texture_index < 0)
 	{
-		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-		Character character = (Character)rectangle.GetId();
-		RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
+		const int glyph_size = Math::Max(glyph_dimensions.x, glyph_dimensions.y) + 2;
+		if (glyph_size > max_texture_dimensions)
+			return false;
+
+		TexturePage page;
+		page.dimensions = Vector2i(Math::Max(Math::ToPowerOfTwo(glyph_size), min_appended_texture_dimensions));
+		page.skyline = TextureLayoutSkyline(page.dimensions);
+		if (!page.skyline.Allocate(glyph_dimensions, box.position))
+			return false;
+
+		box.texture_index = (int)texture_pages.size();
+		texture_pages.push_back(std::move(page));
+		textures.push_back(MakeUnique<Texture>());
+	}
 
-		TextureBox& box = character_boxes[character];
+	TexturePage& page = texture_pages[box.texture_index];
+	page.has_appended_glyphs = true;
+	page.appended_characters.push_back(character);
 
-		if (box.texture_index != texture_id)
-			continue;
+	const Vector2f page_dimensions = Vector2f(page.dimensions);
+	box.texcoords[0] = Vector2f(box.position) / page_dimensions;
+	box.texcoords[1] = Vector2f(box.position + glyph_dimensions) / page_dimensions;
 
-		auto it = glyphs.find((Character)rectangle.GetId());
+	character_boxes[character] = box;
+
+	// Only the texture holding the new glyph needs to be regenerated, the other textures and all existing texture coordinates remain valid.
+	// The texture is generated on its next use, so that all glyphs appended until then are generated together.
+	SetTextureCallback(handle, box.texture_index);
+
+	return true;
+}
+
+bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphTable& glyphs)
+{
+	if (texture_id < 0 || texture_id >= (int)texture_pages.size())
+		return false;
+
+	TexturePage& page = texture_pages[texture_id];
+	texture_dimensions = page.dimensions;
+	if (texture_dimensions.x <= 0 || texture_dimensions.y <= 0)
+		return false;
+
+	const int texture_stride = texture_dimensions.x * 4;
+	const size_t texture_size = size_t(texture_stride) * size_t(texture_dimensions.y);
+
+	// Once generated, pages with appended glyphs are kept so that only the glyphs appended since then need to be generated into them.
+	const bool generate_appended_only = (page.data != nullptr);
+
+	// Gather the glyphs to generate in this texture.
+	struct TextureGlyph {
+		const TextureBox* box;
+		const FontGlyph* glyph;
+	};
+	Vector<TextureGlyph> texture_glyphs;
+	auto AddTextureGlyph = [&](Character character, const TextureBox& box) {
+		if (box.texture_index != texture_id || box.distance_field)
+			return;
+
+		auto it = glyphs.find(character);
 		if (it == glyphs.end())
-			continue;
+			return;
+
+		texture_glyphs.push_back(TextureGlyph{&box, &it->second});
+	};
+
+	if (generate_appended_only)
+	{
+		for (Character character : page.appended_characters)
+		{
+			auto it = character_boxes.find(character);
+			if (it != character_boxes.end())
+				AddTextureGlyph(character, it->second);
+		}
+	}
+	else
+	{
+		for (const auto& pair : character_boxes)
+			AddTextureGlyph(pair.first, pair.second);
+	}
+	page.appended_characters.clear();
+
+	// Effect textures can be expensive to generate, so they are looked up in the font file cache first. They are identified by their
+	// contents, that is the effect and the glyph bitmaps and their placement, so that glyphs borrowed from fallback fonts are also covered.
+	// Pages that glyphs have been appended to are regenerated for every new glyph, these are only cached with the next full layer generation.
+	size_t cache_key = 0;
+	if (effect && effect->GetFingerprint() != 0 && !page.has_appended_glyphs && FontFileCache::IsEnabled())
+	{
+		const byte* texture_dimensions_data = reinterpret_cast<const byte*>(&texture_dimensions);
+		cache_key = FontFileCache::HashData(texture_dimensions_data, sizeof(texture_dimensions), effect->GetFingerprint());
+		for (const TextureGlyph& texture_glyph : texture_glyphs)
+		{
+			const TextureBox& box = *texture_glyph.box;
+			const FontGlyph& glyph = *texture_glyph.glyph;
+			const int glyph_properties[] = {box.position.x, box.position.y, int(box.dimensions.x), int(box.dimensions.y), glyph.dimensions.x,
+				glyph.dimensions.y, glyph.bearing.x, glyph.bearing.y, glyph.bitmap_dimensions.x, glyph.bitmap_dimensions.y, int(glyph.color_format)};
+			cache_key = FontFileCache::HashData(reinterpret_cast<const byte*>(glyph_properties), sizeof(glyph_properties), cache_key);
+
+			if (glyph.bitmap_data)
+			{
+				const int num_bytes = glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+				cache_key = FontFileCache::HashData(glyph.bitmap_data, (size_t)num_bytes, cache_key);
+			}
+		}
+
+		Vector2i cached_dimensions;
+		if (FontFileCache::LoadLayerTexture(cache_key, texture_data, cached_dimensions) && cached_dimensions == texture_dimensions)
+			return true;
+	}
 
-		const FontGlyph& glyph = it->second;
+	// Generate the texture data, initialised to transparent white. Appended glyphs are placed in the free area of the page, which is still
+	// transparent white in the kept copy.
+	UniquePtr<byte[]> data;
+	if (generate_appended_only)
+	{
+		data = std::move(page.data);
+	}
+	else
+	{
+		data.reset(new byte[texture_size]);
+		for (int i = 0; i < texture_dimensions.x * texture_dimensions.y; i++)
+			((unsigned int*)(data.get()))[i] = 0x00ffffff;
+	}
+
+	auto GenerateGlyph = [&](const TextureBox& box, const FontGlyph& glyph) {
+		byte* destination = data.get() + box.position.y * texture_stride + box.position.x * 4;
 
 		if (effect == nullptr)
 		{
 			// Copy the glyph's bitmap data into its allocated texture.
 			if (glyph.bitmap_data)
 			{
-				byte* destination = rectangle.GetTextureData();
 				const byte* source = glyph.bitmap_data;
 				const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
 
@@ -231,17 +397,109 @@ bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vecto
 					break;
 					}
 
-					destination += rectangle.GetTextureStride();
+					destination += texture_stride;
 					source += num_bytes_per_line;
 				}
 			}
 		}
 		else
 		{
-			effect->GenerateGlyphTexture(rectangle.GetTextureData(), Vector2i(box.dimensions), rectangle.GetTextureStride(), glyph);
+			effect->GenerateGlyphTexture(destination, Vector2i(box.dimensions), texture_stride, glyph);
 		}
+	};
+
+	// Effects are applied to each glyph in parallel when enabled, every glyph writes to its own region of the texture. Copying the glyphs
+	// of the base layer is too cheap to benefit.
+	WorkerPool* worker_pool = (effect ? FontProvider::GetEffectWorkerPool() : nullptr);
+	if (worker_pool && (int)texture_glyphs.size() > 1)
+	{
+		const int num_glyphs = (int)texture_glyphs.size();
+		std::atomic<int> next_glyph(0);
+		worker_pool->Execute([&]() {
+			for (int i = next_glyph++; i < num_glyphs; i = next_glyph++)
+				GenerateGlyph(*texture_glyphs[i].box, *texture_glyphs[i].glyph);
+		});
+	}
+	else
+	{
+		for (const TextureGlyph& texture_glyph : texture_glyphs)
+			GenerateGlyph(*texture_glyph.box, *texture_glyph.glyph);
+	}
+
+	if (cache_key)
+		FontFileCache::SaveLayerTexture(cache_key, data.get(), texture_dimensions);
+
+	// Keep a copy of pages with appended glyphs, which are likely to receive more glyphs.
+	if (page.has_appended_glyphs)
+	{
+		page.data.reset(new byte[texture_size]);
+		memcpy(page.data.get(), data.get(), texture_size);
+	}
+
+	texture_data = std::move(data);
+
+	return true;
+}
+
+void FontFaceLayer::SetTextureCallback(const FontFaceHandleDefault* handle, const int texture_id)
+{
+	const FontEffect* effect_ptr = effect.get();
+	const int handle_version = handle->GetVersion();
+
+	TextureCallback texture_callback = [handle, effect_ptr, texture_id, handle_version](RenderInterface* render_interface,
+										   const String& /*name*/, TextureHandle& out_texture_handle, Vector2i& out_dimensions) -> bool {
+		UniquePtr<const byte[]> data;
+		if (!handle->GenerateLayerTexture(data, out_dimensions, effect_ptr, texture_id, handle_version) || !data)
+			return false;
+		if (!render_interface->GenerateTexture(out_texture_handle, data.get(), out_dimensions))
+			return false;
+		return true;
+	};
+
+	// Setting the callback gives the texture a new resource, any existing resource is released when no longer shared with cloned layers.
+	textures[texture_id]->Set("font-face-layer", texture_callback);
+}
+
+bool FontFaceLayer::PlaceInDistanceFieldAtlas(const FontGlyph& glyph, TextureBox& box)
+{
+	if (!distance_field_atlas || !glyph.distance_field)
+		return false;
+
+	// Glyphs without an outline, such as spaces, have nothing to render.
+	if (glyph.bitmap_dimensions.x <= 0 || glyph.bitmap_dimensions.y <= 0)
+	{
+		box = TextureBox();
+		return true;
 	}
 
+	const FontGlyphDistanceField& field = *glyph.distance_field;
+	const FontDistanceFieldAtlas::Entry& entry = distance_field_atlas->AddField(field);
+	if (entry.texture_index < 0)
+		return false;
+
+	// The whole field is scaled to the glyph's size, its offset is already relative to the glyph origin.
+	box.origin = Vector2f(field.offset) * glyph.distance_field_scale;
+	box.dimensions = Vector2f(field.dimensions) * glyph.distance_field_scale;
+	box.texcoords[0] = entry.texcoords[0];
+	box.texcoords[1] = entry.texcoords[1];
+	box.position = entry.position;
+	box.texture_index = entry.texture_index;
+	box.distance_field = true;
+
+	return true;
+}
+
+bool FontFaceLayer::ApplyEffectOrigin(const FontGlyph& glyph, TextureBox& box) const
+{
+	// Boxes scaled from distance fields have fractional origins, thus only the offset applied by the effect is added to the origin.
+	const Vector2i box_origin = Vector2i(box.origin);
+	Vector2i glyph_origin = box_origin;
+	Vector2i glyph_dimensions = Vector2i(box.dimensions);
+
+	if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+		return false;
+
+	box.origin += Vector2f(glyph_origin - box_origin);
 	return true;
 }
 
@@ -255,12 +513,27 @@ const Texture* FontFaceLayer::GetTexture(int index)
 	RMLUI_ASSERT(index >= 0);
 	RMLUI_ASSERT(index < GetNumTextures());
 
-	return &(textures[index]);
+	if (index >= (int)textures.size())
+		return distance_field_atlas->GetTexture(index - (int)textures.size());
+
+	return textures[index].get();
 }
 
 int FontFaceLayer::GetNumTextures() const
 {
-	return (int)textures.size();
+	return (int)textures.size() + (distance_field_atlas ? distance_field_atlas->GetNumTextures() : 0);
+}
+
+size_t FontFaceLayer::GetTextureMemoryUsage() const
+{
+	size_t result = 0;
+	for (const TexturePage& page : texture_pages)
+	{
+		const size_t page_size = size_t(page.dimensions.x) * size_t(page.dimensions.y) * 4;
+		// Pages with appended glyphs keep a copy once generated, counted in advance so that the usage only changes with the glyphs.
+		result += (page.has_appended_glyphs ? 2 : 1) * page_size;
+	}
+	return result;
 }
 
 Colourb FontFaceLayer::GetColour() const
@@ -33,10 +33,12 @@
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/GeometryUtilities.h"
 #include "../../../Include/RmlUi/Core/Texture.h"
-#include "../TextureLayout.h"
+#include "../TextureLayoutSkyline.h"
+#include "FontTypes.h"
 
 namespace Rml {
 
+class FontDistanceFieldAtlas;
 class FontEffect;
 class FontFaceHandleDefault;
 
@@ -59,12 +61,21 @@ public:
 	/// @return True if the layer was generated successfully, false if not.
 	bool Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
 
+	/// Adds a single new glyph to the layer, leaving the glyphs already in the layer and their texture coordinates untouched.
+	/// @param[in] handle The handle generating this layer.
+	/// @param[in] character The character of the new glyph.
+	/// @param[in] glyph The new glyph.
+	/// @param[in] clone The layer to optionally clone geometry and texture data from, the glyph must already have been added to it.
+	/// @return True if the glyph was added, false if there was no room for it and the layer must be regenerated instead.
+	bool AppendGlyph(const FontFaceHandleDefault* handle, Character character, const FontGlyph& glyph, const FontFaceLayer* clone = nullptr,
+		bool clone_glyph_origins = false);
+
 	/// Generates the texture data for a layer (for the texture database).
 	/// @param[out] texture_data The pointer to be set to the generated texture data.
 	/// @param[out] texture_dimensions The dimensions of the texture.
 	/// @param[in] texture_id The index of the texture within the layer to generate.
 	/// @param[in] glyphs The glyphs required by the font face handle.
-	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs);
+	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphTable& glyphs);
 
 	/// Generates the geometry required to render a single character.
 	/// @param[out] geometry An array of geometries this layer will write to. It must be at least as big as the number of textures in this layer.
@@ -82,24 +93,30 @@ public:
 		if (box.texture_index < 0)
 			return;
 
+		// The textures of the distance field atlas follow the layer's own textures.
+		const int geometry_index = (box.distance_field ? (int)textures.size() + box.texture_index : box.texture_index);
+
 		// Generate the geometry for the character.
-		Vector<Vertex>& character_vertices = geometry[box.texture_index].GetVertices();
-		Vector<int>& character_indices = geometry[box.texture_index].GetIndices();
+		Vector<Vertex>& character_vertices = geometry[geometry_index].GetVertices();
+		Vector<int>& character_indices = geometry[geometry_index].GetIndices();
 
 		character_vertices.resize(character_vertices.size() + 4);
 		character_indices.resize(character_indices.size() + 6);
 		GeometryUtilities::GenerateQuad(&character_vertices[0] + (character_vertices.size() - 4),
-			&character_indices[0] + (character_indices.size() - 6), Vector2f(position.x + box.origin.x, position.y + box.origin.y).Round(),
-			box.dimensions, colour, box.texcoords[0], box.texcoords[1], (int)character_vertices.size() - 4);
+			&character_indices[0] + (character_indices.size() - 6), position.Round() + box.origin, box.dimensions, colour, box.texcoords[0],
+			box.texcoords[1], (int)character_vertices.size() - 4);
 	}
 
 	/// Returns the effect used to generate the layer.
 	const FontEffect* GetFontEffect() const;
 
-	/// Returns one of the layer's textures.
+	/// Returns one of the layer's textures, followed by the textures of the distance field atlas if the layer renders from it.
 	const Texture* GetTexture(int index);
-	/// Returns the number of textures employed by this layer.
+	/// Returns the number of textures employed by this layer, including the textures of the distance field atlas.
 	int GetNumTextures() const;
+	/// Returns the number of bytes of texture data generated by this layer, not including textures cloned from other layers, and of the
+	/// copies kept of textures with appended glyphs.
+	size_t GetTextureMemoryUsage() const;
 
 	/// Returns the layer's colour.
 	Colourb GetColour() const;
@@ -114,21 +131,52 @@ private:
 		Vector2f dimensions;
 		// The texture coordinates for the character's geometry.
 		Vector2f texcoords[2];
+		// The position, in pixels, of the character within its texture.
+		Vector2i position;
 
 		// The texture this character renders from.
 		int texture_index;
+		// True if the texture index refers to the textures of the distance field atlas, the box is then scaled from the distance field.
+		bool distance_field = false;
 	};
 
-	using CharacterMap = UnorderedMap<Character, TextureBox>;
-	using TextureList = Vector<Texture>;
+	// A texture glyphs are packed into. New glyphs are placed on the skyline formed by the glyphs already in the texture.
+	struct TexturePage {
+		Vector2i dimensions;
+		TextureLayoutSkyline skyline;
+		// Pages change with every glyph appended to them, such pages are not stored in the font file cache.
+		bool has_appended_glyphs = false;
+		// The texture data last generated for a page with appended glyphs. Further glyphs appended to the page are generated into this copy,
+		// so that the effect is not applied to the existing glyphs again.
+		UniquePtr<byte[]> data;
+		// Glyphs appended to the page since its texture data was last generated.
+		Vector<Character> appended_characters;
+	};
 
-	SharedPtr<const FontEffect> effect;
+	// (Re-)sets the texture callback of the given texture, so that it is regenerated on next use.
+	void SetTextureCallback(const FontFaceHandleDefault* handle, int texture_id);
 
-	TextureLayout texture_layout;
+	// Places the glyph in the distance field atlas if the layer renders from one and the glyph has a distance field.
+	// @return True if the box was placed in the atlas, false if the glyph should be placed in the layer's own textures.
+	bool PlaceInDistanceFieldAtlas(const FontGlyph& glyph, TextureBox& box);
+
+	// Moves the box of a cloned glyph by the offset the effect applies to the glyph origin.
+	bool ApplyEffectOrigin(const FontGlyph& glyph, TextureBox& box) const;
+
+	using CharacterMap = CharacterTable<TextureBox>;
+	// Geometry refers to the textures by pointer, so they are kept stable while new textures are added.
+	using TextureList = Vector<UniquePtr<Texture>>;
+	using TexturePageList = Vector<TexturePage>;
+
+	SharedPtr<const FontEffect> effect;
 
 	CharacterMap character_boxes;
 	TextureList textures;
+	TexturePageList texture_pages;
 	Colourb colour;
+
+	// The atlas shared by all sizes of the font face, which the base layer and its clones render glyphs with distance fields from.
+	FontDistanceFieldAtlas* distance_field_atlas = nullptr;
 };
 
 } // namespace Rml
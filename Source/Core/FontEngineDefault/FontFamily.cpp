@@ -76,7 +76,7 @@ FontFaceHandleDefault* FontFamily::GetFaceHandle(Style::FontStyle style, Style::
 	return matching_face->GetHandle(size, true);
 }
 
-FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory)
+FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, FontFaceMemory face_memory)
 {
 	auto face = MakeUnique<FontFace>(ft_face, style, weight);
 	FontFace* result = face.get();
@@ -92,4 +92,10 @@ void FontFamily::ReleaseFontResources()
 		entry.face->ReleaseFontResources();
 }
 
+void FontFamily::GetFaces(Vector<FontFace*>& out_faces) const
+{
+	for (const auto& entry : font_faces)
+		out_faces.push_back(entry.face.get());
+}
+
 } // namespace Rml
@@ -0,0 +1,497 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FontFileCache.h"
+#include "../../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+#include "../../../Include/RmlUi/Core/StringUtilities.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(RMLUI_PLATFORM_WIN32)
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+#endif
+
+namespace Rml {
+
+// Increment whenever the file format or the generated data changes, to invalidate existing cache files.
+static constexpr uint32_t CacheFile_Version = 1;
+static constexpr uint32_t CacheFile_MagicGlyphs = 0x47464d52; // "RMFG"
+static constexpr uint32_t CacheFile_MagicLayer = 0x4c464d52;  // "RMFL"
+static constexpr int CacheFile_MaxDimensions = 16384;
+
+static constexpr uint32_t CacheFile_MagicIndex = 0x49464d52; // "RMFI"
+static constexpr const char* CacheFile_IndexName = "index";
+
+static String g_cache_directory;
+static int g_num_loaded_entries = 0;
+
+// The size and last use of each file in the cache directory, by file name, so that the least recently used files can be removed when the
+// cache exceeds its maximum size. Stored in the index file of the directory.
+struct CacheEntry {
+	uint64_t size;
+	uint64_t last_used;
+};
+static UnorderedMap<String, CacheEntry> g_entries;
+static uint64_t g_total_size = 0;
+static uint64_t g_use_counter = 0;
+static size_t g_max_size = 0;
+static bool g_index_dirty = false;
+
+namespace {
+	class CacheFileWriter {
+	public:
+		// Writes to a temporary file first, so that an interrupted write never leaves a partial cache file behind.
+		explicit CacheFileWriter(const String& path) : path(path), temporary_path(path + ".tmp") { file = fopen(temporary_path.c_str(), "wb"); }
+		~CacheFileWriter()
+		{
+			if (file)
+			{
+				fclose(file);
+				remove(temporary_path.c_str());
+			}
+		}
+
+		template <typename T>
+		void Write(const T& value)
+		{
+			Write(&value, sizeof(T));
+		}
+		void Write(const void* data, size_t size)
+		{
+			if (file && fwrite(data, 1, size, file) != size)
+				failed = true;
+			num_bytes_written += size;
+		}
+
+		// Moves the written file into place, returns false if any of the writes failed.
+		bool Commit()
+		{
+			if (!file)
+				return false;
+
+			const bool closed = (fclose(file) == 0);
+			file = nullptr;
+			remove(path.c_str());
+			if (failed || !closed || rename(temporary_path.c_str(), path.c_str()) != 0)
+			{
+				remove(temporary_path.c_str());
+				return false;
+			}
+			return true;
+		}
+
+		size_t GetSize() const { return num_bytes_written; }
+
+	private:
+		String path, temporary_path;
+		FILE* file = nullptr;
+		bool failed = false;
+		size_t num_bytes_written = 0;
+	};
+
+	class CacheFileReader {
+	public:
+		bool Load(const String& path)
+		{
+			FILE* file = fopen(path.c_str(), "rb");
+			if (!file)
+				return false;
+
+			fseek(file, 0, SEEK_END);
+			const long length = ftell(file);
+			fseek(file, 0, SEEK_SET);
+
+			bool result = false;
+			if (length > 0)
+			{
+				buffer.resize((size_t)length);
+				result = (fread(buffer.data(), 1, buffer.size(), file) == buffer.size());
+			}
+			fclose(file);
+
+			position = 0;
+			return result;
+		}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			return Read(&value, sizeof(T));
+		}
+		bool Read(void* data, size_t size)
+		{
+			if (size > buffer.size() - position)
+				return false;
+			memcpy(data, buffer.data() + position, size);
+			position += size;
+			return true;
+		}
+
+		bool IsAtEnd() const { return position == buffer.size(); }
+		size_t GetSize() const { return buffer.size(); }
+
+	private:
+		Vector<byte> buffer;
+		size_t position = 0;
+	};
+} // namespace
+
+static String GetCacheFileName(size_t key, const char* extension)
+{
+	return CreateString(32, "%016llx.%s", (unsigned long long)key, extension);
+}
+
+static void LoadIndex()
+{
+	g_entries.clear();
+	g_total_size = 0;
+	g_use_counter = 0;
+	g_index_dirty = false;
+
+	CacheFileReader reader;
+	uint32_t magic = 0, version = 0, num_entries = 0;
+	if (!reader.Load(g_cache_directory + CacheFile_IndexName) || !reader.Read(magic) || !reader.Read(version) || !reader.Read(num_entries) ||
+		magic != CacheFile_MagicIndex || version != CacheFile_Version)
+		return;
+
+	for (uint32_t i = 0; i < num_entries; i++)
+	{
+		uint32_t name_length = 0;
+		CacheEntry entry = {};
+		if (!reader.Read(name_length) || name_length > 64)
+			break;
+
+		String name(name_length, '\0');
+		if (!reader.Read(&name[0], name_length) || !reader.Read(entry.size) || !reader.Read(entry.last_used))
+			break;
+
+		// Files are removed by these names, make sure they only refer to files within the directory.
+		const bool valid_name = !name.empty() && name[0] != '.' &&
+			std::all_of(name.begin(), name.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '.'; });
+		if (!valid_name)
+			break;
+
+		g_entries[name] = entry;
+		g_total_size += entry.size;
+		g_use_counter = Math::Max(g_use_counter, entry.last_used);
+	}
+}
+
+static void SaveIndex()
+{
+	CacheFileWriter writer(g_cache_directory + CacheFile_IndexName);
+	writer.Write(CacheFile_MagicIndex);
+	writer.Write(CacheFile_Version);
+	writer.Write(uint32_t(g_entries.size()));
+	for (const auto& pair : g_entries)
+	{
+		writer.Write(uint32_t(pair.first.size()));
+		writer.Write(pair.first.data(), pair.first.size());
+		writer.Write(pair.second.size);
+		writer.Write(pair.second.last_used);
+	}
+
+	if (writer.Commit())
+		g_index_dirty = false;
+}
+
+// Records the use of a cache file, updating its size.
+static void TouchEntry(const String& name, size_t size)
+{
+	CacheEntry& entry = g_entries[name];
+	g_total_size = g_total_size - entry.size + size;
+	entry.size = size;
+	entry.last_used = ++g_use_counter;
+	g_index_dirty = true;
+}
+
+// Removes the least recently used files until the cache fits within its maximum size, other than the given file.
+static void EnforceMaxSize(const String& keep_name)
+{
+	if (g_max_size == 0 || g_total_size <= g_max_size)
+		return;
+
+	Vector<std::pair<uint64_t, String>> candidates;
+	candidates.reserve(g_entries.size());
+	for (const auto& pair : g_entries)
+	{
+		if (pair.first != keep_name)
+			candidates.emplace_back(pair.second.last_used, pair.first);
+	}
+	std::sort(candidates.begin(), candidates.end());
+
+	for (const auto& candidate : candidates)
+	{
+		if (g_total_size <= g_max_size)
+			break;
+
+		auto it = g_entries.find(candidate.second);
+		remove((g_cache_directory + candidate.second).c_str());
+		g_total_size -= it->second.size;
+		g_entries.erase(it);
+		g_index_dirty = true;
+	}
+}
+
+// Writes a cache file and records it in the index, evicting older files if the cache grows too large.
+static bool CommitCacheFile(CacheFileWriter& writer, const String& name)
+{
+	if (!writer.Commit())
+	{
+		Log::Message(Log::LT_WARNING, "Could not write font cache file to directory '%s'.", g_cache_directory.c_str());
+		return false;
+	}
+
+	TouchEntry(name, writer.GetSize());
+	EnforceMaxSize(name);
+	SaveIndex();
+	return true;
+}
+
+static void WriteHeader(CacheFileWriter& writer, uint32_t magic, size_t key)
+{
+	writer.Write(magic);
+	writer.Write(CacheFile_Version);
+	writer.Write(uint64_t(key));
+}
+
+static bool ReadHeader(CacheFileReader& reader, uint32_t magic, size_t key)
+{
+	uint32_t file_magic = 0, file_version = 0;
+	uint64_t file_key = 0;
+	return reader.Read(file_magic) && reader.Read(file_version) && reader.Read(file_key) && file_magic == magic &&
+		file_version == CacheFile_Version && file_key == uint64_t(key);
+}
+
+static bool IsValidDimensions(Vector2i dimensions, bool allow_empty)
+{
+	const int min_dimensions = (allow_empty ? 0 : 1);
+	return dimensions.x >= min_dimensions && dimensions.y >= min_dimensions && dimensions.x <= CacheFile_MaxDimensions &&
+		dimensions.y <= CacheFile_MaxDimensions;
+}
+
+void FontFileCache::SetDirectory(const String& directory, size_t max_size)
+{
+	Flush();
+
+	g_cache_directory = directory;
+	g_max_size = max_size;
+	g_entries.clear();
+	g_total_size = 0;
+	if (g_cache_directory.empty())
+		return;
+
+	if (g_cache_directory.back() != '/' && g_cache_directory.back() != '\\')
+		g_cache_directory += '/';
+
+	// Create the directory if it does not exist, any other errors show up when writing files to it.
+#if defined(RMLUI_PLATFORM_WIN32)
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+
+	LoadIndex();
+	EnforceMaxSize(String());
+	if (g_index_dirty)
+		SaveIndex();
+}
+
+void FontFileCache::Flush()
+{
+	if (IsEnabled() && g_index_dirty)
+		SaveIndex();
+}
+
+bool FontFileCache::IsEnabled()
+{
+	return !g_cache_directory.empty();
+}
+
+bool FontFileCache::LoadGlyphs(size_t key, FontGlyphTable& glyphs, FontMetrics& metrics)
+{
+	if (!IsEnabled())
+		return false;
+
+	const String name = GetCacheFileName(key, "glyphs");
+	CacheFileReader reader;
+	if (!reader.Load(g_cache_directory + name) || !ReadHeader(reader, CacheFile_MagicGlyphs, key))
+		return false;
+
+	FontMetrics file_metrics = {};
+	uint32_t num_glyphs = 0;
+	if (!reader.Read(file_metrics) || !reader.Read(num_glyphs))
+		return false;
+
+	FontGlyphTable file_glyphs;
+	file_glyphs.reserve(num_glyphs);
+
+	for (uint32_t i = 0; i < num_glyphs; i++)
+	{
+		uint32_t character = 0;
+		uint8_t color_format = 0;
+		FontGlyph glyph;
+		if (!reader.Read(character) || !reader.Read(glyph.dimensions) || !reader.Read(glyph.bearing) || !reader.Read(glyph.advance) ||
+			!reader.Read(glyph.bitmap_dimensions) || !reader.Read(color_format))
+			return false;
+
+		const bool valid_color_format = (color_format == uint8_t(ColorFormat::A8) || color_format == uint8_t(ColorFormat::RGBA8));
+		if (!IsValidDimensions(glyph.bitmap_dimensions, true) || !valid_color_format)
+			return false;
+
+		glyph.color_format = ColorFormat(color_format);
+		glyph.bitmap_data = nullptr;
+
+		const size_t num_bytes =
+			size_t(glyph.bitmap_dimensions.x) * size_t(glyph.bitmap_dimensions.y) * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+		if (num_bytes > 0)
+		{
+			glyph.bitmap_owned_data.reset(new byte[num_bytes]);
+			if (!reader.Read(glyph.bitmap_owned_data.get(), num_bytes))
+				return false;
+			glyph.bitmap_data = glyph.bitmap_owned_data.get();
+		}
+
+		file_glyphs.emplace(Character(character), std::move(glyph));
+	}
+
+	if (!reader.IsAtEnd())
+		return false;
+
+	glyphs = std::move(file_glyphs);
+	metrics = file_metrics;
+	g_num_loaded_entries += 1;
+	TouchEntry(name, reader.GetSize());
+
+	return true;
+}
+
+bool FontFileCache::SaveGlyphs(size_t key, const FontGlyphTable& glyphs, const FontMetrics& metrics)
+{
+	if (!IsEnabled())
+		return false;
+
+	// Glyphs borrowed from fallback fonts don't own their bitmap, and belong to the cache entry of their own font.
+	auto IsOwnGlyph = [](const FontGlyph& glyph) { return !glyph.bitmap_data || glyph.bitmap_owned_data; };
+
+	uint32_t num_glyphs = 0;
+	for (const auto& pair : glyphs)
+		num_glyphs += (IsOwnGlyph(pair.second) ? 1 : 0);
+
+	const String name = GetCacheFileName(key, "glyphs");
+	CacheFileWriter writer(g_cache_directory + name);
+	WriteHeader(writer, CacheFile_MagicGlyphs, key);
+	writer.Write(metrics);
+	writer.Write(num_glyphs);
+
+	for (const auto& pair : glyphs)
+	{
+		const FontGlyph& glyph = pair.second;
+		if (!IsOwnGlyph(glyph))
+			continue;
+
+		const Vector2i bitmap_dimensions = (glyph.bitmap_data ? glyph.bitmap_dimensions : Vector2i(0));
+		writer.Write(uint32_t(pair.first));
+		writer.Write(glyph.dimensions);
+		writer.Write(glyph.bearing);
+		writer.Write(glyph.advance);
+		writer.Write(bitmap_dimensions);
+		writer.Write(uint8_t(glyph.color_format));
+
+		const size_t num_bytes = size_t(bitmap_dimensions.x) * size_t(bitmap_dimensions.y) * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+		if (num_bytes > 0)
+			writer.Write(glyph.bitmap_data, num_bytes);
+	}
+
+	return CommitCacheFile(writer, name);
+}
+
+bool FontFileCache::LoadLayerTexture(size_t key, UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions)
+{
+	if (!IsEnabled())
+		return false;
+
+	const String name = GetCacheFileName(key, "layer");
+	CacheFileReader reader;
+	if (!reader.Load(g_cache_directory + name) || !ReadHeader(reader, CacheFile_MagicLayer, key))
+		return false;
+
+	Vector2i dimensions;
+	if (!reader.Read(dimensions) || !IsValidDimensions(dimensions, false))
+		return false;
+
+	const size_t num_bytes = size_t(dimensions.x) * size_t(dimensions.y) * 4;
+	UniquePtr<byte[]> data(new byte[num_bytes]);
+	if (!reader.Read(data.get(), num_bytes) || !reader.IsAtEnd())
+		return false;
+
+	texture_data = std::move(data);
+	texture_dimensions = dimensions;
+	g_num_loaded_entries += 1;
+	TouchEntry(name, reader.GetSize());
+
+	return true;
+}
+
+bool FontFileCache::SaveLayerTexture(size_t key, const byte* texture_data, Vector2i texture_dimensions)
+{
+	if (!IsEnabled() || !texture_data || !IsValidDimensions(texture_dimensions, false))
+		return false;
+
+	const String name = GetCacheFileName(key, "layer");
+	CacheFileWriter writer(g_cache_directory + name);
+	WriteHeader(writer, CacheFile_MagicLayer, key);
+	writer.Write(texture_dimensions);
+	writer.Write(texture_data, size_t(texture_dimensions.x) * size_t(texture_dimensions.y) * 4);
+
+	return CommitCacheFile(writer, name);
+}
+
+size_t FontFileCache::HashData(const byte* data, size_t size, size_t seed)
+{
+	// FNV-1a, the result must be the same on every run since it is used to name cache files.
+	uint64_t hash = 14695981039346656037ull ^ uint64_t(seed);
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= uint64_t(data[i]);
+		hash *= 1099511628211ull;
+	}
+	return size_t(hash);
+}
+
+int FontFileCache::GetNumLoadedEntries()
+{
+	return g_num_loaded_entries;
+}
+
+} // namespace Rml
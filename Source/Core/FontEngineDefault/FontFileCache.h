@@ -0,0 +1,74 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTFILECACHE_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_FONTFILECACHE_H
+
+#include "../../../Include/RmlUi/Core/FontMetrics.h"
+#include "FontTypes.h"
+
+namespace Rml {
+
+/**
+    Persistent cache of generated font data in a directory on disk, so that glyphs and font effect textures generated in a previous run
+    can be loaded instead of being rendered again.
+
+    Entries are identified by a key derived from the checksum of the font file, the font size, and for font effect textures the effect
+    fingerprint and the layout of the texture. Entries which don't match their key are ignored, and replaced when saved again. The size
+    and last use of each file is kept in an index file, so that the directory can be kept within a maximum size.
+ */
+
+namespace FontFileCache {
+
+	// Sets the directory to store cached font data in, which is created if it does not exist. An empty string disables the cache. When the
+	// files in the directory exceed the maximum size in bytes, the least recently used are removed. Zero for no limit.
+	void SetDirectory(const String& directory, size_t max_size);
+	// Writes the last use of the cache files to the directory's index, for removing the least recently used files in later runs.
+	void Flush();
+	// Returns true if a cache directory is set.
+	bool IsEnabled();
+
+	// Loads the glyphs and metrics of a font face handle previously saved with the given key.
+	bool LoadGlyphs(size_t key, FontGlyphTable& glyphs, FontMetrics& metrics);
+	// Saves the glyphs and metrics of a font face handle with the given key. Glyphs with bitmap data owned by other handles are skipped.
+	bool SaveGlyphs(size_t key, const FontGlyphTable& glyphs, const FontMetrics& metrics);
+
+	// Loads the RGBA texture data of a font layer previously saved with the given key.
+	bool LoadLayerTexture(size_t key, UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions);
+	// Saves the RGBA texture data of a font layer with the given key.
+	bool SaveLayerTexture(size_t key, const byte* texture_data, Vector2i texture_dimensions);
+
+	// Hashes the given data combined with the seed, independent of the standard library implementation.
+	size_t HashData(const byte* data, size_t size, size_t seed);
+
+	// Returns the number of glyph sets and layer textures loaded from the cache, for diagnostics.
+	int GetNumLoadedEntries();
+
+} // namespace FontFileCache
+} // namespace Rml
+#endif
@@ -33,7 +33,10 @@
 #include "../../../Include/RmlUi/Core/Math.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
 #include "../ComputeProperty.h"
+#include "../WorkerPool.h"
 #include "FontFace.h"
+#include "FontFaceHandleDefault.h"
+#include "FontFileCache.h"
 #include "FontFamily.h"
 #include "FreeTypeInterface.h"
 #include <algorithm>
@@ -41,6 +44,9 @@
 namespace Rml {
 
 static FontProvider* g_font_provider = nullptr;
+static int g_distance_field_size = 0;
+static int g_num_effect_threads = 1;
+static size_t g_memory_budget = 0;
 
 FontProvider::FontProvider()
 {
@@ -50,6 +56,10 @@ FontProvider::FontProvider()
 FontProvider::~FontProvider()
 {
 	RMLUI_ASSERT(g_font_provider == this);
+
+	// Destroy the handles first, since they report their memory usage to us.
+	font_families.clear();
+	RMLUI_ASSERT(memory_usage == 0);
 }
 
 bool FontProvider::Initialise()
@@ -66,6 +76,7 @@ void FontProvider::Shutdown()
 	RMLUI_ASSERT(g_font_provider);
 	delete g_font_provider;
 	g_font_provider = nullptr;
+	FontFileCache::Flush();
 	FreeType::Shutdown();
 }
 
@@ -79,13 +90,23 @@ FontFaceHandleDefault* FontProvider::GetFontFaceHandle(const String& family, Sty
 {
 	RMLUI_ASSERTMSG(family == StringUtilities::ToLower(family), "Font family name must be converted to lowercase before entering here.");
 
-	FontFamilyMap& families = Get().font_families;
+	FontProvider& provider = Get();
+	FontFamilyMap& families = provider.font_families;
 
 	auto it = families.find(family);
 	if (it == families.end())
 		return nullptr;
 
-	return it->second->GetFaceHandle(style, weight, size);
+	FontFaceHandleDefault* handle = it->second->GetFaceHandle(style, weight, size);
+
+	// Handles are only released from here, since other handles may be in the middle of using their glyphs when fallback handles are created.
+	if (provider.is_memory_budget_check_pending)
+	{
+		provider.is_memory_budget_check_pending = false;
+		provider.EnforceMemoryBudget(handle);
+	}
+
+	return handle;
 }
 
 int FontProvider::CountFallbackFontFaces()
@@ -103,6 +124,22 @@ FontFaceHandleDefault* FontProvider::GetFallbackFontFace(int index, int font_siz
 	return nullptr;
 }
 
+bool FontProvider::FindFallbackFontFaceIndex(Character character, int& index)
+{
+	const auto& indices = Get().fallback_font_face_indices;
+	auto it = indices.find(character);
+	if (it == indices.end())
+		return false;
+
+	index = it->second;
+	return true;
+}
+
+void FontProvider::SetFallbackFontFaceIndex(Character character, int index)
+{
+	Get().fallback_font_face_indices[character] = index;
+}
+
 void FontProvider::ReleaseFontResources()
 {
 	RMLUI_ASSERT(g_font_provider);
@@ -110,9 +147,182 @@ void FontProvider::ReleaseFontResources()
 		name_family.second->ReleaseFontResources();
 }
 
+void FontProvider::SetDistanceFieldSize(int size)
+{
+	g_distance_field_size = Math::Max(size, 0);
+}
+
+int FontProvider::GetDistanceFieldSize()
+{
+	return g_distance_field_size;
+}
+
+void FontProvider::SetNumEffectThreads(int num_threads)
+{
+	if (num_threads <= 0)
+		num_threads = Math::Clamp((int)std::thread::hardware_concurrency(), 1, 16);
+
+#if defined(RMLUI_PLATFORM_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+	// Worker threads cannot be started without pthread support.
+	num_threads = 1;
+#endif
+
+	g_num_effect_threads = num_threads;
+}
+
+WorkerPool* FontProvider::GetEffectWorkerPool()
+{
+	UniquePtr<WorkerPool>& worker_pool = Get().effect_worker_pool;
+
+	if (g_num_effect_threads <= 1)
+	{
+		worker_pool.reset();
+		return nullptr;
+	}
+
+	// Start the threads on first use, or restart them when the number of threads has changed.
+	if (!worker_pool || worker_pool->GetNumThreads() != g_num_effect_threads)
+	{
+		worker_pool.reset();
+		worker_pool = MakeUnique<WorkerPool>(g_num_effect_threads - 1);
+	}
+
+	return worker_pool.get();
+}
+
+void FontProvider::SetCacheDirectory(const String& directory, size_t max_size)
+{
+	FontFileCache::SetDirectory(directory, max_size);
+}
+
+void FontProvider::SetMemoryBudget(size_t max_bytes)
+{
+	g_memory_budget = max_bytes;
+}
+
+void FontProvider::MarkHandleUsed(FontFaceHandleDefault* handle, bool generated)
+{
+	FontProvider& provider = Get();
+	handle->SetLastUsed(++provider.handle_use_counter);
+
+	if (!generated)
+	{
+		provider.handle_statistics.hits += 1;
+		return;
+	}
+
+	provider.handle_statistics.misses += 1;
+	if (g_memory_budget > 0)
+		provider.is_memory_budget_check_pending = true;
+}
+
+FontHandleStatistics FontProvider::GetHandleStatistics()
+{
+	const FontProvider& provider = Get();
+	FontHandleStatistics result = provider.handle_statistics;
+
+	Vector<FontFace*> faces;
+	Vector<FontFaceHandleDefault*> handles;
+	for (const auto& name_family : provider.font_families)
+		name_family.second->GetFaces(faces);
+	for (const FontFace* face : faces)
+		face->GetHandles(handles);
+
+	result.num_handles = (int)handles.size();
+	result.memory_usage = provider.memory_usage;
+
+#ifdef RMLUI_DEBUG
+	size_t sum_memory_usage = 0;
+#endif
+	for (const FontFaceHandleDefault* handle : handles)
+	{
+		result.num_released_handles += (handle->IsReleased() ? 1 : 0);
+#ifdef RMLUI_DEBUG
+		sum_memory_usage += handle->GetMemoryUsage();
+#endif
+	}
+	RMLUI_ASSERTMSG(sum_memory_usage == result.memory_usage, "Memory usage changed without being reported by its font face handle.");
+
+	return result;
+}
+
+void FontProvider::UpdateMemoryUsage(size_t old_bytes, size_t new_bytes)
+{
+	FontProvider& provider = Get();
+	RMLUI_ASSERT(provider.memory_usage >= old_bytes);
+	provider.memory_usage = provider.memory_usage - old_bytes + new_bytes;
+}
+
+void FontProvider::AddHandleReference(FontFaceHandle handle)
+{
+	Get().handle_references[handle] += 1;
+}
+
+void FontProvider::RemoveHandleReference(FontFaceHandle handle)
+{
+	auto& references = Get().handle_references;
+	auto it = references.find(handle);
+	RMLUI_ASSERT(it != references.end() && it->second > 0);
+	if (it != references.end() && --it->second <= 0)
+		references.erase(it);
+}
+
+void FontProvider::EnforceMemoryBudget(const FontFaceHandleDefault* keep_handle)
+{
+	if (memory_usage <= g_memory_budget)
+		return;
+
+	Vector<FontFace*> faces;
+	for (const auto& name_family : font_families)
+		name_family.second->GetFaces(faces);
+
+	Vector<FontFaceHandleDefault*> handles;
+	Vector<FontFaceHandleDefault*> candidates;
+	for (const FontFace* face : faces)
+	{
+		// Glyphs of fallback faces are borrowed by other handles, thus they are never released.
+		if (std::find(fallback_font_faces.begin(), fallback_font_faces.end(), face) != fallback_font_faces.end())
+			continue;
+
+		handles.clear();
+		face->GetHandles(handles);
+
+		// Handles may be used by any element, such as text elements and text input widgets through their parent.
+		for (FontFaceHandleDefault* handle : handles)
+		{
+			if (handle != keep_handle && !handle->IsReleased() && handle_references.count(reinterpret_cast<FontFaceHandle>(handle)) == 0)
+				candidates.push_back(handle);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const FontFaceHandleDefault* a, const FontFaceHandleDefault* b) { return a->GetLastUsed() < b->GetLastUsed(); });
+
+	// Releasing the resources of a handle reports its reduced memory usage, which updates the total.
+	for (FontFaceHandleDefault* candidate : candidates)
+	{
+		if (memory_usage <= g_memory_budget)
+			break;
+
+		candidate->ReleaseResources();
+		handle_statistics.evictions += 1;
+	}
+}
+
 bool FontProvider::LoadFontFace(const String& file_name, bool fallback_face, Style::FontWeight weight)
 {
 	FileInterface* file_interface = GetFileInterface();
+
+	// Prefer mapping the file, so that only the parts of the font actually used by FreeType are loaded into memory.
+	const byte* mapped_data = nullptr;
+	size_t mapped_size = 0;
+	if (file_interface->MapFile(file_name, mapped_data, mapped_size))
+	{
+		FontFaceMemory face_memory(file_interface, mapped_data, mapped_size);
+		return Get().LoadFontFace(mapped_data, (int)mapped_size, fallback_face, std::move(face_memory), file_name, {}, Style::FontStyle::Normal,
+			weight);
+	}
+
 	FileHandle handle = file_interface->Open(file_name);
 
 	if (!handle)
@@ -128,7 +338,8 @@ bool FontProvider::LoadFontFace(const String& file_name, bool fallback_face, Sty
 	file_interface->Read(buffer, length, handle);
 	file_interface->Close(handle);
 
-	bool result = Get().LoadFontFace(buffer, (int)length, fallback_face, std::move(buffer_ptr), file_name, {}, Style::FontStyle::Normal, weight);
+	FontFaceMemory face_memory(std::move(buffer_ptr));
+	bool result = Get().LoadFontFace(buffer, (int)length, fallback_face, std::move(face_memory), file_name, {}, Style::FontStyle::Normal, weight);
 
 	return result;
 }
@@ -138,12 +349,12 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, const String& f
 {
 	const String source = "memory";
 
-	bool result = Get().LoadFontFace(data, data_size, fallback_face, nullptr, source, font_family, style, weight);
+	bool result = Get().LoadFontFace(data, data_size, fallback_face, FontFaceMemory(), source, font_family, style, weight);
 
 	return result;
 }
 
-bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_face, UniquePtr<byte[]> face_memory, const String& source,
+bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_face, FontFaceMemory face_memory, const String& source,
 	String font_family, Style::FontStyle style, Style::FontWeight weight)
 {
 	using Style::FontWeight;
@@ -230,7 +441,7 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_f
 }
 
 bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face,
-	UniquePtr<byte[]> face_memory)
+	FontFaceMemory face_memory)
 {
 	if (family.empty() || weight == Style::FontWeight::Auto)
 		return false;
@@ -257,6 +468,15 @@ bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, St
 		if (it_fallback_face == fallback_font_faces.end())
 		{
 			fallback_font_faces.push_back(font_face_result);
+
+			// Characters not found before may be contained in the new face, while existing faces take precedence for all other characters.
+			for (auto it_index = fallback_font_face_indices.begin(); it_index != fallback_font_face_indices.end();)
+			{
+				if (it_index->second < 0)
+					it_index = fallback_font_face_indices.erase(it_index);
+				else
+					++it_index;
+			}
 		}
 	}
 
@@ -29,6 +29,7 @@
 #ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTPROVIDER_H
 #define RMLUI_CORE_FONTENGINEDEFAULT_FONTPROVIDER_H
 
+#include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
 #include "../../../Include/RmlUi/Core/Types.h"
 #include "FontTypes.h"
@@ -38,6 +39,7 @@ namespace Rml {
 class FontFace;
 class FontFamily;
 class FontFaceHandleDefault;
+class WorkerPool;
 
 /**
     The font provider contains all font families currently in use by RmlUi.
@@ -72,26 +74,77 @@ public:
 	/// Return a font face handle with the given index, at the given font size.
 	static FontFaceHandleDefault* GetFallbackFontFace(int index, int font_size);
 
+	/// Looks up the index of the fallback font face containing the given character, as previously stored.
+	/// @param[out] index The index of the fallback font face, or -1 if no fallback font face contains the character.
+	/// @return False if the character has not been looked up since the last fallback font face was added.
+	static bool FindFallbackFontFaceIndex(Character character, int& index);
+	/// Stores the index of the fallback font face containing the given character, or -1 if none of them do.
+	static void SetFallbackFontFaceIndex(Character character, int index);
+
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	static void ReleaseFontResources();
 
+	/// Sets the reference size of the glyph distance fields used for font sizes generated from now on, or zero to disable them.
+	static void SetDistanceFieldSize(int size);
+	/// Returns the reference size of the glyph distance fields, or zero when disabled.
+	static int GetDistanceFieldSize();
+
+	/// Sets the number of threads to generate font effect textures on, including the calling thread.
+	static void SetNumEffectThreads(int num_threads);
+	/// Returns the worker pool to generate font effect textures in parallel, or nullptr when generated on the calling thread only.
+	static WorkerPool* GetEffectWorkerPool();
+
+	/// Sets the directory of the font file cache, or empty to disable it, and the maximum total size of its files.
+	static void SetCacheDirectory(const String& directory, size_t max_size);
+
+	/// Sets the number of bytes the glyphs and textures of all font face handles may use, or zero for no limit.
+	static void SetMemoryBudget(size_t max_bytes);
+	/// Marks the handle as the most recently used one. If its resources were just generated, the resources of the least recently used handles
+	/// not referenced by any element are released until within the memory budget, during the next call to GetFontFaceHandle().
+	static void MarkHandleUsed(FontFaceHandleDefault* handle, bool generated);
+	/// Returns the statistics of all font face handles.
+	static FontHandleStatistics GetHandleStatistics();
+	/// Updates the total memory usage of all handles, after the memory usage of a handle changed from the old to the new number of bytes.
+	static void UpdateMemoryUsage(size_t old_bytes, size_t new_bytes);
+
+	/// Adds a reference to the handle by an element. Handles referenced by any element are never released to stay within the memory budget.
+	static void AddHandleReference(FontFaceHandle handle);
+	/// Removes a reference previously added to the handle.
+	static void RemoveHandleReference(FontFaceHandle handle);
+
 private:
 	FontProvider();
 	~FontProvider();
 
 	static FontProvider& Get();
 
-	bool LoadFontFace(const byte* data, int data_size, bool fallback_face, UniquePtr<byte[]> face_memory, const String& source, String font_family,
+	bool LoadFontFace(const byte* data, int data_size, bool fallback_face, FontFaceMemory face_memory, const String& source, String font_family,
 		Style::FontStyle style, Style::FontWeight weight);
 
 	bool AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face,
-		UniquePtr<byte[]> face_memory);
+		FontFaceMemory face_memory);
+
+	// Release the resources of the least recently used handles, which are not referenced by any element, until within the memory budget.
+	void EnforceMemoryBudget(const FontFaceHandleDefault* keep_handle);
 
 	using FontFaceList = Vector<FontFace*>;
 	using FontFamilyMap = UnorderedMap<String, UniquePtr<FontFamily>>;
 
 	FontFamilyMap font_families;
 	FontFaceList fallback_font_faces;
+	// The index of the fallback font face containing each character looked up, or -1 when not contained in any of them.
+	UnorderedMap<Character, int> fallback_font_face_indices;
+
+	UniquePtr<WorkerPool> effect_worker_pool;
+
+	// Incremented whenever a handle is used, for ordering the handles by their last use.
+	uint64_t handle_use_counter = 0;
+	FontHandleStatistics handle_statistics;
+	bool is_memory_budget_check_pending = false;
+	// The sum of the memory usage reported by all handles.
+	size_t memory_usage = 0;
+	// The number of references to each handle by elements, only handles with references are included.
+	UnorderedMap<FontFaceHandle, int> handle_references;
 
 	static const String debugger_font_family_name;
 };
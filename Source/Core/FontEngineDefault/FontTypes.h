@@ -29,20 +29,69 @@
 #ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTTYPES_H
 #define RMLUI_CORE_FONTENGINEDEFAULT_FONTTYPES_H
 
+#include "../../../Include/RmlUi/Core/FileInterface.h"
 #include "../../../Include/RmlUi/Core/FontGlyph.h"
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
 #include "../../../Include/RmlUi/Core/Types.h"
+#include "CharacterTable.h"
 
 namespace Rml {
 
 using FontFaceHandleFreetype = uintptr_t;
 
+// The glyphs of a font face handle, looked up for every character of the strings it lays out.
+using FontGlyphTable = CharacterTable<FontGlyph>;
+
 struct FaceVariation {
 	Style::FontWeight weight;
 	uint16_t width;
 	int named_instance_index;
 };
 
+// The distance fields of a font face's glyphs, rasterized once at the reference size and shared by all sizes of the face.
+struct FontFaceDistanceFields {
+	int reference_size = 0;
+	// Glyphs without an outline map to nullptr.
+	UnorderedMap<Character, UniquePtr<FontGlyphDistanceField>> glyphs;
+};
+
+// The contents of a font file used by FreeType faces, either read into a buffer or mapped through the file interface. Released on destruction.
+class FontFaceMemory {
+public:
+	FontFaceMemory() = default;
+	explicit FontFaceMemory(UniquePtr<byte[]> buffer) : buffer(std::move(buffer)) {}
+	FontFaceMemory(FileInterface* file_interface, const byte* mapped_data, size_t mapped_size) :
+		file_interface(file_interface), mapped_data(mapped_data), mapped_size(mapped_size)
+	{}
+	FontFaceMemory(FontFaceMemory&& other) noexcept { *this = std::move(other); }
+	FontFaceMemory& operator=(FontFaceMemory&& other) noexcept
+	{
+		Release();
+		buffer = std::move(other.buffer);
+		std::swap(file_interface, other.file_interface);
+		std::swap(mapped_data, other.mapped_data);
+		std::swap(mapped_size, other.mapped_size);
+		return *this;
+	}
+	~FontFaceMemory() { Release(); }
+
+private:
+	void Release()
+	{
+		buffer.reset();
+		if (mapped_data)
+			file_interface->UnmapFile(mapped_data, mapped_size);
+		file_interface = nullptr;
+		mapped_data = nullptr;
+		mapped_size = 0;
+	}
+
+	UniquePtr<byte[]> buffer;
+	FileInterface* file_interface = nullptr;
+	const byte* mapped_data = nullptr;
+	size_t mapped_size = 0;
+};
+
 inline bool operator<(const FaceVariation& a, const FaceVariation& b)
 {
 	if (a.weight == b.weight)
@@ -30,7 +30,9 @@
 #include "../../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../../Include/RmlUi/Core/FontMetrics.h"
 #include "../../../Include/RmlUi/Core/Log.h"
+#include "FontFileCache.h"
 #include <algorithm>
+#include <float.h>
 #include <ft2build.h>
 #include <limits.h>
 #include <string.h>
@@ -42,8 +44,14 @@ namespace Rml {
 
 static FT_Library ft_library = nullptr;
 
-static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphMap& glyphs, float bitmap_scaling_factor);
-static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, float bitmap_scaling_factor, bool load_default_glyphs);
+static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphTable& glyphs, float bitmap_scaling_factor, int font_size,
+	FontFaceDistanceFields* distance_fields);
+static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphTable& glyphs, float bitmap_scaling_factor, bool load_default_glyphs,
+	FontFaceDistanceFields* distance_fields);
+static const FontGlyphDistanceField* GetOrBuildDistanceField(FT_Face ft_face, FT_UInt index, Character character, int font_size,
+	FontFaceDistanceFields& distance_fields);
+static void DistanceTransform(float* data, int width, int height);
+static void GenerateBitmapFromDistanceField(FontGlyph& glyph, const FontGlyphDistanceField& field, int font_size);
 static void GenerateMetrics(FT_Face ft_face, FontMetrics& metrics, float bitmap_scaling_factor);
 static bool SetFontSize(FT_Face ft_face, int font_size, float& out_bitmap_scaling_factor);
 static void BitmapDownscale(byte* bitmap_new, int new_width, int new_height, const byte* bitmap_source, int width, int height, int pitch,
@@ -187,7 +195,32 @@ void FreeType::GetFaceStyle(FontFaceHandleFreetype in_face, String* font_family,
 	}
 }
 
-bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs)
+size_t FreeType::GetFaceFingerprint(FontFaceHandleFreetype in_face)
+{
+	FT_Face face = (FT_Face)in_face;
+
+	const TT_Header* head = (const TT_Header*)FT_Get_Sfnt_Table(face, FT_SFNT_HEAD);
+	if (!head)
+		return 0;
+
+	// The checksum adjustment covers the whole font file. Include the FreeType version, since it affects the rendered glyphs. The fingerprint
+	// names the cache files, so it is hashed with the stable hash of the cache rather than std::hash, which may differ between runs.
+	const int64_t values[] = {int64_t(head->CheckSum_Adjust), int64_t(head->Font_Revision), int64_t(head->Modified[0]), int64_t(head->Modified[1]),
+		int64_t(face->face_index), int64_t(face->num_glyphs), int64_t(FREETYPE_MAJOR * 10000 + FREETYPE_MINOR * 100 + FREETYPE_PATCH)};
+	size_t fingerprint = FontFileCache::HashData(reinterpret_cast<const byte*>(values), sizeof(values), 0);
+
+	// Include the null terminators to separate the names.
+	const char* family_name = (face->family_name ? face->family_name : "");
+	const char* style_name = (face->style_name ? face->style_name : "");
+	fingerprint = FontFileCache::HashData(reinterpret_cast<const byte*>(family_name), strlen(family_name) + 1, fingerprint);
+	fingerprint = FontFileCache::HashData(reinterpret_cast<const byte*>(style_name), strlen(style_name) + 1, fingerprint);
+
+	// Zero means the face has no fingerprint.
+	return (fingerprint != 0 ? fingerprint : 1);
+}
+
+bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphTable& glyphs, FontMetrics& metrics,
+	bool load_default_glyphs, FontFaceDistanceFields* distance_fields)
 {
 	FT_Face ft_face = (FT_Face)face;
 
@@ -198,7 +231,7 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 		return false;
 
 	// Construct the initial list of glyphs.
-	BuildGlyphMap(ft_face, font_size, glyphs, bitmap_scaling_factor, load_default_glyphs);
+	BuildGlyphMap(ft_face, font_size, glyphs, bitmap_scaling_factor, load_default_glyphs, distance_fields);
 
 	// Generate the metrics for the handle.
 	GenerateMetrics(ft_face, metrics, bitmap_scaling_factor);
@@ -206,7 +239,8 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 	return true;
 }
 
-bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs)
+bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphTable& glyphs,
+	FontFaceDistanceFields* distance_fields)
 {
 	FT_Face ft_face = (FT_Face)face;
 
@@ -218,7 +252,7 @@ bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character
 	if (!SetFontSize(ft_face, font_size, bitmap_scaling_factor))
 		return false;
 
-	if (!BuildGlyph(ft_face, character, glyphs, bitmap_scaling_factor))
+	if (!BuildGlyph(ft_face, character, glyphs, bitmap_scaling_factor, font_size, distance_fields))
 		return false;
 
 	return true;
@@ -251,6 +285,42 @@ int FreeType::GetKerning(FontFaceHandleFreetype face, int font_size, Character l
 	return kerning;
 }
 
+void FreeType::GetKerningTable(FontFaceHandleFreetype face, int font_size, Character first, Character last, Vector<std::int16_t>& kerning)
+{
+	FT_Face ft_face = (FT_Face)face;
+
+	RMLUI_ASSERT(FT_HAS_KERNING(ft_face));
+	RMLUI_ASSERT(first <= last);
+
+	const int num_characters = int(char32_t(last) - char32_t(first)) + 1;
+	kerning.assign(num_characters * num_characters, 0);
+
+	float bitmap_scaling_factor = 1.0f;
+	if (!SetFontSize(ft_face, font_size, bitmap_scaling_factor) || bitmap_scaling_factor != 1.0f)
+		return;
+
+	// Look up the glyph indices once, instead of for every pair.
+	Vector<FT_UInt> glyph_indices(num_characters);
+	for (int i = 0; i < num_characters; i++)
+		glyph_indices[i] = FT_Get_Char_Index(ft_face, (FT_ULong)first + i);
+
+	for (int lhs = 0; lhs < num_characters; lhs++)
+	{
+		if (glyph_indices[lhs] == 0)
+			continue;
+
+		for (int rhs = 0; rhs < num_characters; rhs++)
+		{
+			if (glyph_indices[rhs] == 0)
+				continue;
+
+			FT_Vector ft_kerning;
+			if (FT_Get_Kerning(ft_face, glyph_indices[lhs], glyph_indices[rhs], FT_KERNING_DEFAULT, &ft_kerning) == 0)
+				kerning[lhs * num_characters + rhs] = std::int16_t(ft_kerning.x >> 6);
+		}
+	}
+}
+
 bool FreeType::HasKerning(FontFaceHandleFreetype face)
 {
 	FT_Face ft_face = (FT_Face)face;
@@ -258,7 +328,8 @@ bool FreeType::HasKerning(FontFaceHandleFreetype face)
 	return FT_HAS_KERNING(ft_face);
 }
 
-static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const float bitmap_scaling_factor, const bool load_default_glyphs)
+static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphTable& glyphs, const float bitmap_scaling_factor, const bool load_default_glyphs,
+	FontFaceDistanceFields* distance_fields)
 {
 	if (load_default_glyphs)
 	{
@@ -269,7 +340,7 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 		FT_ULong code_max = 126;
 
 		for (FT_ULong character_code = code_min; character_code <= code_max; ++character_code)
-			BuildGlyph(ft_face, (Character)character_code, glyphs, bitmap_scaling_factor);
+			BuildGlyph(ft_face, (Character)character_code, glyphs, bitmap_scaling_factor, size, distance_fields);
 	}
 
 	// Add a replacement character for rendering unknown characters.
@@ -301,13 +372,20 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 	}
 }
 
-static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap& glyphs, const float bitmap_scaling_factor)
+static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphTable& glyphs, const float bitmap_scaling_factor, const int font_size,
+	FontFaceDistanceFields* distance_fields)
 {
 	FT_UInt index = FT_Get_Char_Index(ft_face, (FT_ULong)character);
 	if (index == 0)
 		return false;
 
-	FT_Error error = FT_Load_Glyph(ft_face, index, FT_LOAD_COLOR);
+	// Outline glyphs can be generated from the shared distance field of the face, instead of being rendered at every size. Any other
+	// glyphs, such as color bitmaps, are always rendered.
+	const FontGlyphDistanceField* distance_field = nullptr;
+	if (distance_fields && bitmap_scaling_factor == 1.f)
+		distance_field = GetOrBuildDistanceField(ft_face, index, character, font_size, *distance_fields);
+
+	FT_Error error = FT_Load_Glyph(ft_face, index, distance_field ? FT_LOAD_DEFAULT : FT_LOAD_COLOR);
 	if (error != 0)
 	{
 		Log::Message(Log::LT_WARNING, "Unable to load glyph for character '%u' on the font face '%s %s'; error code: %d.", (unsigned int)character,
@@ -315,12 +393,15 @@ static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap&
 		return false;
 	}
 
-	error = FT_Render_Glyph(ft_face->glyph, FT_RENDER_MODE_NORMAL);
-	if (error != 0)
+	if (!distance_field)
 	{
-		Log::Message(Log::LT_WARNING, "Unable to render glyph for character '%u' on the font face '%s %s'; error code: %d.", (unsigned int)character,
-			ft_face->family_name, ft_face->style_name, error);
-		return false;
+		error = FT_Render_Glyph(ft_face->glyph, FT_RENDER_MODE_NORMAL);
+		if (error != 0)
+		{
+			Log::Message(Log::LT_WARNING, "Unable to render glyph for character '%u' on the font face '%s %s'; error code: %d.",
+				(unsigned int)character, ft_face->family_name, ft_face->style_name, error);
+			return false;
+		}
 	}
 
 	auto result = glyphs.emplace(character, FontGlyph{});
@@ -346,6 +427,12 @@ static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap&
 	// Set the glyph's advance.
 	glyph.advance = ft_glyph->metrics.horiAdvance >> 6;
 
+	if (distance_field)
+	{
+		GenerateBitmapFromDistanceField(glyph, *distance_field, font_size);
+		return true;
+	}
+
 	// Set the glyph's bitmap dimensions.
 	glyph.bitmap_dimensions.x = ft_glyph->bitmap.width;
 	glyph.bitmap_dimensions.y = ft_glyph->bitmap.rows;
@@ -541,6 +628,179 @@ static bool SetFontSize(FT_Face ft_face, int font_size, float& out_bitmap_scalin
 	return true;
 }
 
+static const FontGlyphDistanceField* GetOrBuildDistanceField(FT_Face ft_face, const FT_UInt index, const Character character, const int font_size,
+	FontFaceDistanceFields& distance_fields)
+{
+	auto it = distance_fields.glyphs.find(character);
+	if (it != distance_fields.glyphs.end())
+		return it->second.get();
+
+	UniquePtr<FontGlyphDistanceField>& result = distance_fields.glyphs[character];
+
+	// Render the glyph's outline at the reference size, then restore the size of the glyph being built.
+	const int reference_size = distance_fields.reference_size;
+	FT_Error error = FT_Set_Char_Size(ft_face, 0, reference_size << 6, 0, 0);
+	if (error == 0)
+		error = FT_Load_Glyph(ft_face, index, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING);
+	if (error == 0 && ft_face->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+		error = FT_Render_Glyph(ft_face->glyph, FT_RENDER_MODE_NORMAL);
+	else
+		error = 1;
+
+	const FT_Bitmap& bitmap = ft_face->glyph->bitmap;
+	if (error == 0 && bitmap.pixel_mode == FT_PIXEL_MODE_GRAY)
+	{
+		auto field = MakeUnique<FontGlyphDistanceField>();
+		field->reference_size = reference_size;
+		field->spread = Math::Max(float(reference_size) / 4.f, 2.f);
+
+		const int padding = int(field->spread) + 1;
+		const int width = (int)bitmap.width + 2 * padding;
+		const int height = (int)bitmap.rows + 2 * padding;
+		field->dimensions = Vector2i(width, height);
+		field->offset = Vector2i(ft_face->glyph->bitmap_left - padding, -ft_face->glyph->bitmap_top - padding);
+
+		// Find the squared distances from pixels outside the glyph to the nearest pixel inside, and from pixels inside to the nearest
+		// pixel outside.
+		const int num_pixels = width * height;
+		Vector<float> coverage(num_pixels, 0.f);
+		for (int y = 0; y < (int)bitmap.rows; y++)
+		{
+			const byte* source = bitmap.buffer + y * bitmap.pitch;
+			for (int x = 0; x < (int)bitmap.width; x++)
+				coverage[(y + padding) * width + x + padding] = float(source[x]) / 255.f;
+		}
+
+		const float infinity = float(width * width + height * height);
+		Vector<float> to_inside(num_pixels);
+		Vector<float> to_outside(num_pixels);
+		for (int i = 0; i < num_pixels; i++)
+		{
+			const bool inside = (coverage[i] >= 0.5f);
+			to_inside[i] = (inside ? 0.f : infinity);
+			to_outside[i] = (inside ? infinity : 0.f);
+		}
+		DistanceTransform(to_inside.data(), width, height);
+		DistanceTransform(to_outside.data(), width, height);
+
+		field->data.reset(new byte[num_pixels]);
+		for (int i = 0; i < num_pixels; i++)
+		{
+			// Pixel centers are half a pixel from the outline when next to a pixel on the other side. On the edge of the glyph, the
+			// anti-aliased coverage gives a more accurate distance to the outline.
+			float distance;
+			if (coverage[i] > 0.f && coverage[i] < 1.f)
+				distance = coverage[i] - 0.5f;
+			else if (coverage[i] >= 0.5f)
+				distance = Math::SquareRoot(to_outside[i]) - 0.5f;
+			else
+				distance = 0.5f - Math::SquareRoot(to_inside[i]);
+
+			const float value = 128.f + distance * (127.f / field->spread);
+			field->data[i] = byte(Math::Clamp(value, 0.f, 255.f) + 0.5f);
+		}
+
+		result = std::move(field);
+	}
+
+	float bitmap_scaling_factor = 1.f;
+	if (!SetFontSize(ft_face, font_size, bitmap_scaling_factor))
+		return nullptr;
+
+	return result.get();
+}
+
+static void DistanceTransform(float* data, const int width, const int height)
+{
+	// Exact squared euclidean distance transform, by Felzenszwalb and Huttenlocher, applied in one dimension to each column and then to each row.
+	const int size = Math::Max(width, height);
+	Vector<float> f(size), d(size), z(size + 1);
+	Vector<int> v(size);
+
+	auto transform_1d = [&](const int n) {
+		int k = 0;
+		v[0] = 0;
+		z[0] = -FLT_MAX;
+		z[1] = FLT_MAX;
+		for (int q = 1; q < n; q++)
+		{
+			float s = ((f[q] + float(q * q)) - (f[v[k]] + float(v[k] * v[k]))) / float(2 * q - 2 * v[k]);
+			while (s <= z[k])
+			{
+				k--;
+				s = ((f[q] + float(q * q)) - (f[v[k]] + float(v[k] * v[k]))) / float(2 * q - 2 * v[k]);
+			}
+			k++;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = FLT_MAX;
+		}
+
+		k = 0;
+		for (int q = 0; q < n; q++)
+		{
+			while (z[k + 1] < float(q))
+				k++;
+			const float dq = float(q - v[k]);
+			d[q] = dq * dq + f[v[k]];
+		}
+	};
+
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+			f[y] = data[y * width + x];
+		transform_1d(height);
+		for (int y = 0; y < height; y++)
+			data[y * width + x] = d[y];
+	}
+
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+			f[x] = data[y * width + x];
+		transform_1d(width);
+		for (int x = 0; x < width; x++)
+			data[y * width + x] = d[x];
+	}
+}
+
+static void GenerateBitmapFromDistanceField(FontGlyph& glyph, const FontGlyphDistanceField& field, const int font_size)
+{
+	const float scale = float(font_size) / float(field.reference_size);
+	glyph.distance_field = &field;
+	glyph.distance_field_scale = scale;
+
+	// Cover the glyph's outline at this size, leaving out the padding of the field, with an extra pixel on each side for anti-aliasing.
+	const int padding = int(field.spread) + 1;
+	const int left = Math::RoundDownToInteger(float(field.offset.x + padding) * scale) - 1;
+	const int top = Math::RoundDownToInteger(float(field.offset.y + padding) * scale) - 1;
+	const int right = Math::RoundUpToInteger(float(field.offset.x + field.dimensions.x - padding) * scale) + 1;
+	const int bottom = Math::RoundUpToInteger(float(field.offset.y + field.dimensions.y - padding) * scale) + 1;
+
+	glyph.bearing = Vector2i(left, -top);
+	glyph.bitmap_dimensions = Vector2i(right - left, bottom - top);
+	glyph.color_format = ColorFormat::A8;
+
+	if (field.dimensions.x <= 2 * padding || field.dimensions.y <= 2 * padding)
+	{
+		glyph.bitmap_dimensions = Vector2i(0);
+		return;
+	}
+
+	glyph.bitmap_owned_data.reset(new byte[glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y]);
+	glyph.bitmap_data = glyph.bitmap_owned_data.get();
+
+	// The coverage of each pixel is estimated from the distance between its center and the outline.
+	const int num_pixels = glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y;
+	Vector<float> distances(num_pixels);
+	glyph.GetDistances(Vector2i(0), glyph.bitmap_dimensions, distances.data());
+
+	byte* destination = glyph.bitmap_owned_data.get();
+	for (int i = 0; i < num_pixels; i++)
+		destination[i] = byte(Math::Clamp(0.5f + distances[i], 0.f, 1.f) * 255.f + 0.5f);
+}
+
 static void BitmapDownscale(byte* bitmap_new, const int new_width, const int new_height, const byte* bitmap_source, const int width, const int height,
 	const int pitch, const ColorFormat color_format)
 {
@@ -53,16 +53,25 @@ namespace FreeType {
 	// Retrieves the font family, style and weight of the given font face. Use nullptr to ignore a property.
 	void GetFaceStyle(FontFaceHandleFreetype face, String* font_family, Style::FontStyle* style, Style::FontWeight* weight);
 
+	// Returns a hash identifying the font file and face, based on the checksum stored in the font. Returns zero if the font has no checksum.
+	size_t GetFaceFingerprint(FontFaceHandleFreetype face);
+
 	// Initializes a face for a given font size. Glyphs are filled with the ASCII subset, and the font face metrics are set.
-	bool InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs);
+	// When 'distance_fields' is set, glyph bitmaps are generated from the distance fields of the face, which are built as needed.
+	bool InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphTable& glyphs, FontMetrics& metrics, bool load_default_glyphs,
+		FontFaceDistanceFields* distance_fields = nullptr);
 
 	// Build a new glyph representing the given code point and append to 'glyphs'.
-	bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs);
+	bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphTable& glyphs,
+		FontFaceDistanceFields* distance_fields = nullptr);
 
 	// Returns the kerning between two characters.
 	// 'font_size' value of zero assumes the font size is already set on the face, and skips this step for performance reasons.
 	int GetKerning(FontFaceHandleFreetype face, int font_size, Character lhs, Character rhs);
 
+	// Fills the kerning between all pairs of characters in the range [first, last], indexed by (lhs - first) * (last - first + 1) + rhs - first.
+	void GetKerningTable(FontFaceHandleFreetype face, int font_size, Character first, Character last, Vector<std::int16_t>& kerning);
+
 	// Returns true if the font face has kerning.
 	bool HasKerning(FontFaceHandleFreetype face);
 
@@ -0,0 +1,145 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "ShapedRunCache.h"
+
+namespace Rml {
+
+static ShapedRunKey CreateKey(const String& string, float letter_spacing, Character prior_character)
+{
+	return ShapedRunKey{Hash<String>()(string), letter_spacing, prior_character};
+}
+
+ShapedRunCache::ShapedRunCache(int capacity) : capacity(Math::Max(capacity, 1)) {}
+
+const ShapedRun* ShapedRunCache::Find(const String& string, float letter_spacing, Character prior_character)
+{
+	auto it = entry_map.find(CreateKey(string, letter_spacing, prior_character));
+	if (it == entry_map.end())
+		return nullptr;
+
+	const int index = it->second;
+	Entry& entry = entries[index];
+
+	// Different strings may share a hash, only accept the run for the string it was shaped from.
+	if (entry.run.string != string)
+		return nullptr;
+
+	if (index != most_recent)
+	{
+		Unlink(index);
+		LinkFront(index);
+	}
+
+	return &entry.run;
+}
+
+ShapedRun& ShapedRunCache::Insert(const String& string, float letter_spacing, Character prior_character)
+{
+	const ShapedRunKey key = CreateKey(string, letter_spacing, prior_character);
+
+	int index = -1;
+	auto it = entry_map.find(key);
+	if (it != entry_map.end())
+	{
+		// Replace the run of a different string with the same key.
+		index = it->second;
+		Unlink(index);
+	}
+	else if ((int)entries.size() < capacity)
+	{
+		index = (int)entries.size();
+		entries.emplace_back();
+		entry_map.emplace(key, index);
+	}
+	else
+	{
+		// Evict the least recently used run, and reuse its buffers.
+		index = least_recent;
+		Unlink(index);
+		entry_map.erase(entries[index].key);
+		entry_map.emplace(key, index);
+	}
+
+	Entry& entry = entries[index];
+	entry.key = key;
+	entry.run.string = string;
+	entry.run.glyphs.clear();
+	entry.run.width = 0;
+
+	LinkFront(index);
+
+	return entry.run;
+}
+
+void ShapedRunCache::Clear()
+{
+	Vector<Entry>().swap(entries);
+	UnorderedMap<ShapedRunKey, int>().swap(entry_map);
+	most_recent = -1;
+	least_recent = -1;
+}
+
+int ShapedRunCache::GetNumRuns() const
+{
+	return (int)entries.size();
+}
+
+void ShapedRunCache::Unlink(const int index)
+{
+	Entry& entry = entries[index];
+
+	if (entry.previous >= 0)
+		entries[entry.previous].next = entry.next;
+	else
+		most_recent = entry.next;
+
+	if (entry.next >= 0)
+		entries[entry.next].previous = entry.previous;
+	else
+		least_recent = entry.previous;
+
+	entry.previous = -1;
+	entry.next = -1;
+}
+
+void ShapedRunCache::LinkFront(const int index)
+{
+	Entry& entry = entries[index];
+	entry.previous = -1;
+	entry.next = most_recent;
+
+	if (most_recent >= 0)
+		entries[most_recent].previous = index;
+	else
+		least_recent = index;
+
+	most_recent = index;
+}
+
+} // namespace Rml
@@ -0,0 +1,126 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_SHAPEDRUNCACHE_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_SHAPEDRUNCACHE_H
+
+#include "../../../Include/RmlUi/Core/Types.h"
+#include "../../../Include/RmlUi/Core/Utilities.h"
+
+namespace Rml {
+
+// Identifies a shaped run, together with the string it was shaped from.
+struct ShapedRunKey {
+	std::size_t string_hash;
+	float letter_spacing;
+	Character prior_character;
+
+	bool operator==(const ShapedRunKey& other) const
+	{
+		return string_hash == other.string_hash && letter_spacing == other.letter_spacing && prior_character == other.prior_character;
+	}
+};
+
+} // namespace Rml
+
+namespace std {
+// Hash specialization for the shaped run key, so it can be used as key in UnorderedMap.
+template <>
+struct hash<::Rml::ShapedRunKey> {
+	std::size_t operator()(const ::Rml::ShapedRunKey& key) const noexcept
+	{
+		std::size_t seed = key.string_hash;
+		::Rml::Utilities::HashCombine(seed, key.letter_spacing);
+		::Rml::Utilities::HashCombine(seed, char32_t(key.prior_character));
+		return seed;
+	}
+};
+} // namespace std
+
+namespace Rml {
+
+// A glyph of a shaped run.
+struct ShapedGlyph {
+	// The character to render, after any substitution such as by the replacement character.
+	Character character;
+	// The horizontal offset of the glyph from the start of the run, in pixels.
+	int offset;
+	// True for glyphs with color bitmaps, which are not tinted by the text color.
+	bool is_color;
+};
+
+// A string laid out with a font face: its glyphs, their positions including kerning and letter spacing, and its total width.
+struct ShapedRun {
+	String string;
+	Vector<ShapedGlyph> glyphs;
+	int width = 0;
+};
+
+/**
+    A least recently used cache of shaped runs, so that repeatedly measured and generated strings don't need to be decoded and laid out
+    glyph by glyph every time.
+ */
+
+class ShapedRunCache : NonCopyMoveable {
+public:
+	ShapedRunCache(int capacity);
+
+	/// Returns the run previously shaped from the given string and parameters, or nullptr if it is not in the cache.
+	const ShapedRun* Find(const String& string, float letter_spacing, Character prior_character);
+
+	/// Inserts a run for the given string and parameters, evicting the least recently used run when the cache is full.
+	/// @return The new run to be filled in, it may reuse the buffers of an evicted run.
+	ShapedRun& Insert(const String& string, float letter_spacing, Character prior_character);
+
+	/// Removes all runs and releases their memory.
+	void Clear();
+
+	/// Returns the number of runs in the cache.
+	int GetNumRuns() const;
+
+private:
+	struct Entry {
+		ShapedRunKey key;
+		ShapedRun run;
+		// Neighbours in the usage list, ordered from most to least recently used.
+		int previous = -1;
+		int next = -1;
+	};
+
+	void Unlink(int index);
+	void LinkFront(int index);
+
+	int capacity;
+	Vector<Entry> entries;
+	UnorderedMap<ShapedRunKey, int> entry_map;
+	int most_recent = -1;
+	int least_recent = -1;
+};
+
+} // namespace Rml
+#endif
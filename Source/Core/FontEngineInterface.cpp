@@ -78,6 +78,10 @@ int FontEngineInterface::GetVersion(FontFaceHandle /*handle*/)
 	return 0;
 }
 
+void FontEngineInterface::AddFontFaceHandleReference(FontFaceHandle /*handle*/) {}
+
+void FontEngineInterface::RemoveFontFaceHandleReference(FontFaceHandle /*handle*/) {}
+
 void FontEngineInterface::ReleaseFontResources() {}
 
 } // namespace Rml
@@ -0,0 +1,97 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../Include/RmlUi/Core/Math.h"
+
+namespace Rml {
+
+void FontGlyph::GetDistances(const Vector2i offset, const Vector2i dimensions, float* distances) const
+{
+	RMLUI_ASSERT(distance_field && distance_field->data);
+	const FontGlyphDistanceField& field = *distance_field;
+
+	if (dimensions.x <= 0 || dimensions.y <= 0)
+		return;
+
+	// Find the positions of the pixel centers in the field's pixel grid, where its own pixel centers are located at whole numbers. Positions
+	// outside the field take the distance at its edge, reduced by the remaining distance to the position.
+	struct Sample {
+		int index0, index1;
+		float t;
+		float outside_distance;
+	};
+	auto locate = [this](int pixel, int bitmap_origin, int field_offset, int field_size) {
+		const float position = (float(bitmap_origin + pixel) + 0.5f) / distance_field_scale - float(field_offset) - 0.5f;
+		const float clamped_position = Math::Clamp(position, 0.f, float(field_size - 1));
+		Sample sample;
+		sample.index0 = int(clamped_position);
+		sample.index1 = Math::Min(sample.index0 + 1, field_size - 1);
+		sample.t = clamped_position - float(sample.index0);
+		sample.outside_distance = position - clamped_position;
+		return sample;
+	};
+
+	Vector<Sample> columns(dimensions.x);
+	for (int x = 0; x < dimensions.x; x++)
+		columns[x] = locate(offset.x + x, bearing.x, field.offset.x, field.dimensions.x);
+
+	const float value_to_distance = (field.spread / 127.f) * distance_field_scale;
+	const float outside_to_distance = distance_field_scale;
+
+	for (int y = 0; y < dimensions.y; y++)
+	{
+		const Sample row = locate(offset.y + y, -bearing.y, field.offset.y, field.dimensions.y);
+		const byte* row0 = field.data.get() + row.index0 * field.dimensions.x;
+		const byte* row1 = field.data.get() + row.index1 * field.dimensions.x;
+		float* destination = distances + y * dimensions.x;
+
+		for (int x = 0; x < dimensions.x; x++)
+		{
+			const Sample& column = columns[x];
+			const float top = Math::Lerp(column.t, float(row0[column.index0]), float(row0[column.index1]));
+			const float bottom = Math::Lerp(column.t, float(row1[column.index0]), float(row1[column.index1]));
+			float distance = (Math::Lerp(row.t, top, bottom) - 128.f) * value_to_distance;
+
+			if (column.outside_distance != 0.f || row.outside_distance != 0.f)
+			{
+				const float outside_distance = Vector2f(column.outside_distance, row.outside_distance).Magnitude();
+				distance -= outside_distance * outside_to_distance;
+			}
+
+			destination[x] = distance;
+		}
+	}
+}
+
+float FontGlyph::GetDistanceFieldSpread() const
+{
+	return distance_field ? distance_field->spread * distance_field_scale : 0.f;
+}
+
+} // namespace Rml
@@ -37,6 +37,17 @@
 
 namespace Rml {
 
+static Rectanglef FullTextureRegion()
+{
+	return Rectanglef::FromSize(Vector2f(1.f));
+}
+
+static Colourb ModulateColour(Colourb colour, Colourb modulation)
+{
+	return Colourb(byte((int(colour.red) * int(modulation.red)) / 255), byte((int(colour.green) * int(modulation.green)) / 255),
+		byte((int(colour.blue) * int(modulation.blue)) / 255), byte((int(colour.alpha) * int(modulation.alpha)) / 255));
+}
+
 Geometry::Geometry()
 {
 	database_handle = GeometryDatabase::Insert(this);
@@ -57,6 +68,9 @@ Geometry& Geometry::operator=(Geometry&& other) noexcept
 
 void Geometry::MoveFrom(Geometry& other) noexcept
 {
+	if (batch_handle)
+		GeometryDatabase::EraseFromBatch(batch_handle);
+
 	vertices = std::move(other.vertices);
 	indices = std::move(other.indices);
 
@@ -64,12 +78,93 @@ void Geometry::MoveFrom(Geometry& other) noexcept
 
 	compiled_geometry = std::exchange(other.compiled_geometry, 0);
 	compile_attempted = std::exchange(other.compile_attempted, false);
+	compiled_texture_handle = std::exchange(other.compiled_texture_handle, 0);
+	arena_handle = std::exchange(other.arena_handle, 0);
+	batch_handle = std::exchange(other.batch_handle, 0);
+	texcoord_region = std::exchange(other.texcoord_region, FullTextureRegion());
+	unmapped_tex_coords = std::move(other.unmapped_tex_coords);
+	vertex_colour_modulation = std::exchange(other.vertex_colour_modulation, Colourb(255, 255, 255, 255));
+	unmodulated_colours = std::move(other.unmodulated_colours);
+}
+
+void Geometry::DetachFromArena(bool restore_data)
+{
+	if (!arena_handle)
+		return;
+
+	// The local copy is only freed once our chunk is compiled, until then it is identical to the data in the arena.
+	if (restore_data && vertices.empty())
+		GeometryDatabase::CopyFromArena(arena_handle, vertices, indices);
+
+	GeometryDatabase::EraseFromArena(arena_handle);
+	arena_handle = 0;
+	compile_attempted = false;
+}
+
+void Geometry::SetTexCoordRegion(Rectanglef region)
+{
+	DetachFromArena(true);
+	Release();
+
+	if (unmapped_tex_coords.empty())
+	{
+		unmapped_tex_coords.reserve(vertices.size());
+		for (const Vertex& vertex : vertices)
+			unmapped_tex_coords.push_back(vertex.tex_coord);
+	}
+
+	RMLUI_ASSERT(unmapped_tex_coords.size() == vertices.size());
+
+	// Always map from the original texture coordinates, so that rounding errors do not accumulate as the region changes.
+	if (region == FullTextureRegion())
+	{
+		for (size_t i = 0; i < vertices.size(); i++)
+			vertices[i].tex_coord = unmapped_tex_coords[i];
+		Vector<Vector2f>().swap(unmapped_tex_coords);
+	}
+	else
+	{
+		for (size_t i = 0; i < vertices.size(); i++)
+			vertices[i].tex_coord = region.Position() + unmapped_tex_coords[i] * region.Size();
+	}
+
+	texcoord_region = region;
+}
+
+void Geometry::SetVertexColourModulation(Colourb colour)
+{
+	DetachFromArena(true);
+	Release();
+
+	if (unmodulated_colours.empty())
+	{
+		unmodulated_colours.reserve(vertices.size());
+		for (const Vertex& vertex : vertices)
+			unmodulated_colours.push_back(vertex.colour);
+	}
+
+	RMLUI_ASSERT(unmodulated_colours.size() == vertices.size());
+
+	if (colour == Colourb(255, 255, 255, 255))
+	{
+		for (size_t i = 0; i < vertices.size(); i++)
+			vertices[i].colour = unmodulated_colours[i];
+		Vector<Colourb>().swap(unmodulated_colours);
+	}
+	else
+	{
+		for (size_t i = 0; i < vertices.size(); i++)
+			vertices[i].colour = ModulateColour(unmodulated_colours[i], colour);
+	}
+
+	vertex_colour_modulation = colour;
 }
 
 Geometry::~Geometry()
 {
 	GeometryDatabase::Erase(database_handle);
 
+	DetachFromArena(false);
 	Release();
 }
 
@@ -78,8 +173,26 @@ void Geometry::Render(Vector2f translation)
 	RenderInterface* const render_interface = ::Rml::GetRenderInterface();
 	RMLUI_ASSERT(render_interface);
 
+	// Nothing to render, avoid loading our texture. This is common for font textures without any of the glyphs of a string.
+	if (!compiled_geometry && !arena_handle && !batch_handle && (vertices.empty() || indices.empty()))
+		return;
+
 	translation = translation.Round();
 
+	// Apply the active colour modulation to our vertices if the render interface doesn't take care of it.
+	const Colourb modulation = GeometryDatabase::GetVertexColourModulation();
+	if (modulation != vertex_colour_modulation)
+		SetVertexColourModulation(modulation);
+
+	// Images in the texture atlas move around as other images come and go, make sure our texture coordinates refer to the current region.
+	const Rectanglef region = (texture ? texture->GetAtlasRegion() : FullTextureRegion());
+	if (region != texcoord_region)
+		SetTexCoordRegion(region);
+
+	// Compiled geometry holds on to the texture handle, make sure to recompile it if our texture has been regenerated since.
+	if ((compiled_geometry || batch_handle) && compiled_texture_handle != (texture ? texture->GetHandle() : 0))
+		Release();
+
 	// Render our compiled geometry if possible.
 	if (compiled_geometry)
 	{
@@ -90,28 +203,64 @@ void Geometry::Render(Vector2f translation)
 	// immediate mode.
 	else
 	{
+		if (arena_handle)
+		{
+			RMLUI_ZoneScopedN("RenderArena");
+			if (GeometryDatabase::RenderFromArena(arena_handle, texture ? texture->GetHandle() : 0, translation))
+			{
+				// Our chunk has been compiled, so the local copy of the data is no longer needed.
+				if (!vertices.empty())
+				{
+					Vector<Vertex>().swap(vertices);
+					Vector<int>().swap(indices);
+				}
+				return;
+			}
+
+			// We were placed in the chunk after it was last compiled. It is compiled again at the start of the next context render, until then
+			// we render from our local copy. If we no longer have a local copy, we were rendered from the chunk before and it has since been
+			// released or failed to compile, so take back our data and handle it separately instead.
+			if (vertices.empty())
+				DetachFromArena(true);
+		}
+
 		if (vertices.empty() || indices.empty())
 			return;
 
 		RMLUI_ZoneScopedN("RenderGeometry");
 
-		if (!compile_attempted)
+		if (batch_handle)
+		{
+			// Our batch is compiled at the start of the next context render, until then we render in immediate mode.
+			if (GeometryDatabase::TakeFromBatch(batch_handle, compiled_geometry))
+			{
+				batch_handle = 0;
+				if (compiled_geometry)
+				{
+					render_interface->RenderCompiledGeometry(compiled_geometry, translation);
+					return;
+				}
+			}
+		}
+		else if (!compile_attempted)
 		{
 			compile_attempted = true;
-			compiled_geometry = render_interface->CompileGeometry(&vertices[0], (int)vertices.size(), &indices[0], (int)indices.size(),
-				texture ? texture->GetHandle() : 0);
 
-			// If we managed to compile the geometry, we can clear the local copy of vertices and indices and
-			// immediately render the compiled version.
-			if (compiled_geometry)
-			{
-				render_interface->RenderCompiledGeometry(compiled_geometry, translation);
+			// Prefer to place the data in the geometry arena, where it is compiled together with lots of other geometry.
+			arena_handle = GeometryDatabase::InsertIntoArena(vertices, indices);
+			if (arena_handle && GeometryDatabase::RenderFromArena(arena_handle, texture ? texture->GetHandle() : 0, translation))
 				return;
+
+			// Otherwise, stage the geometry to be compiled together with other geometry first rendered this frame. Compiled geometry holds
+			// on to the texture handle, thus we avoid compiling atlas textures as their handles may change.
+			if (!arena_handle && texcoord_region == FullTextureRegion())
+			{
+				compiled_texture_handle = (texture ? texture->GetHandle() : 0);
+				batch_handle = GeometryDatabase::InsertIntoBatch(vertices, indices, compiled_texture_handle);
 			}
 		}
 
-		// Either we've attempted to compile before (and failed), or the compile we just attempted failed; either way,
-		// render the uncompiled version.
+		// Either the geometry is waiting to be compiled, or it could not be compiled; either way, render the uncompiled version.
 		render_interface->RenderGeometry(&vertices[0], (int)vertices.size(), &indices[0], (int)indices.size(), texture ? texture->GetHandle() : 0,
 			translation);
 	}
@@ -119,11 +268,17 @@ void Geometry::Render(Vector2f translation)
 
 Vector<Vertex>& Geometry::GetVertices()
 {
+	DetachFromArena(true);
+	if (texcoord_region != FullTextureRegion())
+		SetTexCoordRegion(FullTextureRegion());
+	if (vertex_colour_modulation != Colourb(255, 255, 255, 255))
+		SetVertexColourModulation(Colourb(255, 255, 255, 255));
 	return vertices;
 }
 
 Vector<int>& Geometry::GetIndices()
 {
+	DetachFromArena(true);
 	return indices;
 }
 
@@ -135,7 +290,10 @@ const Texture* Geometry::GetTexture() const
 void Geometry::SetTexture(const Texture* _texture)
 {
 	texture = _texture;
-	Release();
+
+	// Geometry in the arena is rendered with the current texture, so there is nothing to recompile.
+	if (!arena_handle)
+		Release();
 }
 
 void Geometry::Release(bool clear_buffers)
@@ -146,18 +304,29 @@ void Geometry::Release(bool clear_buffers)
 		compiled_geometry = 0;
 	}
 
+	if (batch_handle)
+	{
+		GeometryDatabase::EraseFromBatch(batch_handle);
+		batch_handle = 0;
+	}
+
 	compile_attempted = false;
 
 	if (clear_buffers)
 	{
+		DetachFromArena(false);
 		vertices.clear();
 		indices.clear();
+		texcoord_region = FullTextureRegion();
+		Vector<Vector2f>().swap(unmapped_tex_coords);
+		vertex_colour_modulation = Colourb(255, 255, 255, 255);
+		Vector<Colourb>().swap(unmodulated_colours);
 	}
 }
 
 Geometry::operator bool() const
 {
-	return !indices.empty();
+	return !indices.empty() || arena_handle;
 }
 
 } // namespace Rml
@@ -34,6 +34,9 @@
 
 namespace Rml {
 
+// The maximum number of points along each corner arc.
+static constexpr int max_num_points = 100;
+
 GeometryBackgroundBorder::GeometryBackgroundBorder(Vector<Vertex>& vertices, Vector<int>& indices) : vertices(vertices), indices(indices) {}
 
 void GeometryBackgroundBorder::Draw(Vector<Vertex>& vertices, Vector<int>& indices, CornerSizes radii, const Box& box, const Vector2f offset,
@@ -134,12 +137,27 @@ void GeometryBackgroundBorder::Draw(Vector<Vertex>& vertices, Vector<int>& indic
 	GeometryBackgroundBorder geometry(vertices, indices);
 
 	{
-		// Reserve geometry. A conservative estimate, does not take border-radii into account and assumes same-colored borders.
-		const int estimated_num_vertices = 4 * int(has_background) + 2 * num_borders;
-		const int estimated_num_triangles = 2 * int(has_background) + 2 * num_borders;
+		// Reserve geometry. An upper bound taking the number of points along each corner into account, so that the buffers are only
+		// allocated once.
+		int max_num_vertices = 0;
+		int max_num_indices = 0;
+		for (int corner = 0; corner < 4; corner++)
+		{
+			const int num_points = (has_radius && radii[corner] > 0 ? GetNumPoints(radii[corner]) : 1);
+			if (has_background)
+			{
+				max_num_vertices += num_points;
+				max_num_indices += 3 * num_points;
+			}
+			if (has_border)
+			{
+				max_num_vertices += 2 * num_points + 2;
+				max_num_indices += 6 * num_points + 6;
+			}
+		}
 
-		vertices.reserve((int)vertices.size() + estimated_num_vertices);
-		indices.reserve((int)indices.size() + 3 * estimated_num_triangles);
+		vertices.reserve(vertices.size() + max_num_vertices);
+		indices.reserve(indices.size() + max_num_indices);
 	}
 
 	// Draw the background
@@ -225,10 +243,8 @@ void GeometryBackgroundBorder::DrawBackgroundCorner(Corner corner, Vector2f pos_
 	}
 	else if (r.x > 0 && r.y > 0)
 	{
-		const float a0 = float((int)corner + 2) * 0.5f * Math::RMLUI_PI;
-		const float a1 = float((int)corner + 3) * 0.5f * Math::RMLUI_PI;
 		const int num_points = GetNumPoints(R);
-		DrawArc(pos_circle_center, r, a0, a1, color, color, num_points);
+		DrawArc(pos_circle_center, r, corner, color, color, num_points);
 	}
 }
 
@@ -242,11 +258,13 @@ void GeometryBackgroundBorder::DrawPoint(Vector2f pos, Colourb color)
 	vertices[offset_vertices].colour = color;
 }
 
-void GeometryBackgroundBorder::DrawArc(Vector2f pos_center, Vector2f r, float a0, float a1, Colourb color0, Colourb color1, int num_points)
+void GeometryBackgroundBorder::DrawArc(Vector2f pos_center, Vector2f r, Corner corner, Colourb color0, Colourb color1, int num_points)
 {
 	RMLUI_ASSERT(num_points >= 2 && r.x > 0 && r.y > 0);
 
 	const int offset_vertices = (int)vertices.size();
+	const Vector2f* unit_vectors = GetUnitArc(corner, num_points);
+	const bool interpolate_color = (color0 != color1);
 
 	vertices.resize(offset_vertices + num_points);
 
@@ -254,12 +272,8 @@ void GeometryBackgroundBorder::DrawArc(Vector2f pos_center, Vector2f r, float a0
 	{
 		const float t = float(i) / float(num_points - 1);
 
-		const float a = Math::Lerp(t, a0, a1);
-
-		const Vector2f unit_vector(Math::Cos(a), Math::Sin(a));
-
-		vertices[offset_vertices + i].position = unit_vector * r + pos_center;
-		vertices[offset_vertices + i].colour = Math::RoundedLerp(t, color0, color1);
+		vertices[offset_vertices + i].position = unit_vectors[i] * r + pos_center;
+		vertices[offset_vertices + i].colour = (interpolate_color ? Math::RoundedLerp(t, color0, color1) : color0);
 	}
 }
 
@@ -283,20 +297,17 @@ void GeometryBackgroundBorder::FillBackground(int index_start)
 void GeometryBackgroundBorder::DrawBorderCorner(Corner corner, Vector2f pos_outer, Vector2f pos_inner, Vector2f pos_circle_center, float R,
 	Vector2f r, Colourb color0, Colourb color1)
 {
-	const float a0 = float((int)corner + 2) * 0.5f * Math::RMLUI_PI;
-	const float a1 = float((int)corner + 3) * 0.5f * Math::RMLUI_PI;
-
 	if (R == 0)
 	{
 		DrawPointPoint(pos_outer, pos_inner, color0, color1);
 	}
 	else if (r.x > 0 && r.y > 0)
 	{
-		DrawArcArc(pos_circle_center, R, r, a0, a1, color0, color1, GetNumPoints(R));
+		DrawArcArc(pos_circle_center, R, r, corner, color0, color1, GetNumPoints(R));
 	}
 	else
 	{
-		DrawArcPoint(pos_circle_center, pos_inner, R, a0, a1, color0, color1, GetNumPoints(R));
+		DrawArcPoint(pos_circle_center, pos_inner, R, corner, color0, color1, GetNumPoints(R));
 	}
 }
 
@@ -316,7 +327,7 @@ void GeometryBackgroundBorder::DrawPointPoint(Vector2f pos_outer, Vector2f pos_i
 	}
 }
 
-void GeometryBackgroundBorder::DrawArcArc(Vector2f pos_center, float R, Vector2f r, float a0, float a1, Colourb color0, Colourb color1,
+void GeometryBackgroundBorder::DrawArcArc(Vector2f pos_center, float R, Vector2f r, Corner corner, Colourb color0, Colourb color1,
 	int num_points)
 {
 	RMLUI_ASSERT(num_points >= 2 && R > 0 && r.x > 0 && r.y > 0);
@@ -325,6 +336,8 @@ void GeometryBackgroundBorder::DrawArcArc(Vector2f pos_center, float R, Vector2f
 
 	const int offset_vertices = (int)vertices.size();
 	const int offset_indices = (int)indices.size();
+	const Vector2f* unit_vectors = GetUnitArc(corner, num_points);
+	const bool interpolate_color = (color0 != color1);
 
 	vertices.resize(offset_vertices + 2 * num_points);
 	indices.resize(offset_indices + 3 * num_triangles);
@@ -333,9 +346,8 @@ void GeometryBackgroundBorder::DrawArcArc(Vector2f pos_center, float R, Vector2f
 	{
 		const float t = float(i) / float(num_points - 1);
 
-		const float a = Math::Lerp(t, a0, a1);
-		const Colourb color = Math::RoundedLerp(t, color0, color1);
-		const Vector2f unit_vector(Math::Cos(a), Math::Sin(a));
+		const Colourb color = (interpolate_color ? Math::RoundedLerp(t, color0, color1) : color0);
+		const Vector2f unit_vector = unit_vectors[i];
 
 		vertices[offset_vertices + 2 * i].position = unit_vector * r + pos_center;
 		vertices[offset_vertices + 2 * i].colour = color;
@@ -355,7 +367,7 @@ void GeometryBackgroundBorder::DrawArcArc(Vector2f pos_center, float R, Vector2f
 	}
 }
 
-void GeometryBackgroundBorder::DrawArcPoint(Vector2f pos_center, Vector2f pos_inner, float R, float a0, float a1, Colourb color0, Colourb color1,
+void GeometryBackgroundBorder::DrawArcPoint(Vector2f pos_center, Vector2f pos_inner, float R, Corner corner, Colourb color0, Colourb color1,
 	int num_points)
 {
 	RMLUI_ASSERT(R > 0 && num_points >= 2);
@@ -365,7 +377,7 @@ void GeometryBackgroundBorder::DrawArcPoint(Vector2f pos_center, Vector2f pos_in
 
 	// Generate the vertices. We could also split the arc mid-way to create a sharp color transition.
 	DrawPoint(pos_inner, color0);
-	DrawArc(pos_center, Vector2f(R), a0, a1, color0, color1, num_points);
+	DrawArc(pos_center, Vector2f(R), corner, color0, color1, num_points);
 	DrawPoint(pos_inner, color1);
 
 	RMLUI_ASSERT((int)vertices.size() - offset_vertices == num_points + 2);
@@ -412,9 +424,33 @@ void GeometryBackgroundBorder::FillEdge(int index_next_corner)
 	indices[offset_indices + 5] = index_next_corner + 1;
 }
 
-int GeometryBackgroundBorder::GetNumPoints(float R) const
+int GeometryBackgroundBorder::GetNumPoints(float R)
 {
-	return Math::Clamp(3 + Math::RoundToInteger(R / 6.f), 2, 100);
+	return Math::Clamp(3 + Math::RoundToInteger(R / 6.f), 2, max_num_points);
+}
+
+const Vector2f* GeometryBackgroundBorder::GetUnitArc(Corner corner, int num_points)
+{
+	RMLUI_ASSERT(num_points >= 2 && num_points <= max_num_points);
+
+	static Array<Array<Vector<Vector2f>, max_num_points + 1>, 4> unit_arcs;
+
+	Vector<Vector2f>& unit_arc = unit_arcs[corner][num_points];
+	if (unit_arc.empty())
+	{
+		const float a0 = float((int)corner + 2) * 0.5f * Math::RMLUI_PI;
+		const float a1 = float((int)corner + 3) * 0.5f * Math::RMLUI_PI;
+
+		unit_arc.resize(num_points);
+		for (int i = 0; i < num_points; i++)
+		{
+			const float t = float(i) / float(num_points - 1);
+			const float a = Math::Lerp(t, a0, a1);
+			unit_arc[i] = Vector2f(Math::Cos(a), Math::Sin(a));
+		}
+	}
+
+	return unit_arc.data();
 }
 
 } // namespace Rml
@@ -72,9 +72,9 @@ private:
 	// Add a single point.
 	void DrawPoint(Vector2f pos, Colourb color);
 
-	// Draw an arc by placing vertices along the ellipse formed by the two-axis radius r, spaced evenly between angles a0,a1 (inclusive). Colors are
-	// interpolated.
-	void DrawArc(Vector2f pos_center, Vector2f r, float a0, float a1, Colourb color0, Colourb color1, int num_points);
+	// Draw an arc by placing vertices along the ellipse formed by the two-axis radius r, spaced evenly along the quarter of the ellipse at the given
+	// corner (inclusive). Colors are interpolated.
+	void DrawArc(Vector2f pos_center, Vector2f r, Corner corner, Colourb color0, Colourb color1, int num_points);
 
 	// Generates triangles by connecting the added vertices.
 	void FillBackground(int index_start);
@@ -96,17 +96,21 @@ private:
 	void DrawPointPoint(Vector2f pos_outer, Vector2f pos_inner, Colourb color0, Colourb color1);
 
 	// Draw an arc along the outer edge (radius R), and an arc along the inner edge (two-axis radius r),
-	// spaced evenly between angles a0,a1 (inclusive). Connect them by triangles. Colors are interpolated.
-	void DrawArcArc(Vector2f pos_center, float R, Vector2f r, float a0, float a1, Colourb color0, Colourb color1, int num_points);
+	// spaced evenly along the quarter circle at the given corner (inclusive). Connect them by triangles. Colors are interpolated.
+	void DrawArcArc(Vector2f pos_center, float R, Vector2f r, Corner corner, Colourb color0, Colourb color1, int num_points);
 
 	// Draw an arc along the outer edge, and connect them by triangles to a point on the inner edge.
-	void DrawArcPoint(Vector2f pos_center, Vector2f pos_inner, float R, float a0, float a1, Colourb color0, Colourb color1, int num_points);
+	void DrawArcPoint(Vector2f pos_center, Vector2f pos_inner, float R, Corner corner, Colourb color0, Colourb color1, int num_points);
 
 	// Add triangles between the previous corner to another one specified by the index (possibly yet-to-be-drawn).
 	void FillEdge(int index_next_corner);
 
 	// -- Tools --
-	int GetNumPoints(float R) const;
+	static int GetNumPoints(float R);
+
+	// Returns the unit vectors of an arc along the quarter circle at the given corner, tessellated into the given number of points. The arcs are
+	// cached by their number of points, thereby they can be scaled and translated into place without evaluating any trigonometric functions.
+	static const Vector2f* GetUnitArc(Corner corner, int num_points);
 
 	Vector<Vertex>& vertices;
 	Vector<int>& indices;
@@ -27,8 +27,11 @@
  */
 
 #include "GeometryDatabase.h"
+#include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/RenderInterface.h"
 #include <algorithm>
+#include <string.h>
 
 namespace Rml {
 namespace GeometryDatabase {
@@ -111,6 +114,564 @@ namespace GeometryDatabase {
 
 	static Database geometry_database;
 
+	// Hands out ranges from a buffer of fixed capacity. Free ranges are kept sorted by offset, and merged with their neighbors when released.
+	class RangeAllocator {
+	public:
+		explicit RangeAllocator(int capacity) : capacity(capacity), free_ranges{Range{0, capacity}} {}
+
+		bool allocate(int size, int& out_offset)
+		{
+			for (auto it = free_ranges.begin(); it != free_ranges.end(); ++it)
+			{
+				if (it->size >= size)
+				{
+					out_offset = it->offset;
+					it->offset += size;
+					it->size -= size;
+					if (it->size == 0)
+						free_ranges.erase(it);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void free(int offset, int size)
+		{
+			auto it =
+				std::lower_bound(free_ranges.begin(), free_ranges.end(), offset, [](const Range& range, int value) { return range.offset < value; });
+			it = free_ranges.insert(it, Range{offset, size});
+
+			auto it_next = it + 1;
+			if (it_next != free_ranges.end() && it->offset + it->size == it_next->offset)
+			{
+				it->size += it_next->size;
+				free_ranges.erase(it_next);
+			}
+
+			if (it != free_ranges.begin())
+			{
+				auto it_prev = it - 1;
+				if (it_prev->offset + it_prev->size == it->offset)
+				{
+					it_prev->size += it->size;
+					free_ranges.erase(it);
+				}
+			}
+		}
+
+		// Returns the end of the last allocated range, everything beyond it is free.
+		int high_water_mark() const
+		{
+			if (!free_ranges.empty() && free_ranges.back().offset + free_ranges.back().size == capacity)
+				return free_ranges.back().offset;
+			return capacity;
+		}
+
+	private:
+		struct Range {
+			int offset;
+			int size;
+		};
+		int capacity;
+		Vector<Range> free_ranges;
+	};
+
+	class Arena {
+	public:
+		GeometryArenaHandle insert(const Vector<Vertex>& vertices, const Vector<int>& indices)
+		{
+			if (support == Support::No)
+				return 0;
+
+			const int num_vertices = (int)vertices.size();
+			const int num_indices = (int)indices.size();
+			if (num_vertices > chunk_num_vertices || num_indices > chunk_num_indices)
+				return 0;
+
+			// Share the allocation of any identical geometry, such as the decorators and backgrounds of equally sized elements.
+			const uint64_t hash = hash_geometry(vertices, indices);
+			auto it_shared = handles_by_hash.find(hash);
+			if (it_shared != handles_by_hash.end() && is_equal(get(it_shared->second), vertices, indices))
+			{
+				get(it_shared->second).ref_count += 1;
+				num_references += 1;
+				return it_shared->second;
+			}
+
+			Allocation allocation = {};
+			allocation.num_vertices = num_vertices;
+			allocation.num_indices = num_indices;
+			allocation.hash = hash;
+			allocation.ref_count = 1;
+
+			for (const UniquePtr<Chunk>& chunk : chunks)
+			{
+				if (allocate_in_chunk(*chunk, allocation))
+					break;
+			}
+
+			if (!allocation.chunk)
+			{
+				chunks.push_back(MakeUnique<Chunk>());
+				const bool success = allocate_in_chunk(*chunks.back(), allocation);
+				RMLUI_ASSERT(success);
+				(void)success;
+			}
+
+			// The new allocation is only placed in free ranges of the chunk, thus the allocations already compiled can still be rendered from it.
+			Chunk& chunk = *allocation.chunk;
+			std::copy(vertices.begin(), vertices.end(), chunk.vertices.begin() + allocation.vertex_offset);
+			std::transform(indices.begin(), indices.end(), chunk.indices.begin() + allocation.index_offset,
+				[&](int index) { return index + allocation.vertex_offset; });
+			allocation.generation = chunk.generation;
+			chunk.dirty = true;
+
+			// The first time we get here, compile the chunk right away to find out whether the render interface supports chunks at all.
+			if (support == Support::Unknown)
+			{
+				support = (compile(chunk) ? Support::Yes : Support::No);
+				if (support == Support::No)
+				{
+					release_allocation(allocation);
+					return 0;
+				}
+			}
+
+			GeometryArenaHandle handle;
+			if (free_handles.empty())
+			{
+				allocations.push_back(allocation);
+				handle = GeometryArenaHandle(allocations.size());
+			}
+			else
+			{
+				handle = free_handles.back();
+				free_handles.pop_back();
+				allocations[handle - 1] = allocation;
+			}
+
+			num_allocations += 1;
+			num_references += 1;
+			used_bytes += size_in_bytes(allocation);
+
+			// On hash collisions, the existing geometry is kept as the one to be shared.
+			handles_by_hash.emplace(hash, handle);
+
+			return handle;
+		}
+
+		void copy(GeometryArenaHandle handle, Vector<Vertex>& vertices, Vector<int>& indices) const
+		{
+			const Allocation& allocation = get(handle);
+			const Chunk& chunk = *allocation.chunk;
+
+			auto it_vertices = chunk.vertices.begin() + allocation.vertex_offset;
+			vertices.assign(it_vertices, it_vertices + allocation.num_vertices);
+
+			auto it_indices = chunk.indices.begin() + allocation.index_offset;
+			indices.resize(allocation.num_indices);
+			std::transform(it_indices, it_indices + allocation.num_indices, indices.begin(),
+				[&](int index) { return index - allocation.vertex_offset; });
+		}
+
+		void erase(GeometryArenaHandle handle)
+		{
+			Allocation& allocation = get(handle);
+			num_references -= 1;
+			allocation.ref_count -= 1;
+			if (allocation.ref_count > 0)
+				return;
+
+			auto it_shared = handles_by_hash.find(allocation.hash);
+			if (it_shared != handles_by_hash.end() && it_shared->second == handle)
+				handles_by_hash.erase(it_shared);
+
+			num_allocations -= 1;
+			used_bytes -= size_in_bytes(allocation);
+
+			release_allocation(allocation);
+
+			allocation = {};
+			free_handles.push_back(handle);
+		}
+
+		bool render(GeometryArenaHandle handle, TextureHandle texture, Vector2f translation)
+		{
+			const Allocation& allocation = get(handle);
+			const Chunk& chunk = *allocation.chunk;
+
+			// Allocations made since the chunk was last compiled are not part of the compiled chunk yet.
+			if (!chunk.compiled_chunk || allocation.generation >= chunk.generation)
+				return false;
+
+			::Rml::GetRenderInterface()->RenderCompiledGeometryChunk(chunk.compiled_chunk, allocation.index_offset, allocation.num_indices, texture,
+				translation);
+			return true;
+		}
+
+		void compile_dirty()
+		{
+			if (support != Support::Yes)
+				return;
+
+			for (const UniquePtr<Chunk>& chunk : chunks)
+			{
+				if (chunk->dirty && chunk->num_allocations > 0 && !compile(*chunk))
+				{
+					// Stop placing new geometry in the arena if the render interface no longer accepts our chunks.
+					support = Support::No;
+					return;
+				}
+			}
+		}
+
+		ArenaStatistics statistics() const
+		{
+			ArenaStatistics result;
+			result.num_chunks = (int)chunks.size();
+			result.num_allocations = num_allocations;
+			result.num_references = num_references;
+			result.reserved_bytes = chunks.size() * (chunk_num_vertices * sizeof(Vertex) + chunk_num_indices * sizeof(int));
+			result.used_bytes = used_bytes;
+			return result;
+		}
+
+		// Releases the compiled chunks, they will be compiled again the next time they are rendered.
+		void release_compiled()
+		{
+			for (const UniquePtr<Chunk>& chunk : chunks)
+				release_compiled(*chunk);
+		}
+
+		void shutdown()
+		{
+			release_compiled();
+			support = Support::Unknown;
+		}
+
+	private:
+		static constexpr int chunk_num_vertices = 16 * 1024;
+		static constexpr int chunk_num_indices = 2 * chunk_num_vertices;
+
+		struct Chunk {
+			Chunk() : vertices(chunk_num_vertices), indices(chunk_num_indices), vertex_ranges(chunk_num_vertices), index_ranges(chunk_num_indices)
+			{}
+			Vector<Vertex> vertices;
+			Vector<int> indices;
+			RangeAllocator vertex_ranges;
+			RangeAllocator index_ranges;
+
+			CompiledGeometryHandle compiled_chunk = 0;
+			// Incremented every time the chunk is compiled, the compiled chunk contains all allocations made in earlier generations.
+			int generation = 0;
+			bool dirty = true;
+			int num_allocations = 0;
+		};
+
+		struct Allocation {
+			Chunk* chunk;
+			int vertex_offset;
+			int num_vertices;
+			int index_offset;
+			int num_indices;
+			// Hash of the geometry data as inserted, and the number of geometries sharing the allocation.
+			uint64_t hash;
+			int ref_count;
+			// The generation of the chunk when the allocation was made.
+			int generation;
+		};
+
+		enum class Support { Unknown, Yes, No };
+
+		static size_t size_in_bytes(const Allocation& allocation)
+		{
+			return size_t(allocation.num_vertices) * sizeof(Vertex) + size_t(allocation.num_indices) * sizeof(int);
+		}
+
+		static uint64_t hash_geometry(const Vector<Vertex>& vertices, const Vector<int>& indices)
+		{
+			// FNV-1a over the raw bytes, the vertex members are tightly packed.
+			static_assert(sizeof(Vertex) == sizeof(Vector2f) * 2 + sizeof(Colourb), "Vertex must not contain padding.");
+
+			uint64_t hash = 14695981039346656037ull;
+			auto hash_bytes = [&hash](const void* data, size_t size) {
+				const byte* bytes = static_cast<const byte*>(data);
+				for (size_t i = 0; i < size; i++)
+				{
+					hash ^= bytes[i];
+					hash *= 1099511628211ull;
+				}
+			};
+
+			hash_bytes(vertices.data(), vertices.size() * sizeof(Vertex));
+			hash_bytes(indices.data(), indices.size() * sizeof(int));
+			return hash;
+		}
+
+		bool is_equal(const Allocation& allocation, const Vector<Vertex>& vertices, const Vector<int>& indices) const
+		{
+			if (allocation.num_vertices != (int)vertices.size() || allocation.num_indices != (int)indices.size())
+				return false;
+
+			const Chunk& chunk = *allocation.chunk;
+			if (memcmp(chunk.vertices.data() + allocation.vertex_offset, vertices.data(), vertices.size() * sizeof(Vertex)) != 0)
+				return false;
+
+			const int* chunk_indices = chunk.indices.data() + allocation.index_offset;
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				if (chunk_indices[i] - allocation.vertex_offset != indices[i])
+					return false;
+			}
+
+			return true;
+		}
+
+		static bool allocate_in_chunk(Chunk& chunk, Allocation& allocation)
+		{
+			if (!chunk.vertex_ranges.allocate(allocation.num_vertices, allocation.vertex_offset))
+				return false;
+
+			if (!chunk.index_ranges.allocate(allocation.num_indices, allocation.index_offset))
+			{
+				chunk.vertex_ranges.free(allocation.vertex_offset, allocation.num_vertices);
+				return false;
+			}
+
+			chunk.num_allocations += 1;
+			allocation.chunk = &chunk;
+			return true;
+		}
+
+		// Returns the allocation's ranges to its chunk. Empty chunks are destroyed, except for the last one to avoid churn.
+		void release_allocation(const Allocation& allocation)
+		{
+			Chunk* chunk = allocation.chunk;
+			chunk->vertex_ranges.free(allocation.vertex_offset, allocation.num_vertices);
+			chunk->index_ranges.free(allocation.index_offset, allocation.num_indices);
+			chunk->num_allocations -= 1;
+
+			if (chunk->num_allocations == 0 && (chunks.size() > 1 || support == Support::No))
+			{
+				release_compiled(*chunk);
+				auto it = std::find_if(chunks.begin(), chunks.end(), [chunk](const UniquePtr<Chunk>& other) { return other.get() == chunk; });
+				RMLUI_ASSERT(it != chunks.end());
+				chunks.erase(it);
+			}
+		}
+
+		bool compile(Chunk& chunk)
+		{
+			RenderInterface* render_interface = ::Rml::GetRenderInterface();
+			if (!render_interface)
+				return false;
+
+			release_compiled(chunk);
+
+			// Only the used part of the chunk needs to be compiled.
+			const int num_vertices = chunk.vertex_ranges.high_water_mark();
+			const int num_indices = chunk.index_ranges.high_water_mark();
+			chunk.compiled_chunk = render_interface->CompileGeometryChunk(chunk.vertices.data(), num_vertices, chunk.indices.data(), num_indices);
+			chunk.dirty = !chunk.compiled_chunk;
+			chunk.generation += 1;
+
+			return chunk.compiled_chunk != 0;
+		}
+
+		static void release_compiled(Chunk& chunk)
+		{
+			if (chunk.compiled_chunk)
+			{
+				if (RenderInterface* render_interface = ::Rml::GetRenderInterface())
+					render_interface->ReleaseCompiledGeometry(chunk.compiled_chunk);
+				chunk.compiled_chunk = 0;
+			}
+			chunk.dirty = true;
+		}
+
+		Allocation& get(GeometryArenaHandle handle)
+		{
+			RMLUI_ASSERT(handle > 0 && handle <= allocations.size() && allocations[handle - 1].chunk);
+			return allocations[handle - 1];
+		}
+		const Allocation& get(GeometryArenaHandle handle) const
+		{
+			RMLUI_ASSERT(handle > 0 && handle <= allocations.size() && allocations[handle - 1].chunk);
+			return allocations[handle - 1];
+		}
+
+		Support support = Support::Unknown;
+
+		Vector<UniquePtr<Chunk>> chunks;
+
+		// Allocations are identified by their index plus one, so that zero can be used to denote no allocation.
+		Vector<Allocation> allocations;
+		Vector<GeometryArenaHandle> free_handles;
+
+		// The allocations available for sharing with new geometry, by the hash of their data.
+		UnorderedMap<uint64_t, GeometryArenaHandle> handles_by_hash;
+
+		int num_allocations = 0;
+		int num_references = 0;
+		size_t used_bytes = 0;
+	};
+
+	static Arena geometry_arena;
+
+	// Stages the data of geometry to be compiled, so that all geometry staged during a frame is submitted to the render interface at once.
+	class Batch {
+	public:
+		GeometryBatchHandle insert(const Vector<Vertex>& vertices, const Vector<int>& indices, TextureHandle texture)
+		{
+			Entry entry;
+			entry.range = GeometryBatchEntry{(int)staged_vertices.size(), (int)vertices.size(), (int)staged_indices.size(), (int)indices.size(),
+				texture};
+			entry.state = State::Staged;
+
+			staged_vertices.insert(staged_vertices.end(), vertices.begin(), vertices.end());
+			staged_indices.insert(staged_indices.end(), indices.begin(), indices.end());
+			num_staged += 1;
+
+			GeometryBatchHandle handle;
+			if (free_handles.empty())
+			{
+				entries.push_back(entry);
+				handle = GeometryBatchHandle(entries.size());
+			}
+			else
+			{
+				handle = free_handles.back();
+				free_handles.pop_back();
+				entries[handle - 1] = entry;
+			}
+			return handle;
+		}
+
+		bool take(GeometryBatchHandle handle, CompiledGeometryHandle& out_compiled_geometry)
+		{
+			Entry& entry = get(handle);
+			if (entry.state == State::Staged)
+				return false;
+
+			out_compiled_geometry = entry.compiled_geometry;
+			free(handle);
+			return true;
+		}
+
+		void erase(GeometryBatchHandle handle)
+		{
+			Entry& entry = get(handle);
+			if (entry.state == State::Staged)
+			{
+				num_staged -= 1;
+			}
+			else if (entry.compiled_geometry)
+			{
+				if (RenderInterface* render_interface = ::Rml::GetRenderInterface())
+					render_interface->ReleaseCompiledGeometry(entry.compiled_geometry);
+			}
+			free(handle);
+		}
+
+		void compile()
+		{
+			if (num_staged == 0)
+			{
+				// All staged geometry was erased before it could be compiled, its data is no longer needed.
+				staged_vertices.clear();
+				staged_indices.clear();
+				return;
+			}
+
+			RenderInterface* render_interface = ::Rml::GetRenderInterface();
+			if (!render_interface)
+				return;
+
+			ranges.clear();
+			handles.clear();
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				if (entries[i].state == State::Staged)
+				{
+					ranges.push_back(entries[i].range);
+					handles.push_back(GeometryBatchHandle(i + 1));
+				}
+			}
+			RMLUI_ASSERT((int)ranges.size() == num_staged);
+
+			compiled_geometries.assign(ranges.size(), 0);
+			render_interface->CompileGeometryBatch(staged_vertices.data(), (int)staged_vertices.size(), staged_indices.data(),
+				(int)staged_indices.size(), ranges.data(), (int)ranges.size(), compiled_geometries.data());
+
+			for (size_t i = 0; i < handles.size(); i++)
+			{
+				Entry& entry = get(handles[i]);
+				entry.compiled_geometry = compiled_geometries[i];
+				entry.state = State::Compiled;
+			}
+
+			num_staged = 0;
+			staged_vertices.clear();
+			staged_indices.clear();
+		}
+
+		// Releases compiled geometry which has not been taken yet, its geometry will then render in immediate mode instead.
+		void release_compiled()
+		{
+			RenderInterface* render_interface = ::Rml::GetRenderInterface();
+			for (Entry& entry : entries)
+			{
+				if (entry.state == State::Compiled && entry.compiled_geometry)
+				{
+					if (render_interface)
+						render_interface->ReleaseCompiledGeometry(entry.compiled_geometry);
+					entry.compiled_geometry = 0;
+				}
+			}
+		}
+
+	private:
+		enum class State { Free, Staged, Compiled };
+
+		struct Entry {
+			GeometryBatchEntry range = {};
+			CompiledGeometryHandle compiled_geometry = 0;
+			State state = State::Free;
+		};
+
+		Entry& get(GeometryBatchHandle handle)
+		{
+			RMLUI_ASSERT(handle > 0 && handle <= entries.size() && entries[handle - 1].state != State::Free);
+			return entries[handle - 1];
+		}
+
+		void free(GeometryBatchHandle handle)
+		{
+			entries[handle - 1] = Entry{};
+			free_handles.push_back(handle);
+		}
+
+		// Entries are identified by their index plus one, so that zero can be used to denote no entry.
+		Vector<Entry> entries;
+		Vector<GeometryBatchHandle> free_handles;
+		int num_staged = 0;
+
+		// The data of all staged geometry, kept between batches to reuse their allocations.
+		Vector<Vertex> staged_vertices;
+		Vector<int> staged_indices;
+
+		Vector<GeometryBatchEntry> ranges;
+		Vector<GeometryBatchHandle> handles;
+		Vector<CompiledGeometryHandle> compiled_geometries;
+	};
+
+	static Batch geometry_batch;
+
+	// The colour modulation of the geometry currently being rendered, and whether the render interface applies it for us.
+	static Colourb colour_modulation(255, 255, 255, 255);
+	static bool render_interface_modulates = false;
+
 	GeometryDatabaseHandle Insert(Geometry* geometry)
 	{
 		return geometry_database.insert(geometry);
@@ -121,9 +682,94 @@ namespace GeometryDatabase {
 		geometry_database.erase(handle);
 	}
 
+	GeometryArenaHandle InsertIntoArena(const Vector<Vertex>& vertices, const Vector<int>& indices)
+	{
+		return geometry_arena.insert(vertices, indices);
+	}
+
+	void CopyFromArena(GeometryArenaHandle handle, Vector<Vertex>& vertices, Vector<int>& indices)
+	{
+		geometry_arena.copy(handle, vertices, indices);
+	}
+
+	void EraseFromArena(GeometryArenaHandle handle)
+	{
+		geometry_arena.erase(handle);
+	}
+
+	bool RenderFromArena(GeometryArenaHandle handle, TextureHandle texture, Vector2f translation)
+	{
+		return geometry_arena.render(handle, texture, translation);
+	}
+
+	void CompileArena()
+	{
+		geometry_arena.compile_dirty();
+	}
+
+	GeometryBatchHandle InsertIntoBatch(const Vector<Vertex>& vertices, const Vector<int>& indices, TextureHandle texture)
+	{
+		return geometry_batch.insert(vertices, indices, texture);
+	}
+
+	bool TakeFromBatch(GeometryBatchHandle handle, CompiledGeometryHandle& out_compiled_geometry)
+	{
+		return geometry_batch.take(handle, out_compiled_geometry);
+	}
+
+	void EraseFromBatch(GeometryBatchHandle handle)
+	{
+		geometry_batch.erase(handle);
+	}
+
+	void CompileBatch()
+	{
+		geometry_batch.compile();
+	}
+
+	ArenaStatistics GetArenaStatistics()
+	{
+		return geometry_arena.statistics();
+	}
+
+	void SetColourModulation(Colourb colour)
+	{
+		RenderInterface* render_interface = ::Rml::GetRenderInterface();
+		const bool supported = (render_interface && render_interface->SupportsColourModulation());
+		if (colour == colour_modulation && supported == render_interface_modulates)
+			return;
+
+		colour_modulation = colour;
+		render_interface_modulates = supported;
+
+		if (supported)
+			render_interface->SetColourModulation(colour);
+	}
+
+	Colourb GetVertexColourModulation()
+	{
+		return render_interface_modulates ? Colourb(255, 255, 255, 255) : colour_modulation;
+	}
+
+	bool IsColourModulationSupported()
+	{
+		RenderInterface* render_interface = ::Rml::GetRenderInterface();
+		return render_interface && render_interface->SupportsColourModulation();
+	}
+
 	void ReleaseAll()
 	{
 		geometry_database.for_each([](Geometry* geometry) { geometry->Release(); });
+		geometry_arena.release_compiled();
+	}
+
+	void Shutdown()
+	{
+		geometry_arena.shutdown();
+		geometry_batch.release_compiled();
+
+		colour_modulation = Colourb(255, 255, 255, 255);
+		render_interface_modulates = false;
 	}
 
 #ifdef RMLUI_TESTS_ENABLED
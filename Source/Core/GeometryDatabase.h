@@ -35,7 +35,10 @@
 namespace Rml {
 
 class Geometry;
+struct Vertex;
 using GeometryDatabaseHandle = uint32_t;
+using GeometryArenaHandle = uint32_t;
+using GeometryBatchHandle = uint32_t;
 
 /**
     The geometry database stores a reference to all active geometry.
@@ -44,6 +47,19 @@ using GeometryDatabaseHandle = uint32_t;
 
     It is expected that every Insert() call is followed (at some later time) by
     exactly one Erase() call with the same handle value.
+
+    Additionally, the database owns the geometry arena. When supported by the render interface, the vertex and index
+    data of geometry is copied into a few large chunks, each compiled as a single unit, and the geometry is rendered as
+    ranges within its chunk. Modified chunks are only compiled by CompileArena(), at most once per frame. Until then, allocations
+    compiled earlier are still rendered from the previously compiled chunk, only new allocations need to wait for it. Every
+    successful InsertIntoArena() call must be followed by exactly one EraseFromArena().
+
+    Geometry which is not placed in the arena is compiled separately. Rather than compiling it during rendering, its data is staged with
+    InsertIntoBatch(), and all geometry staged during a frame is compiled in a single batch by CompileBatch(). Every InsertIntoBatch() call
+    must be followed by either a successful TakeFromBatch() or an EraseFromBatch().
+
+    Finally, the database tracks the colour modulation applied to rendered geometry, which elements use to apply their
+    opacity. It is forwarded to the render interface, and if not supported there, geometry applies it to its vertices.
 */
 
 namespace GeometryDatabase {
@@ -51,8 +67,51 @@ namespace GeometryDatabase {
 	GeometryDatabaseHandle Insert(Geometry* geometry);
 	void Erase(GeometryDatabaseHandle handle);
 
+	// Copies the given data into the arena, or shares the allocation of identical data already in the arena. Returns zero if the arena is not
+	// supported by the render interface, or the data is too large.
+	GeometryArenaHandle InsertIntoArena(const Vector<Vertex>& vertices, const Vector<int>& indices);
+	// Copies the data of an arena allocation back out of the arena.
+	void CopyFromArena(GeometryArenaHandle handle, Vector<Vertex>& vertices, Vector<int>& indices);
+	void EraseFromArena(GeometryArenaHandle handle);
+	// Renders the arena allocation. Returns false if the allocation was made after its chunk was last compiled, or the chunk is not compiled.
+	bool RenderFromArena(GeometryArenaHandle handle, TextureHandle texture, Vector2f translation);
+	// Compiles all chunks modified since the last call, called before rendering each context.
+	void CompileArena();
+
+	// Copies the given data into the staging buffer of the next compile batch.
+	GeometryBatchHandle InsertIntoBatch(const Vector<Vertex>& vertices, const Vector<int>& indices, TextureHandle texture);
+	// Takes ownership of the compiled geometry, which is zero if it could not be compiled, and releases the handle. Returns false if the
+	// batch has not been compiled yet, in which case the handle remains valid.
+	bool TakeFromBatch(GeometryBatchHandle handle, CompiledGeometryHandle& out_compiled_geometry);
+	// Removes the geometry from its batch, releasing its compiled geometry if it has not been taken.
+	void EraseFromBatch(GeometryBatchHandle handle);
+	// Compiles all geometry staged since the last call in a single batch, called before rendering each context.
+	void CompileBatch();
+
+	struct ArenaStatistics {
+		int num_chunks = 0;
+		int num_allocations = 0;
+		// The number of geometries referring to the allocations, identical geometry shares a single allocation.
+		int num_references = 0;
+		// Memory reserved by the chunks, and the part of it used by live allocations.
+		size_t reserved_bytes = 0;
+		size_t used_bytes = 0;
+	};
+	ArenaStatistics GetArenaStatistics();
+
+	// Sets the colour all subsequently rendered geometry is multiplied by, opaque white to disable.
+	void SetColourModulation(Colourb colour);
+	// Returns the colour modulation that geometry needs to apply to its vertex colours. This is opaque white when the render interface
+	// applies the modulation itself.
+	Colourb GetVertexColourModulation();
+	// Returns true if the render interface applies colour modulation itself, instead of the geometry modifying its vertex colours.
+	bool IsColourModulationSupported();
+
 	void ReleaseAll();
 
+	// Releases all compiled chunks and resets the arena support detection, called when the render interface goes away.
+	void Shutdown();
+
 #ifdef RMLUI_TESTS_ENABLED
 	bool PrepareForTests();
 	bool ListMatchesDatabase(const Vector<Geometry>& geometry_list);
@@ -88,7 +88,8 @@ namespace Detail {
 
 	BasicStackAllocator& GetGlobalBasicStackAllocator()
 	{
-		static BasicStackAllocator stack_allocator(10 * 1024);
+		// One per thread, so that font effects may be generated in parallel.
+		static thread_local BasicStackAllocator stack_allocator(10 * 1024);
 		return stack_allocator;
 	}
 
@@ -52,18 +52,60 @@ void RenderInterface::RenderCompiledGeometry(CompiledGeometryHandle /*geometry*/
 
 void RenderInterface::ReleaseCompiledGeometry(CompiledGeometryHandle /*geometry*/) {}
 
+void RenderInterface::CompileGeometryBatch(Vertex* vertices, int /*num_vertices*/, int* indices, int /*num_indices*/,
+	const GeometryBatchEntry* geometries, int num_geometries, CompiledGeometryHandle* compiled_geometries)
+{
+	for (int i = 0; i < num_geometries; i++)
+	{
+		const GeometryBatchEntry& entry = geometries[i];
+		compiled_geometries[i] = CompileGeometry(vertices + entry.vertex_offset, entry.num_vertices, indices + entry.index_offset, entry.num_indices,
+			entry.texture);
+	}
+}
+
+CompiledGeometryHandle RenderInterface::CompileGeometryChunk(Vertex* /*vertices*/, int /*num_vertices*/, int* /*indices*/, int /*num_indices*/)
+{
+	return 0;
+}
+
+void RenderInterface::RenderCompiledGeometryChunk(CompiledGeometryHandle /*chunk*/, int /*first_index*/, int /*num_indices*/,
+	TextureHandle /*texture*/, const Vector2f& /*translation*/)
+{}
+
 bool RenderInterface::LoadTexture(TextureHandle& /*texture_handle*/, Vector2i& /*texture_dimensions*/, const String& /*source*/)
 {
 	return false;
 }
 
+bool RenderInterface::LoadTextureData(Vector<byte>& /*texture_data*/, Vector2i& /*texture_dimensions*/, const String& /*source*/)
+{
+	return false;
+}
+
 bool RenderInterface::GenerateTexture(TextureHandle& /*texture_handle*/, const byte* /*source*/, const Vector2i& /*source_dimensions*/)
 {
 	return false;
 }
 
+bool RenderInterface::SupportsDistanceFieldTextures()
+{
+	return false;
+}
+
+bool RenderInterface::GenerateDistanceFieldTexture(TextureHandle& /*texture_handle*/, const byte* /*source*/, const Vector2i& /*source_dimensions*/)
+{
+	return false;
+}
+
 void RenderInterface::ReleaseTexture(TextureHandle /*texture*/) {}
 
 void RenderInterface::SetTransform(const Matrix4f* /*transform*/) {}
 
+bool RenderInterface::SupportsColourModulation()
+{
+	return false;
+}
+
+void RenderInterface::SetColourModulation(const Colourb& /*colour*/) {}
+
 } // namespace Rml
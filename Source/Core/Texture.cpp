@@ -68,6 +68,14 @@ Vector2i Texture::GetDimensions() const
 	return resource->GetDimensions();
 }
 
+Rectanglef Texture::GetAtlasRegion() const
+{
+	if (!resource)
+		return Rectanglef::FromSize(Vector2f(1.f));
+
+	return resource->GetAtlasRegion();
+}
+
 bool Texture::operator==(const Texture& other) const
 {
 	return resource == other.resource;
@@ -0,0 +1,305 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TextureAtlas.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/RenderInterface.h"
+#include "TextureLayout.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Rml {
+
+// Leave some room on each page when placing images, so that it rarely overflows when laid out.
+static constexpr float page_fill_factor = 0.75f;
+
+TextureAtlas::TextureAtlas() {}
+
+TextureAtlas::~TextureAtlas()
+{
+	for (Page& page : pages)
+		ReleasePageTexture(page);
+}
+
+int TextureAtlas::Add(Vector<byte> data, Vector2i dimensions, const String& source)
+{
+	RMLUI_ASSERT(dimensions.x > 0 && dimensions.y > 0 && dimensions.x + 2 < max_page_size && dimensions.y + 2 < max_page_size);
+	RMLUI_ASSERT((int)data.size() == dimensions.x * dimensions.y * 4);
+
+	int image_index;
+	if (free_image_indices.empty())
+	{
+		image_index = (int)images.size();
+		images.emplace_back();
+	}
+	else
+	{
+		image_index = free_image_indices.back();
+		free_image_indices.pop_back();
+	}
+
+	// Place the image on the first page with enough room left, or otherwise on a new page.
+	const int area = GetPaddedArea(dimensions);
+	const int max_area = int(page_fill_factor * float(max_page_size * max_page_size));
+
+	int page_index = 0;
+	while (page_index < (int)pages.size() && pages[page_index].used_area + area > max_area)
+		page_index += 1;
+
+	if (page_index == (int)pages.size())
+		pages.emplace_back();
+
+	Image& image = images[image_index];
+	image.data = std::move(data);
+	image.source = source;
+	image.dimensions = dimensions;
+	image.page_index = page_index;
+
+	Page& page = pages[page_index];
+	page.image_indices.push_back(image_index);
+	page.used_area += area;
+	page.layout_dirty = true;
+
+	return image_index;
+}
+
+void TextureAtlas::Remove(int image_index)
+{
+	Image& image = images[image_index];
+	Page& page = pages[image.page_index];
+
+	page.image_indices.erase(std::find(page.image_indices.begin(), page.image_indices.end(), image_index));
+	page.used_area -= GetPaddedArea(image.dimensions);
+
+	if (page.image_indices.empty())
+	{
+		ReleasePageTexture(page);
+		page = Page();
+	}
+	else if (page.used_area * 2 < page.laid_out_area)
+	{
+		// Most of the page has become unused, lay it out again to shrink its texture and make room for new images.
+		page.layout_dirty = true;
+	}
+
+	image = Image();
+	free_image_indices.push_back(image_index);
+}
+
+TextureHandle TextureAtlas::GetHandle(int image_index)
+{
+	UpdateImagePage(image_index);
+	return pages[images[image_index].page_index].handle;
+}
+
+Rectanglef TextureAtlas::GetRegion(int image_index)
+{
+	UpdateImagePage(image_index);
+
+	const Image& image = images[image_index];
+	const Vector2f page_dimensions = Vector2f(pages[image.page_index].dimensions);
+	return Rectanglef::FromPositionSize(Vector2f(image.position) / page_dimensions, Vector2f(image.dimensions) / page_dimensions);
+}
+
+void TextureAtlas::ReleaseTextures()
+{
+	for (Page& page : pages)
+	{
+		ReleasePageTexture(page);
+		page.texture_dirty = !page.image_indices.empty();
+	}
+}
+
+int TextureAtlas::GetNumPages() const
+{
+	return (int)std::count_if(pages.begin(), pages.end(), [](const Page& page) { return !page.image_indices.empty(); });
+}
+
+int TextureAtlas::GetNumImages() const
+{
+	return (int)images.size() - (int)free_image_indices.size();
+}
+
+size_t TextureAtlas::GetImageDataSize() const
+{
+	size_t size = 0;
+	for (const Image& image : images)
+		size += image.data.size();
+	return size;
+}
+
+void TextureAtlas::UpdateImagePage(int image_index)
+{
+	// Laying out a page may move some of its images to a new page, so keep going until the image has settled on its page.
+	while (pages[images[image_index].page_index].layout_dirty)
+		LayoutPage(images[image_index].page_index);
+
+	Page& page = pages[images[image_index].page_index];
+	if (page.texture_dirty)
+		GeneratePageTexture(page);
+}
+
+void TextureAtlas::LayoutPage(int page_index)
+{
+	RMLUI_ZoneScoped;
+
+	TextureLayout layout;
+	for (int image_index : pages[page_index].image_indices)
+		layout.AddRectangle(image_index, images[image_index].dimensions + Vector2i(2));
+
+	layout.GenerateLayout(max_page_size);
+	RMLUI_ASSERT(layout.GetNumTextures() > 0);
+
+	Page& page = pages[page_index];
+	page.image_indices.clear();
+	page.used_area = 0;
+
+	Vector<int> overflow_image_indices;
+
+	for (int i = 0; i < layout.GetNumRectangles(); i++)
+	{
+		TextureLayoutRectangle& rectangle = layout.GetRectangle(i);
+		const int image_index = rectangle.GetId();
+		Image& image = images[image_index];
+
+		if (rectangle.GetTextureIndex() == 0)
+		{
+			// Each image is surrounded by a one pixel border, see GeneratePageTexture().
+			image.position = rectangle.GetPosition() + Vector2i(1);
+			page.image_indices.push_back(image_index);
+			page.used_area += GetPaddedArea(image.dimensions);
+		}
+		else
+		{
+			overflow_image_indices.push_back(image_index);
+		}
+	}
+
+	page.dimensions = layout.GetTexture(0).GetDimensions();
+	page.laid_out_area = page.used_area;
+	page.layout_dirty = false;
+	page.texture_dirty = true;
+
+	// Images which did not fit on the page are moved to a new one.
+	if (!overflow_image_indices.empty())
+	{
+		const int new_page_index = (int)pages.size();
+		pages.emplace_back();
+		Page& new_page = pages.back();
+
+		for (int image_index : overflow_image_indices)
+		{
+			images[image_index].page_index = new_page_index;
+			new_page.image_indices.push_back(image_index);
+			new_page.used_area += GetPaddedArea(images[image_index].dimensions);
+		}
+
+		new_page.layout_dirty = true;
+	}
+}
+
+void TextureAtlas::GeneratePageTexture(Page& page)
+{
+	RMLUI_ZoneScoped;
+
+	ReleasePageTexture(page);
+	page.texture_dirty = false;
+
+	RenderInterface* render_interface = ::Rml::GetRenderInterface();
+	if (!render_interface)
+		return;
+
+	const Vector2i page_dimensions = page.dimensions;
+	Vector<byte> data(size_t(page_dimensions.x * page_dimensions.y * 4), byte(0));
+
+	for (int image_index : page.image_indices)
+	{
+		Image& image = images[image_index];
+		const int width = image.dimensions.x;
+		const int height = image.dimensions.y;
+
+		if (image.data.empty())
+		{
+			Vector2i loaded_dimensions;
+			if (!render_interface->LoadTextureData(image.data, loaded_dimensions, image.source) || loaded_dimensions != image.dimensions ||
+				(int)image.data.size() != width * height * 4)
+			{
+				// Leave the region of the image transparent.
+				Log::Message(Log::LT_WARNING, "Failed to load texture atlas image from %s.", image.source.c_str());
+				Vector<byte>().swap(image.data);
+				continue;
+			}
+		}
+
+		// Copy the image with a one pixel border repeating its edges, so that linear filtering near the edges does not sample
+		// from neighboring images.
+		for (int y = -1; y <= height; y++)
+		{
+			const byte* source_row = image.data.data() + Math::Clamp(y, 0, height - 1) * width * 4;
+			byte* destination_row = data.data() + ((image.position.y + y) * page_dimensions.x + image.position.x - 1) * 4;
+
+			memcpy(destination_row, source_row, 4);
+			memcpy(destination_row + 4, source_row, size_t(width * 4));
+			memcpy(destination_row + (width + 1) * 4, source_row + (width - 1) * 4, 4);
+		}
+	}
+
+	if (!render_interface->GenerateTexture(page.handle, data.data(), page_dimensions))
+	{
+		Log::Message(Log::LT_WARNING, "Failed to generate texture atlas page of size %d x %d.", page_dimensions.x, page_dimensions.y);
+		page.handle = {};
+	}
+
+	// Release the data of images which can be loaded again, as the page is rarely generated again after its first use.
+	for (int image_index : page.image_indices)
+	{
+		Image& image = images[image_index];
+		if (!image.source.empty())
+			Vector<byte>().swap(image.data);
+	}
+}
+
+void TextureAtlas::ReleasePageTexture(Page& page)
+{
+	if (page.handle)
+	{
+		if (RenderInterface* render_interface = ::Rml::GetRenderInterface())
+			render_interface->ReleaseTexture(page.handle);
+		page.handle = {};
+	}
+}
+
+int TextureAtlas::GetPaddedArea(Vector2i dimensions)
+{
+	// Includes the border around each image and the spacing between images used by the texture layout.
+	return (dimensions.x + 3) * (dimensions.y + 3);
+}
+
+} // namespace Rml
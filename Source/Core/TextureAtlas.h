@@ -0,0 +1,116 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_TEXTUREATLAS_H
+#define RMLUI_CORE_TEXTUREATLAS_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    The texture atlas places small images together on shared texture pages, so that elements showing different images can be
+    rendered using the same texture.
+
+    Images are positioned on their page using the texture layout. Only pages which have had images added, or a large part of
+    their images removed, are laid out again. The pages are generated lazily when the handle or region of one of its images
+    is requested. Thus, any texture coordinates depending on the region should be updated whenever it changes.
+
+    The data of images with a source is released once their page has been generated, and loaded again through the render
+    interface should the page need to be generated anew.
+ */
+
+class TextureAtlas : public NonCopyMoveable {
+public:
+	TextureAtlas();
+	~TextureAtlas();
+
+	/// Adds an image to the atlas.
+	/// @param[in] data The image data, in the format used by RenderInterface::GenerateTexture().
+	/// @param[in] dimensions The dimensions of the image.
+	/// @param[in] source The source to load the image data from again, see RenderInterface::LoadTextureData(). If empty, the data is kept.
+	/// @return The index identifying the image in the atlas.
+	int Add(Vector<byte> data, Vector2i dimensions, const String& source = String());
+	/// Removes an image from the atlas.
+	void Remove(int image_index);
+
+	/// Returns the texture handle of the page the image is placed on, generating the page as necessary.
+	TextureHandle GetHandle(int image_index);
+	/// Returns the region the image occupies on its page, in normalized texture coordinates.
+	Rectanglef GetRegion(int image_index);
+
+	/// Releases the textures of all pages, they will be generated again when next used.
+	void ReleaseTextures();
+
+	/// Returns the number of pages with any images placed on them.
+	int GetNumPages() const;
+	/// Returns the number of images in the atlas.
+	int GetNumImages() const;
+	/// Returns the size in bytes of the image data currently held in memory.
+	size_t GetImageDataSize() const;
+
+	/// The maximum width and height of any page.
+	static constexpr int max_page_size = 1024;
+
+private:
+	struct Image {
+		// Empty when the data has been released after generating the page, until it is loaded again from the source.
+		Vector<byte> data;
+		String source;
+		Vector2i dimensions;
+		Vector2i position;
+		int page_index = -1;
+	};
+
+	struct Page {
+		Vector<int> image_indices;
+		Vector2i dimensions;
+		TextureHandle handle = {};
+		// The number of pixels occupied by the images currently on the page, including padding, and the number of pixels
+		// occupied when the page was last laid out.
+		int used_area = 0;
+		int laid_out_area = 0;
+		bool layout_dirty = false;
+		bool texture_dirty = false;
+	};
+
+	void UpdateImagePage(int image_index);
+	void LayoutPage(int page_index);
+	void GeneratePageTexture(Page& page);
+	void ReleasePageTexture(Page& page);
+
+	static int GetPaddedArea(Vector2i dimensions);
+
+	Vector<Image> images;
+	Vector<int> free_image_indices;
+	Vector<Page> pages;
+};
+
+} // namespace Rml
+#endif
@@ -35,6 +35,7 @@
 namespace Rml {
 
 static TextureDatabase* texture_database = nullptr;
+static int atlas_max_image_size = 128;
 
 TextureDatabase::TextureDatabase()
 {
@@ -131,6 +132,8 @@ void TextureDatabase::ReleaseTextures()
 
 		for (const auto& texture : texture_database->callback_textures)
 			texture->Release();
+
+		texture_database->atlas.ReleaseTextures();
 	}
 }
 
@@ -150,4 +153,25 @@ bool TextureDatabase::AllTexturesReleased()
 	return true;
 }
 
+TextureAtlas* TextureDatabase::GetAtlas()
+{
+	return texture_database ? &texture_database->atlas : nullptr;
+}
+
+void TextureDatabase::SetAtlasMaxImageSize(int size)
+{
+	// Keep the images small compared to the atlas pages, so that many of them can share each page.
+	atlas_max_image_size = Math::Clamp(size, 0, TextureAtlas::max_page_size / 4);
+}
+
+bool TextureDatabase::FitsInAtlas(Vector2i dimensions)
+{
+	return dimensions.x > 0 && dimensions.y > 0 && dimensions.x <= atlas_max_image_size && dimensions.y <= atlas_max_image_size;
+}
+
+bool TextureDatabase::IsAtlasEnabled()
+{
+	return texture_database && atlas_max_image_size > 0;
+}
+
 } // namespace Rml
@@ -30,6 +30,7 @@
 #define RMLUI_CORE_TEXTUREDATABASE_H
 
 #include "../../Include/RmlUi/Core/Types.h"
+#include "TextureAtlas.h"
 
 namespace Rml {
 
@@ -64,10 +65,22 @@ public:
 	/// Returns true if there are no textures in the database yet to be released through the render interface.
 	static bool AllTexturesReleased();
 
+	/// Returns the atlas where small images are placed together, or nullptr if the database is not initialized.
+	static TextureAtlas* GetAtlas();
+	/// Sets the maximum width and height of images placed in the atlas. Zero disables the atlas for new images.
+	static void SetAtlasMaxImageSize(int size);
+	/// Returns true if images of the given dimensions should be placed in the atlas.
+	static bool FitsInAtlas(Vector2i dimensions);
+	/// Returns true if the atlas is enabled.
+	static bool IsAtlasEnabled();
+
 private:
 	TextureDatabase();
 	~TextureDatabase();
 
+	// Declared before the textures so that it outlives them during destruction.
+	TextureAtlas atlas;
+
 	using TextureMap = UnorderedMap<String, SharedPtr<TextureResource>>;
 	TextureMap textures;
 
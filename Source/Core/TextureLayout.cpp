@@ -75,7 +75,7 @@ int TextureLayout::GetNumTextures() const
 	return (int)textures.size();
 }
 
-bool TextureLayout::GenerateLayout(int max_texture_dimensions)
+bool TextureLayout::GenerateLayout(int max_texture_dimensions, TextureLayoutPacking packing)
 {
 	// Sort the rectangles by height.
 	std::sort(rectangles.begin(), rectangles.end(), RectangleSort());
@@ -84,7 +84,7 @@ bool TextureLayout::GenerateLayout(int max_texture_dimensions)
 	while (num_placed_rectangles != GetNumRectangles())
 	{
 		TextureLayoutTexture texture;
-		int texture_size = texture.Generate(*this, max_texture_dimensions);
+		int texture_size = texture.Generate(*this, max_texture_dimensions, packing);
 		if (texture_size == 0)
 			return false;
 
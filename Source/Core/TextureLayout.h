@@ -70,8 +70,9 @@ public:
 
 	/// Attempts to generate an efficient texture layout for the rectangles.
 	/// @param[in] max_texture_dimensions The maximum dimensions allowed for any single texture.
+	/// @param[in] packing The strategy used to position the rectangles within each texture.
 	/// @return True if the layout was generated successfully, false if not.
-	bool GenerateLayout(int max_texture_dimensions);
+	bool GenerateLayout(int max_texture_dimensions, TextureLayoutPacking packing = TextureLayoutPacking::Rows);
 
 private:
 	using RectangleList = Vector<TextureLayoutRectangle>;
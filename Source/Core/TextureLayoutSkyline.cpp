@@ -0,0 +1,187 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TextureLayoutSkyline.h"
+#include "../../Include/RmlUi/Core/Math.h"
+
+namespace Rml {
+
+TextureLayoutSkyline::TextureLayoutSkyline() : dimensions(0, 0) {}
+
+TextureLayoutSkyline::TextureLayoutSkyline(Vector2i dimensions) : dimensions(dimensions)
+{
+	if (dimensions.x > 1 && dimensions.y > 1)
+		skyline.push_back(Segment{1, 1, dimensions.x - 1});
+}
+
+bool TextureLayoutSkyline::Allocate(Vector2i rectangle_dimensions, Vector2i& out_position)
+{
+	// Empty rectangles don't occupy any space.
+	if (rectangle_dimensions.x <= 0 || rectangle_dimensions.y <= 0)
+	{
+		out_position = Vector2i(1, 1);
+		return true;
+	}
+
+	const Vector2i padded_dimensions = rectangle_dimensions + Vector2i(1);
+
+	// Find the position where the bottom of the rectangle is the highest, preferring the narrowest segments on ties to leave wide
+	// segments open for wide rectangles.
+	int best_index = -1;
+	int best_y = 0;
+	int best_bottom = 0;
+	int best_width = 0;
+
+	for (int i = 0; i < (int)skyline.size(); i++)
+	{
+		const int y = GetFitPosition(i, padded_dimensions.x);
+		if (y < 0)
+			break;
+
+		const int bottom = y + padded_dimensions.y;
+		if (bottom > dimensions.y)
+			continue;
+
+		if (best_index < 0 || bottom < best_bottom || (bottom == best_bottom && skyline[i].width < best_width))
+		{
+			best_index = i;
+			best_y = y;
+			best_bottom = bottom;
+			best_width = skyline[i].width;
+		}
+	}
+
+	if (best_index < 0)
+		return false;
+
+	out_position = Vector2i(skyline[best_index].x, best_y);
+	Raise(best_index, padded_dimensions.x, best_bottom);
+
+	return true;
+}
+
+void TextureLayoutSkyline::Reserve(Vector2i position, Vector2i rectangle_dimensions)
+{
+	if (rectangle_dimensions.x <= 0 || rectangle_dimensions.y <= 0)
+		return;
+
+	const int x_begin = position.x;
+	const int x_end = position.x + rectangle_dimensions.x + 1;
+	const int y = position.y + rectangle_dimensions.y + 1;
+
+	// Unlike allocated rectangles, the area may be partially below the skyline, so split the segments at the edges of the area and only
+	// raise those that are lower.
+	Vector<Segment> result;
+	result.reserve(skyline.size() + 2);
+
+	auto add_segment = [&result](int x, int segment_y, int width) {
+		if (width <= 0)
+			return;
+		if (!result.empty() && result.back().y == segment_y)
+			result.back().width += width;
+		else
+			result.push_back(Segment{x, segment_y, width});
+	};
+
+	for (const Segment& segment : skyline)
+	{
+		const int segment_end = segment.x + segment.width;
+		if (segment_end <= x_begin || segment.x >= x_end)
+		{
+			add_segment(segment.x, segment.y, segment.width);
+			continue;
+		}
+
+		const int inner_begin = Math::Max(segment.x, x_begin);
+		const int inner_end = Math::Min(segment_end, x_end);
+		add_segment(segment.x, segment.y, inner_begin - segment.x);
+		add_segment(inner_begin, Math::Max(segment.y, y), inner_end - inner_begin);
+		add_segment(inner_end, segment.y, segment_end - inner_end);
+	}
+
+	skyline.swap(result);
+}
+
+Vector2i TextureLayoutSkyline::GetDimensions() const
+{
+	return dimensions;
+}
+
+int TextureLayoutSkyline::GetFitPosition(int segment_index, int width) const
+{
+	if (skyline[segment_index].x + width > dimensions.x)
+		return -1;
+
+	// The skyline spans the whole texture width, so the segments covering the rectangle are all within bounds.
+	int y = 0;
+	for (int i = segment_index; width > 0; i++)
+	{
+		y = Math::Max(y, skyline[i].y);
+		width -= skyline[i].width;
+	}
+
+	return y;
+}
+
+void TextureLayoutSkyline::Raise(int segment_index, int width, int y)
+{
+	const int x_end = skyline[segment_index].x + width;
+	skyline.insert(skyline.begin() + segment_index, Segment{skyline[segment_index].x, y, width});
+
+	// Remove or shorten the segments now covered by the new one.
+	const int next_index = segment_index + 1;
+	while (next_index < (int)skyline.size() && skyline[next_index].x < x_end)
+	{
+		Segment& segment = skyline[next_index];
+		const int segment_end = segment.x + segment.width;
+		if (segment_end <= x_end)
+		{
+			skyline.erase(skyline.begin() + next_index);
+		}
+		else
+		{
+			segment.width = segment_end - x_end;
+			segment.x = x_end;
+			break;
+		}
+	}
+
+	// Merge with neighboring segments at the same height.
+	if (next_index < (int)skyline.size() && skyline[next_index].y == y)
+	{
+		skyline[segment_index].width += skyline[next_index].width;
+		skyline.erase(skyline.begin() + next_index);
+	}
+	if (segment_index > 0 && skyline[segment_index - 1].y == y)
+	{
+		skyline[segment_index - 1].width += skyline[segment_index].width;
+		skyline.erase(skyline.begin() + segment_index);
+	}
+}
+
+} // namespace Rml
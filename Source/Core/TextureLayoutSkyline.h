@@ -0,0 +1,82 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_TEXTURELAYOUTSKYLINE_H
+#define RMLUI_CORE_TEXTURELAYOUTSKYLINE_H
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    Packs rectangles into a single texture of fixed dimensions using a skyline, the silhouette formed by the bottom edges of all
+    placed rectangles. Each rectangle is placed where its bottom edge ends up the highest, so that rectangles can be inserted one
+    at a time while still filling the texture tightly.
+
+    Like the other texture layouts, the top and left edges of the texture are padded by a pixel, and a pixel of padding is left to
+    the right and below each placed rectangle.
+ */
+
+class TextureLayoutSkyline {
+public:
+	TextureLayoutSkyline();
+	explicit TextureLayoutSkyline(Vector2i dimensions);
+
+	/// Finds room for a rectangle of the given dimensions.
+	/// @param[in] rectangle_dimensions The dimensions of the rectangle, excluding padding.
+	/// @param[out] out_position The position of the rectangle's top-left corner within the texture.
+	/// @return True if the rectangle was placed, false if there is no room for it.
+	bool Allocate(Vector2i rectangle_dimensions, Vector2i& out_position);
+
+	/// Marks an area of the texture as occupied, such as rectangles placed by another layout strategy.
+	/// @param[in] position The position of the area's top-left corner.
+	/// @param[in] rectangle_dimensions The dimensions of the area, excluding padding.
+	void Reserve(Vector2i position, Vector2i rectangle_dimensions);
+
+	/// Returns the dimensions of the texture.
+	Vector2i GetDimensions() const;
+
+private:
+	struct Segment {
+		int x, y, width;
+	};
+
+	// Returns the lowest y-coordinate a rectangle of the given width can be placed at starting from the given segment, or -1 if it
+	// does not fit horizontally.
+	int GetFitPosition(int segment_index, int width) const;
+
+	// Raises the skyline to 'y' over the given width, starting at the left edge of the segment at the given index. The skyline must
+	// not be above 'y' anywhere in this span.
+	void Raise(int segment_index, int width, int y);
+
+	Vector2i dimensions;
+	Vector<Segment> skyline;
+};
+
+} // namespace Rml
+#endif
@@ -29,6 +29,7 @@
 #include "TextureLayoutTexture.h"
 #include "TextureDatabase.h"
 #include "TextureLayout.h"
+#include "TextureLayoutSkyline.h"
 
 namespace Rml {
 
@@ -44,7 +45,7 @@ Vector2i TextureLayoutTexture::GetDimensions() const
 	return dimensions;
 }
 
-int TextureLayoutTexture::Generate(TextureLayout& layout, int maximum_dimensions)
+int TextureLayoutTexture::Generate(TextureLayout& layout, int maximum_dimensions, TextureLayoutPacking packing)
 {
 	// Come up with an estimate for how big a texture we need. Calculate the total square pixels
 	// required by the remaining rectangles to place, square-root it to get the dimensions of the
@@ -77,34 +78,16 @@ int TextureLayoutTexture::Generate(TextureLayout& layout, int maximum_dimensions
 	// Now we're layout out the rectangles in the texture. If we don't fit all the rectangles on
 	// and have room to grow (ie, haven't hit the maximum texture size in both dimensions) then
 	// we'll have another go with a bigger texture.
-	int num_placed_rectangles = 0;
 	for (;;)
 	{
-		bool success = true;
-		int height = 1;
-
-		while (num_placed_rectangles != unplaced_rectangles)
-		{
-			TextureLayoutRow row;
-			int row_size = row.Generate(layout, dimensions.x, height);
-			if (row_size == 0)
-			{
-				success = false;
-				break;
-			}
-
-			height += row.GetHeight() + 1;
-			if (height > dimensions.y)
-			{
-				// D'oh! We've exceeded our height boundaries. This row should be unplaced.
-				row.Unplace();
-				success = false;
-				break;
-			}
+		const bool can_grow = (dimensions.y > dimensions.x || dimensions.y << 1 <= maximum_dimensions);
 
-			rows.push_back(row);
-			num_placed_rectangles += row_size;
-		}
+		bool success = true;
+		int num_placed_rectangles = 0;
+		if (packing == TextureLayoutPacking::Skyline)
+			num_placed_rectangles = GenerateSkyline(layout, can_grow, success);
+		else
+			num_placed_rectangles = GenerateRows(layout, unplaced_rectangles, success);
 
 		// If the rectangles were successfully laid out within the texture limits, we're done.
 		if (success)
@@ -113,25 +96,82 @@ int TextureLayoutTexture::Generate(TextureLayout& layout, int maximum_dimensions
 		// Couldn't do it! Increase the texture size, clear the rectangles and try again - unless
 		// we've hit the maximum texture size, in which case return true if we've placed any
 		// rectangles (ie, the layout isn't empty).
+		if (!can_grow)
+			return num_placed_rectangles;
+
 		if (dimensions.y > dimensions.x)
 			dimensions.x = dimensions.y;
 		else
-		{
-			if (dimensions.y << 1 > maximum_dimensions)
-				return num_placed_rectangles;
-
 			dimensions.y <<= 1;
-		}
 
 		// Unplace all of the glyphs we tried to place and have an other crack.
 		for (size_t i = 0; i < rows.size(); i++)
 			rows[i].Unplace();
+		for (TextureLayoutRectangle* rectangle : rectangles)
+			rectangle->Unplace();
 
 		rows.clear();
-		num_placed_rectangles = 0;
+		rectangles.clear();
 	}
 }
 
+int TextureLayoutTexture::GenerateRows(TextureLayout& layout, int num_unplaced_rectangles, bool& out_success)
+{
+	int num_placed_rectangles = 0;
+	int height = 1;
+
+	while (num_placed_rectangles != num_unplaced_rectangles)
+	{
+		TextureLayoutRow row;
+		int row_size = row.Generate(layout, dimensions.x, height);
+		if (row_size == 0)
+		{
+			out_success = false;
+			break;
+		}
+
+		height += row.GetHeight() + 1;
+		if (height > dimensions.y)
+		{
+			// D'oh! We've exceeded our height boundaries. This row should be unplaced.
+			row.Unplace();
+			out_success = false;
+			break;
+		}
+
+		rows.push_back(row);
+		num_placed_rectangles += row_size;
+	}
+
+	return num_placed_rectangles;
+}
+
+int TextureLayoutTexture::GenerateSkyline(TextureLayout& layout, bool can_grow, bool& out_success)
+{
+	TextureLayoutSkyline skyline(dimensions);
+
+	for (int i = 0; i < layout.GetNumRectangles(); ++i)
+	{
+		TextureLayoutRectangle& rectangle = layout.GetRectangle(i);
+		if (rectangle.IsPlaced())
+			continue;
+
+		Vector2i position;
+		if (!skyline.Allocate(rectangle.GetDimensions(), position))
+		{
+			out_success = false;
+			if (can_grow)
+				break;
+			continue;
+		}
+
+		rectangle.Place(layout.GetNumTextures(), position);
+		rectangles.push_back(&rectangle);
+	}
+
+	return (int)rectangles.size();
+}
+
 UniquePtr<byte[]> TextureLayoutTexture::AllocateTexture()
 {
 	// Note: this object does not free this texture data. It is freed in the font texture loader.
@@ -147,6 +187,8 @@ UniquePtr<byte[]> TextureLayoutTexture::AllocateTexture()
 
 		for (size_t i = 0; i < rows.size(); ++i)
 			rows[i].Allocate(texture_data.get(), dimensions.x * 4);
+		for (TextureLayoutRectangle* rectangle : rectangles)
+			rectangle->Allocate(texture_data.get(), dimensions.x * 4);
 	}
 
 	return texture_data;
@@ -37,6 +37,12 @@ namespace Rml {
 class TextureLayout;
 class TextureResource;
 
+/// The strategy used to position rectangles within each texture of a texture layout.
+enum class TextureLayoutPacking {
+	Rows,    // Fill rows from left to right, each row as tall as its tallest rectangle.
+	Skyline, // Place each rectangle where its bottom edge is the highest, see TextureLayoutSkyline.
+};
+
 /**
     A texture layout texture is a single rectangular area which sub-rectangles are placed on within
     a complete texture layout.
@@ -58,8 +64,9 @@ public:
 	/// @param[in] layout The layout to position rectangles from.
 	/// @param[in] maximum_dimensions The maximum dimensions of this texture. If this is not big enough to place all the rectangles, then as many will
 	/// be placed as possible.
+	/// @param[in] packing The strategy used to position the rectangles.
 	/// @return The number of placed rectangles.
-	int Generate(TextureLayout& layout, int maximum_dimensions);
+	int Generate(TextureLayout& layout, int maximum_dimensions, TextureLayoutPacking packing = TextureLayoutPacking::Rows);
 
 	/// Allocates the texture.
 	/// @return The allocated texture data.
@@ -68,8 +75,16 @@ public:
 private:
 	using RowList = Vector<TextureLayoutRow>;
 
+	// Places the unplaced rectangles of the layout in rows, returns the number of placed rectangles.
+	int GenerateRows(TextureLayout& layout, int num_unplaced_rectangles, bool& out_success);
+	// Places the unplaced rectangles of the layout on a skyline, returns the number of placed rectangles. When the texture can't
+	// grow any further, rectangles which don't fit are skipped so that smaller ones may still fill the remaining gaps.
+	int GenerateSkyline(TextureLayout& layout, bool can_grow, bool& out_success);
+
 	Vector2i dimensions;
 	RowList rows;
+	// Rectangles placed by the skyline packing.
+	Vector<TextureLayoutRectangle*> rectangles;
 };
 
 } // namespace Rml
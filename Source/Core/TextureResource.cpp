@@ -73,6 +73,8 @@ TextureHandle TextureResource::GetHandle()
 {
 	if (!loaded)
 		Load();
+	if (atlas_image_index >= 0)
+		return TextureDatabase::GetAtlas()->GetHandle(atlas_image_index);
 	return handle;
 }
 
@@ -83,6 +85,15 @@ Vector2i TextureResource::GetDimensions()
 	return dimensions;
 }
 
+Rectanglef TextureResource::GetAtlasRegion()
+{
+	if (!loaded)
+		Load();
+	if (atlas_image_index >= 0)
+		return TextureDatabase::GetAtlas()->GetRegion(atlas_image_index);
+	return Rectanglef::FromSize(Vector2f(1.f));
+}
+
 const String& TextureResource::GetSource() const
 {
 	return source;
@@ -92,9 +103,18 @@ void TextureResource::Release()
 {
 	if (loaded)
 	{
-		RenderInterface* render_interface = ::Rml::GetRenderInterface();
-		RMLUI_ASSERT(render_interface);
-		render_interface->ReleaseTexture(handle);
+		if (atlas_image_index >= 0)
+		{
+			if (TextureAtlas* atlas = TextureDatabase::GetAtlas())
+				atlas->Remove(atlas_image_index);
+			atlas_image_index = -1;
+		}
+		else
+		{
+			RenderInterface* render_interface = ::Rml::GetRenderInterface();
+			RMLUI_ASSERT(render_interface);
+			render_interface->ReleaseTexture(handle);
+		}
 
 		handle = {};
 		dimensions = {};
@@ -129,6 +149,31 @@ bool TextureResource::Load()
 		return true;
 	}
 
+	// Place small images in the texture atlas, which requires the render interface to provide us with the image data.
+	if (TextureDatabase::IsAtlasEnabled())
+	{
+		Vector<byte> data;
+		if (render_interface->LoadTextureData(data, dimensions, source))
+		{
+			if (TextureDatabase::FitsInAtlas(dimensions))
+			{
+				atlas_image_index = TextureDatabase::GetAtlas()->Add(std::move(data), dimensions, source);
+				return true;
+			}
+
+			// The image is too large for the atlas, generate a separate texture from the data we already loaded.
+			if (!render_interface->GenerateTexture(handle, data.data(), dimensions))
+			{
+				Log::Message(Log::LT_WARNING, "Failed to generate texture from %s.", source.c_str());
+				handle = {};
+				dimensions = {};
+				return false;
+			}
+
+			return true;
+		}
+	}
+
 	// No callback function, load the texture through the render interface.
 	if (!render_interface->LoadTexture(handle, dimensions, source))
 	{
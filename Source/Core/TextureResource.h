@@ -58,6 +58,9 @@ public:
 	TextureHandle GetHandle();
 	/// Returns the dimensions of the resource's texture.
 	Vector2i GetDimensions();
+	/// Returns the region of the texture handle occupied by the resource, in normalized texture coordinates.
+	/// This is the full texture unless the resource is placed in the texture atlas.
+	Rectanglef GetAtlasRegion();
 
 	/// Returns the resource's source.
 	const String& GetSource() const;
@@ -80,6 +83,9 @@ private:
 	Vector2i dimensions;
 	bool loaded = false;
 
+	// The index of our image in the texture atlas, or -1 if we own the texture handle.
+	int atlas_image_index = -1;
+
 	UniquePtr<TextureCallback> texture_callback;
 };
 
@@ -0,0 +1,103 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "WorkerPool.h"
+
+namespace Rml {
+
+WorkerPool::WorkerPool(int num_workers)
+{
+	for (int i = 0; i < num_workers; i++)
+		threads.emplace_back([this]() { RunWorker(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	work_condition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+void WorkerPool::Execute(const Function<void()>& new_task)
+{
+	if (threads.empty())
+	{
+		new_task();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task = &new_task;
+		num_working = (int)threads.size();
+		generation += 1;
+	}
+	work_condition.notify_all();
+
+	new_task();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done_condition.wait(lock, [this]() { return num_working == 0; });
+	task = nullptr;
+}
+
+int WorkerPool::GetNumThreads() const
+{
+	return (int)threads.size() + 1;
+}
+
+void WorkerPool::RunWorker()
+{
+	uint64_t completed_generation = 0;
+	while (true)
+	{
+		const Function<void()>* current_task = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			work_condition.wait(lock, [&]() { return quit || generation != completed_generation; });
+			if (quit)
+				return;
+			completed_generation = generation;
+			current_task = task;
+		}
+
+		(*current_task)();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		num_working -= 1;
+		if (num_working == 0)
+			done_condition.notify_one();
+	}
+}
+
+} // namespace Rml
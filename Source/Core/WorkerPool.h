@@ -0,0 +1,73 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_WORKERPOOL_H
+#define RMLUI_CORE_WORKERPOOL_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Rml {
+
+/**
+    A set of worker threads for running a task in parallel together with the calling thread.
+
+    The task is run once on every thread, and is itself responsible for dividing the work between them, such as by taking the next item
+    from an atomic counter until all items are done.
+ */
+
+class WorkerPool : NonCopyMoveable {
+public:
+	/// Starts the given number of worker threads, in addition to the calling thread.
+	WorkerPool(int num_workers);
+	~WorkerPool();
+
+	/// Runs the task on all worker threads and the calling thread, returns once it has completed on all of them.
+	void Execute(const Function<void()>& task);
+
+	/// Returns the number of threads taking part in each task, including the calling thread.
+	int GetNumThreads() const;
+
+private:
+	void RunWorker();
+
+	Vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable work_condition;
+	std::condition_variable done_condition;
+	const Function<void()>* task = nullptr;
+	uint64_t generation = 0;
+	int num_working = 0;
+	bool quit = false;
+};
+
+} // namespace Rml
+#endif
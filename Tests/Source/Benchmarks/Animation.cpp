@@ -0,0 +1,130 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static const String rml_animation_document = R"(
+<rml>
+<head>
+    <link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		@keyframes spin {
+			from { transform: rotate(0deg); }
+			to   { transform: rotate(360deg); }
+		}
+		@keyframes pulse {
+			from { opacity: 1; }
+			to   { opacity: 0.2; }
+		}
+		@keyframes grow {
+			from { width: 16px; }
+			to   { width: 24px; }
+		}
+		.icon {
+			display: inline-block;
+			width: 16px;
+			height: 16px;
+			margin: 2px;
+			background: #c3c3c3;
+			border: 1px #55f;
+			transform: rotate(0deg);
+		}
+		.icon div {
+			height: 8px;
+			background: #afa;
+		}
+		#transform .icon { animation: 2s spin infinite; }
+		#opacity .icon { animation: 2s pulse infinite alternate; }
+		#width .icon { animation: 2s grow infinite alternate; }
+	</style>
+</head>
+<body>
+<div id="icons"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("animation")
+{
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml_animation_document);
+	REQUIRE(document);
+	document->Show();
+
+	Element* icons = document->GetElementById("icons");
+	String icons_rml;
+	for (int i = 0; i < 1000; i++)
+		icons_rml += "<div class='icon'><div/></div>";
+	icons->SetInnerRML(icons_rml);
+
+	TestsShell::RenderLoop();
+
+	nanobench::Bench bench;
+	bench.title("Animation");
+	bench.relative(true);
+	bench.minEpochIterations(20);
+	bench.warmup(5);
+	FrameStatsHarness harness(bench);
+
+	harness.Run("Reference (update + render)", [&] {
+		context->Update();
+		context->Render();
+	});
+
+	// Animations of transform and opacity only affect compositing, compare them against an animation affecting layout.
+	double time = 0.0;
+	for (const char* id : {"transform", "opacity", "width"})
+	{
+		icons->SetId(id);
+		TestsShell::RenderLoop();
+
+		harness.Run(String("Animate ") + id, [&] {
+			time += 1.0 / 60.0;
+			system_interface->SetTime(time);
+			context->Update();
+			context->Render();
+		});
+	}
+
+	document->Close();
+	system_interface->SetTime(0.0);
+}
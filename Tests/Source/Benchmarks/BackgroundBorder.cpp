@@ -27,9 +27,12 @@
  */
 
 #include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Geometry.h>
+#include <RmlUi/Core/GeometryUtilities.h>
 #include <RmlUi/Core/Types.h>
 #include <doctest.h>
 #include <nanobench.h>
@@ -97,7 +100,9 @@ TEST_CASE("backgrounds_and_borders")
 
 	TestsShell::RenderLoop();
 
-	bench.run("Reference (update + render)", [&] {
+	FrameStatsHarness harness(bench);
+
+	harness.Run("Reference (update + render)", [&] {
 		context->Update();
 		context->Render();
 	});
@@ -107,7 +112,7 @@ TEST_CASE("backgrounds_and_borders")
 		document->QuerySelectorAll(elements, "div > div");
 		REQUIRE(!elements.empty());
 
-		bench.run("Background all", [&] {
+		harness.Run("Background all", [&] {
 			// Force regeneration of backgrounds without changing layout
 			for (auto& element : elements)
 				element->SetProperty(Rml::PropertyId::BackgroundColor, Rml::Property(Colourb(), Unit::COLOUR));
@@ -115,7 +120,7 @@ TEST_CASE("backgrounds_and_borders")
 			context->Render();
 		});
 
-		bench.run("Border all", [&] {
+		harness.Run("Border all", [&] {
 			// Force regeneration of borders without changing layout
 			for (auto& element : elements)
 				element->SetProperty(Rml::PropertyId::BorderLeftColor, Rml::Property(Colourb(), Unit::COLOUR));
@@ -130,13 +135,65 @@ TEST_CASE("backgrounds_and_borders")
 		document->QuerySelectorAll(elements, "#" + id + " > div");
 		REQUIRE(!elements.empty());
 
-		bench.run("Border " + id, [&] {
+		harness.Run("Border " + id, [&] {
 			for (auto& element : elements)
 				element->SetProperty(Rml::PropertyId::BorderLeftColor, Rml::Property(Colourb(), Unit::COLOUR));
 			context->Update();
 			context->Render();
 		});
+
+		int width = 300;
+		harness.Run("Resize " + id, [&] {
+			// Animate the size, thereby regenerating the backgrounds and borders with new radii every iteration
+			width = (width >= 340 ? 300 : width + 1);
+			for (auto& element : elements)
+				element->SetProperty(Rml::PropertyId::Width, Rml::Property(float(width), Unit::PX));
+			context->Update();
+			context->Render();
+		});
 	}
 
 	document->Close();
 }
+
+TEST_CASE("backgrounds_and_borders.generate")
+{
+	nanobench::Bench bench;
+	bench.title("Generate backgrounds and borders");
+	bench.relative(true);
+	bench.minEpochIterations(1000);
+	bench.warmup(100);
+
+	const Colourb background_colour(195, 195, 195);
+	const Colourb border_colours[4] = {Colourb(85, 85, 255), Colourb(255, 85, 119), Colourb(85, 85, 255), Colourb(170, 255, 170)};
+
+	const struct {
+		const char* name;
+		Vector4f radius;
+	} cases[] = {
+		{"No radius", Vector4f(0.f)},
+		{"Small radius", Vector4f(5.f)},
+		{"Large radius", Vector4f(80.f, 30.f, 80.f, 30.f)},
+	};
+
+	for (const auto& test_case : cases)
+	{
+		Geometry geometry;
+		int width = 300;
+
+		bench.run(test_case.name, [&] {
+			// Vary the size to mimic an animated element, which generates a new set of arcs every iteration.
+			width = (width >= 340 ? 300 : width + 1);
+
+			Box box(Vector2f(float(width), 200.f));
+			box.SetEdge(BoxArea::Border, BoxEdge::Top, 10.f);
+			box.SetEdge(BoxArea::Border, BoxEdge::Right, 5.f);
+			box.SetEdge(BoxArea::Border, BoxEdge::Bottom, 25.f);
+			box.SetEdge(BoxArea::Border, BoxEdge::Left, 20.f);
+
+			geometry.Release(true);
+			GeometryUtilities::GenerateBackgroundBorder(&geometry, box, Vector2f(0.f), test_case.radius, background_colour, border_colours);
+			nanobench::doNotOptimizeAway(geometry.GetVertices().data());
+		});
+	}
+}
@@ -0,0 +1,128 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static const String document_decorator_rml = R"(
+<rml>
+<head>
+	<title>Decorators</title>
+	<style>
+		@spritesheet grid_sheet
+		{
+			src: /assets/invader.tga;
+			button-outer: 247px 0px 159px 45px;
+			button-inner: 259px 19px 135px 1px;
+			title-l: 147px 0px 82px 85px;
+			title-c: 229px 0px 1px 85px;
+			title-r: 231px 0px 15px 85px;
+		}
+		body {
+			left: 0;
+			top: 0;
+			right: 0;
+			bottom: 0;
+		}
+		div {
+			float: left;
+			width: 40px;
+			height: 30px;
+			margin: 2px;
+		}
+		.ninepatch { decorator: ninepatch(button-outer, button-inner); }
+		.horizontal { decorator: tiled-horizontal(title-l, title-c, title-r); }
+		.image { decorator: image(/assets/high_scores_alien_1.tga); }
+	</style>
+</head>
+<body/>
+</rml>
+)";
+
+TEST_CASE("decorator.grid")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	// A grid of equally sized buttons, as in a typical inventory or level select screen.
+	String document_rml = document_decorator_rml;
+	String buttons;
+	const char* classes[] = {"ninepatch", "horizontal", "image"};
+	for (int i = 0; i < 600; i++)
+		buttons += CreateString(64, "<div class=\"%s\"/>", classes[i % 3]);
+	document_rml.replace(document_rml.find("<body/>"), 7, "<body>" + buttons + "</body>");
+
+	nanobench::Bench bench;
+	bench.title("Decorator grid");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+	bench.warmup(5);
+	FrameStatsHarness harness(bench);
+
+	harness.Run("LoadDocument + Render", [&] {
+		ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+		document->Show();
+		context->Update();
+		context->Render();
+		document->Close();
+		context->Update();
+	});
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	ElementList elements;
+	document->QuerySelectorAll(elements, "div");
+	REQUIRE(!elements.empty());
+
+	int width = 40;
+	harness.Run("Resize all", [&] {
+		width = (width >= 60 ? 40 : width + 1);
+		for (Element* element : elements)
+			element->SetProperty(PropertyId::Width, Property(float(width), Unit::PX));
+		context->Update();
+		context->Render();
+	});
+
+	document->Close();
+	context->Update();
+}
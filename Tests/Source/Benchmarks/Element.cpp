@@ -27,6 +27,7 @@
  */
 
 #include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -66,6 +67,36 @@ static const String document_rml = R"(
 </rml>
 )";
 
+static const String document_scroll_rml = R"(
+<rml>
+<head>
+	<link type="text/template" href="/assets/window.rml"/>
+	<title>Benchmark Sample</title>
+	<style>
+		body.window
+		{
+			max-width: 2000px;
+			max-height: 2000px;
+			left: 100px;
+			top: 50px;
+			width: 1300px;
+			height: 600px;
+		}
+		#performance 
+		{
+			width: 800px;
+			height: 300px;
+			overflow: auto;
+		}
+	</style>
+</head>
+
+<body template="window">
+<div id="performance"/>
+</body>
+</rml>
+)";
+
 static int GetNumDescendentElements(Element* element)
 {
 	const int num_children = element->GetNumChildren(true);
@@ -156,6 +187,7 @@ TEST_CASE("element.creation_and_destruction")
 	bench.title("Element");
 	bench.timeUnit(std::chrono::microseconds(1), "us");
 	bench.relative(true);
+	FrameStatsHarness harness(bench);
 
 	bench.run("Update (unmodified)", [&] { context->Update(); });
 
@@ -174,7 +206,7 @@ TEST_CASE("element.creation_and_destruction")
 		context->Update();
 	});
 
-	bench.run("Render", [&] { context->Render(); });
+	harness.Run("Render", [&] { context->Render(); });
 
 	bench.run("SetInnerRML", [&] { el->SetInnerRML(rml); });
 
@@ -183,7 +215,7 @@ TEST_CASE("element.creation_and_destruction")
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	harness.Run("SetInnerRML + Update + Render", [&] {
 		el->SetInnerRML(rml);
 		context->Update();
 		context->Render();
@@ -219,6 +251,7 @@ TEST_CASE("element.long_texts")
 	bench.title("Element");
 	bench.timeUnit(std::chrono::microseconds(1), "us");
 	bench.relative(true);
+	FrameStatsHarness harness(bench);
 
 	bench.run("Update (unmodified)", [&] { context->Update(); });
 
@@ -237,7 +270,7 @@ TEST_CASE("element.long_texts")
 		context->Update();
 	});
 
-	bench.run("Render", [&] { context->Render(); });
+	harness.Run("Render", [&] { context->Render(); });
 
 	bench.run("SetInnerRML", [&] { el->SetInnerRML(rml); });
 
@@ -246,7 +279,7 @@ TEST_CASE("element.long_texts")
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	harness.Run("SetInnerRML + Update + Render", [&] {
 		el->SetInnerRML(rml);
 		context->Update();
 		context->Render();
@@ -255,6 +288,141 @@ TEST_CASE("element.long_texts")
 	document->Close();
 }
 
+TEST_CASE("element.scroll_render")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_scroll_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+	constexpr int num_rows = 500;
+	const String rml = GenerateRml(num_rows, DefaultRow);
+
+	el->SetInnerRML(rml);
+	context->Update();
+	context->Render();
+	TestsShell::RenderLoop();
+
+	const Context::RenderStatistics& statistics = context->GetRenderStatistics();
+
+	String msg = Rml::CreateString(256, "\nScrolling container of %d total elements, %d elements rendered and %d culled.\n",
+		GetNumDescendentElements(el), statistics.num_elements_rendered, statistics.num_elements_culled);
+	msg += TestsShell::GetRenderStats();
+	MESSAGE(msg);
+
+	nanobench::Bench bench;
+	bench.title("Element scroll");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+	FrameStatsHarness harness(bench);
+
+	harness.Run("Render (top)", [&] { context->Render(); });
+
+	el->SetScrollTop(0.5f * el->GetScrollHeight());
+	context->Update();
+
+	harness.Run("Render (middle)", [&] { context->Render(); });
+
+	const float scroll_step = 0.01f * el->GetScrollHeight();
+	float scroll_top = 0.f;
+
+	harness.Run("Scroll + Update + Render", [&] {
+		scroll_top += scroll_step;
+		if (scroll_top > el->GetScrollHeight() - el->GetClientHeight())
+			scroll_top = 0.f;
+		el->SetScrollTop(scroll_top);
+		context->Update();
+		context->Render();
+	});
+
+	document->Close();
+}
+
+TEST_CASE("element.stacking_context")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+	constexpr int num_rows = 200;
+	el->SetInnerRML(GenerateRml(num_rows, DefaultRow));
+
+	context->Update();
+	context->Render();
+	TestsShell::RenderLoop();
+
+	// Notifications are added on top of the rows every frame, while the oldest one is removed. The rows are placed in the same stacking context.
+	Element* content = document->GetElementById("content");
+	REQUIRE(content);
+
+	constexpr int num_notifications = 10;
+	Vector<Element*> notifications;
+	int notification_counter = 0;
+
+	auto AddNotification = [&]() {
+		ElementPtr notification = document->CreateElement("div");
+		notification->SetProperty("position", "absolute");
+		notification->SetProperty("right", "20px");
+		notification->SetProperty("top", Rml::CreateString(32, "%dpx", 20 + 50 * (notification_counter % num_notifications)));
+		notification->SetProperty("width", "250px");
+		notification->SetProperty("height", "40px");
+		notification->SetInnerRML(Rml::CreateString(64, "Notification <b>%d</b>", notification_counter));
+		notification_counter += 1;
+		notifications.push_back(content->AppendChild(std::move(notification)));
+	};
+
+	for (int i = 0; i < num_notifications; i++)
+		AddNotification();
+	context->Update();
+	context->Render();
+
+	auto CycleNotifications = [&]() {
+		content->RemoveChild(notifications.front());
+		notifications.erase(notifications.begin());
+		AddNotification();
+		context->Update();
+	};
+
+	CycleNotifications();
+	context->Render();
+	const Context::RenderStatistics& statistics = context->GetRenderStatistics();
+
+	String msg = Rml::CreateString(256,
+		"\nCycling notifications on top of a stacking context with %d total elements, %d stacking contexts built and %d insertions per frame.\n",
+		GetNumDescendentElements(content), statistics.num_stacking_contexts_built, statistics.num_stacking_context_insertions);
+	msg += TestsShell::GetRenderStats();
+	MESSAGE(msg);
+
+	nanobench::Bench bench;
+	bench.title("Element stacking context");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+	FrameStatsHarness harness(bench);
+
+	harness.Run("Update + Render", [&] {
+		context->Update();
+		context->Render();
+	});
+
+	bench.run("Cycle notification + Update", CycleNotifications);
+
+	harness.Run("Cycle notification + Update + Render", [&] {
+		CycleNotifications();
+		context->Render();
+	});
+
+	document->Close();
+}
+
 TEST_CASE("element.asymptotic_complexity")
 {
 	Context* context = TestsShell::GetContext();
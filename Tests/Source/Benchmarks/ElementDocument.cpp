@@ -28,6 +28,7 @@
 
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -103,6 +104,7 @@ TEST_CASE("elementdocument")
 		bench.title("ElementDocument");
 		bench.timeUnit(std::chrono::microseconds(1), "us");
 		bench.relative(true);
+		FrameStatsHarness harness(bench);
 
 		bench.run("LoadDocument", [&] {
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
@@ -125,7 +127,7 @@ TEST_CASE("elementdocument")
 			context->Update();
 		});
 
-		bench.run("LoadDocument + Show + Update + Render", [&] {
+		harness.Run("LoadDocument + Show + Update + Render", [&] {
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
 			context->Update();
@@ -142,6 +144,7 @@ TEST_CASE("elementdocument")
 		bench.title("ElementDocument w/ClearStyleSheetCache");
 		bench.timeUnit(std::chrono::microseconds(1), "us");
 		bench.relative(true);
+		FrameStatsHarness harness(bench);
 
 		bench.run("Clear + LoadDocument", [&] {
 			Factory::ClearStyleSheetCache();
@@ -167,7 +170,7 @@ TEST_CASE("elementdocument")
 			context->Update();
 		});
 
-		bench.run("Clear + LoadDocument + Show + Update + Render", [&] {
+		harness.Run("Clear + LoadDocument + Show + Update + Render", [&] {
 			Factory::ClearStyleSheetCache();
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
@@ -180,3 +183,61 @@ TEST_CASE("elementdocument")
 		});
 	}
 }
+
+static void BenchmarkFirstFrames(FrameStatsHarness& harness, Context* context, const char* name_suffix)
+{
+	// The first render after loading a document generates all its geometry, which is then compiled at the start of the second render.
+	harness.Run(String("LoadDocument + Render") + name_suffix, [&] {
+		ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+		document->Show();
+		context->Update();
+		TestsShell::BeginFrame();
+		context->Render();
+		TestsShell::PresentFrame();
+		document->Close();
+		context->Update();
+	});
+
+	harness.Run(String("LoadDocument + Render + Render") + name_suffix, [&] {
+		ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+		document->Show();
+		context->Update();
+		TestsShell::BeginFrame();
+		context->Render();
+		TestsShell::PresentFrame();
+		context->Update();
+		TestsShell::BeginFrame();
+		context->Render();
+		TestsShell::PresentFrame();
+		document->Close();
+		context->Update();
+	});
+}
+
+TEST_CASE("elementdocument.first_frame")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	nanobench::Bench bench;
+	bench.title("ElementDocument first frames");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+	FrameStatsHarness harness(bench);
+
+	BenchmarkFirstFrames(harness, context, "");
+
+	// With the dummy renderer, also measure the case where geometry is compiled in batches instead of placed in the geometry arena.
+	if (TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface())
+	{
+		TestsShell::ShutdownShell();
+		render_interface->SetGeometryChunksSupported(false);
+		context = TestsShell::GetContext();
+		REQUIRE(context);
+
+		BenchmarkFirstFrames(harness, context, " (w/o chunks)");
+
+		render_interface->SetGeometryChunksSupported(true);
+		TestsShell::ShutdownShell();
+	}
+}
@@ -27,6 +27,7 @@
  */
 
 #include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -347,6 +348,7 @@ TEST_CASE("flexbox")
 		nanobench::Bench bench;
 		bench.title("Flexbox basic layout");
 		bench.relative(true);
+		FrameStatsHarness harness(bench);
 
 		// Construct the flexbox layout document.
 		ElementDocument* document = context->LoadDocumentFromMemory(rml_flexbox_basic_document);
@@ -383,7 +385,7 @@ TEST_CASE("flexbox")
 
 		bench.run("Update (unmodified)", [&] { context->Update(); });
 
-		bench.run("Render", [&] { context->Render(); });
+		harness.Run("Render", [&] { context->Render(); });
 
 		bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
 
@@ -400,17 +402,17 @@ TEST_CASE("flexbox")
 			context->Update();
 		});
 
-		bench.run("SetInnerRML + Update + Render (float reference)", [&] {
+		harness.Run("SetInnerRML + Update + Render (float reference)", [&] {
 			document_float_reference->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 			context->Render();
 		});
-		bench.run("SetInnerRML + Update + Render (fast version)", [&] {
+		harness.Run("SetInnerRML + Update + Render (fast version)", [&] {
 			document_fast->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 			context->Render();
 		});
-		bench.run("SetInnerRML + Update + Render", [&] {
+		harness.Run("SetInnerRML + Update + Render", [&] {
 			document->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 			context->Render();
@@ -425,6 +427,7 @@ TEST_CASE("flexbox")
 		nanobench::Bench bench;
 		bench.title("Flexbox mixed");
 		bench.relative(true);
+		FrameStatsHarness harness(bench);
 
 		ElementDocument* document = context->LoadDocumentFromMemory(rml_flexbox_mixed_document);
 		REQUIRE(document);
@@ -438,7 +441,7 @@ TEST_CASE("flexbox")
 
 		bench.run("Update (unmodified)", [&] { context->Update(); });
 
-		bench.run("Render", [&] { context->Render(); });
+		harness.Run("Render", [&] { context->Render(); });
 
 		bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
 
@@ -447,7 +450,7 @@ TEST_CASE("flexbox")
 			context->Update();
 		});
 
-		bench.run("SetInnerRML + Update + Render", [&] {
+		harness.Run("SetInnerRML + Update + Render", [&] {
 			document->SetInnerRML(rml_flexbox_mixed_body);
 			context->Update();
 			context->Render();
@@ -460,6 +463,7 @@ TEST_CASE("flexbox")
 		nanobench::Bench bench;
 		bench.title("Flexbox scroll");
 		bench.relative(true);
+		FrameStatsHarness harness(bench);
 
 		ElementDocument* document = context->LoadDocumentFromMemory(rml_flexbox_scroll_document);
 		REQUIRE(document);
@@ -473,7 +477,7 @@ TEST_CASE("flexbox")
 
 		bench.run("Update (unmodified)", [&] { context->Update(); });
 
-		bench.run("Render", [&] { context->Render(); });
+		harness.Run("Render", [&] { context->Render(); });
 
 		bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
 
@@ -482,7 +486,7 @@ TEST_CASE("flexbox")
 			context->Update();
 		});
 
-		bench.run("SetInnerRML + Update + Render", [&] {
+		harness.Run("SetInnerRML + Update + Render", [&] {
 			document->SetInnerRML(rml_flexbox_scroll_body);
 			context->Update();
 			context->Render();
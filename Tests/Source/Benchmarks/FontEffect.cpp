@@ -27,13 +27,23 @@
  */
 
 #include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
+#include <PlatformExtensions.h>
 #include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ConvolutionFilter.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/Types.h>
 #include <doctest.h>
 #include <nanobench.h>
 
+#if defined(RMLUI_PLATFORM_WIN32)
+	#include <direct.h>
+#else
+	#include <unistd.h>
+#endif
+
 using namespace ankerl;
 using namespace Rml;
 
@@ -44,7 +54,7 @@ static const String rml_font_effect_document = R"(
     <link type="text/rcss" href="/../Tests/Data/style.rcss"/>
 	<style>
 		body {
-			font-size: 25px;
+			font-size: %dpx;
 			font-effect: %s(%dpx #ff6);
 		}
 	</style>
@@ -63,19 +73,22 @@ TEST_CASE("font_effect")
 	nanobench::Bench bench;
 	bench.title("Font effect");
 	bench.relative(true);
+	FrameStatsHarness harness(bench);
 
 	for (const char* effect_name : {"shadow", "blur", "outline", "glow"})
 	{
+		constexpr int font_size = 25;
 		constexpr int effect_size = 8;
 
-		const String rml_document = CreateString(rml_font_effect_document.size() + 100, rml_font_effect_document.c_str(), effect_name, effect_size);
+		const String rml_document =
+			CreateString(rml_font_effect_document.size() + 100, rml_font_effect_document.c_str(), font_size, effect_name, effect_size);
 
 		ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
 		document->Show();
 		context->Update();
 		context->Render();
 
-		bench.run(effect_name, [&]() {
+		harness.Run(effect_name, [&]() {
 			Rml::ReleaseFontResources();
 			context->Render();
 		});
@@ -85,3 +98,253 @@ TEST_CASE("font_effect")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("font_effect.large")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	nanobench::Bench bench;
+	bench.title("Font effect (large)");
+	bench.relative(true);
+	FrameStatsHarness harness(bench);
+
+	for (const char* effect_name : {"shadow", "blur", "outline", "glow"})
+	{
+		constexpr int font_size = 60;
+		constexpr int effect_size = 16;
+
+		const String rml_document =
+			CreateString(rml_font_effect_document.size() + 100, rml_font_effect_document.c_str(), font_size, effect_name, effect_size);
+
+		ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
+		document->Show();
+		context->Update();
+		context->Render();
+
+		for (int num_threads : {1, 4})
+		{
+			Rml::SetFontEffectThreads(num_threads);
+
+			const String name = CreateString(64, "%s (%d thread%s)", effect_name, num_threads, num_threads > 1 ? "s" : "");
+			harness.Run(name, [&]() {
+				Rml::ReleaseFontResources();
+				context->Render();
+			});
+		}
+
+		Rml::SetFontEffectThreads(1);
+		document->Close();
+	}
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_effect.distance_field")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	nanobench::Bench bench;
+	bench.title("Font effect (zoom through 40 sizes)");
+	bench.relative(true);
+	FrameStatsHarness harness(bench);
+
+	for (const char* effect_name : {"outline", "glow"})
+	{
+		const String rml_document = CreateString(rml_font_effect_document.size() + 100, rml_font_effect_document.c_str(), 20, effect_name, 4);
+
+		ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
+		document->Show();
+		context->Update();
+		context->Render();
+
+		for (int distance_field_size : {0, 64})
+		{
+			Rml::SetFontDistanceFieldSize(distance_field_size);
+
+			const String name = CreateString(64, "%s (%s)", effect_name, distance_field_size > 0 ? "distance field" : "bitmap");
+			harness.Run(name, [&]() {
+				Rml::ReleaseFontResources();
+				for (int font_size = 10; font_size < 50; font_size++)
+				{
+					document->SetProperty(PropertyId::FontSize, Property(float(font_size), Unit::PX));
+					context->Update();
+					context->Render();
+				}
+			});
+		}
+
+		Rml::SetFontDistanceFieldSize(0);
+		document->Close();
+	}
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_effect.file_cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	nanobench::Bench bench;
+	bench.title("Font effect (startup through 20 sizes)");
+	bench.relative(true);
+
+	const String cache_directory = "font_effect_cache";
+	auto ClearCacheDirectory = [&]() {
+		for (const String& file_name : PlatformExtensions::ListFiles(cache_directory))
+			remove((cache_directory + '/' + file_name).c_str());
+	};
+
+	const String rml_document = CreateString(rml_font_effect_document.size() + 100, rml_font_effect_document.c_str(), 20, "glow", 4);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// Release all font resources and render the document at each size, like starting the application with the given cache state.
+	auto RenderAllSizes = [&]() {
+		Rml::ReleaseFontResources();
+		for (int font_size = 10; font_size < 30; font_size++)
+		{
+			document->SetProperty(PropertyId::FontSize, Property(float(font_size), Unit::PX));
+			context->Update();
+			context->Render();
+		}
+	};
+
+	bench.run("No cache", [&]() { RenderAllSizes(); });
+
+	Rml::SetFontCacheDirectory(cache_directory);
+	bench.run("Cold cache", [&]() {
+		ClearCacheDirectory();
+		RenderAllSizes();
+	});
+
+	// Release the font resources once more so that all glyphs are saved, then every iteration loads everything from the cache.
+	RenderAllSizes();
+	Rml::ReleaseFontResources();
+	bench.run("Warm cache", [&]() { RenderAllSizes(); });
+
+	Rml::SetFontCacheDirectory("");
+	ClearCacheDirectory();
+#if defined(RMLUI_PLATFORM_WIN32)
+	_rmdir(cache_directory.c_str());
+#else
+	rmdir(cache_directory.c_str());
+#endif
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+// The previous convolution filter implementation, visiting every kernel position for each pixel.
+static void RunReferenceFilter(const Vector2i kernel_radius, const float* kernel, FilterOperation operation, byte* destination,
+	Vector2i destination_dimensions, const byte* source, Vector2i source_dimensions, Vector2i source_offset)
+{
+	const Vector2i kernel_size = kernel_radius * 2 + Vector2i(1);
+
+	for (int y = 0; y < destination_dimensions.y; ++y)
+	{
+		for (int x = 0; x < destination_dimensions.x; ++x)
+		{
+			float opacity = 0.f;
+			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			{
+				const int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
+				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+				{
+					const int source_x = x - source_offset.x - kernel_radius.x + kernel_x;
+					if (source_y >= 0 && source_y < source_dimensions.y && source_x >= 0 && source_x < source_dimensions.x)
+					{
+						const float source_opacity = float(source[source_y * source_dimensions.x + source_x]);
+						const float pixel_opacity = source_opacity * kernel[kernel_y * kernel_size.x + kernel_x];
+						if (operation == FilterOperation::Sum)
+							opacity += pixel_opacity;
+						else
+							opacity = Math::Max(opacity, pixel_opacity);
+					}
+				}
+			}
+			destination[y * destination_dimensions.x + x] = byte(Math::Min(255.f, opacity));
+		}
+	}
+}
+
+TEST_CASE("font_effect.convolution_filter")
+{
+	// A glyph-sized source with a filled disc, similar to the alpha of a large glyph.
+	const Vector2i source_dimensions(64, 64);
+	Vector<byte> source(source_dimensions.x * source_dimensions.y);
+	for (int y = 0; y < source_dimensions.y; y++)
+	{
+		for (int x = 0; x < source_dimensions.x; x++)
+		{
+			const float distance = Math::SquareRoot(float((x - 32) * (x - 32) + (y - 32) * (y - 32)));
+			source[y * source_dimensions.x + x] = byte(Math::Clamp(28.f - distance, 0.f, 1.f) * 255.f);
+		}
+	}
+
+	nanobench::Bench bench;
+	bench.title("Convolution filter");
+	bench.minEpochIterations(10);
+	bench.relative(true);
+
+	struct Filter {
+		const char* name;
+		Vector2i radius;
+		FilterOperation operation;
+	};
+	const Filter filters[] = {
+		{"blur x (16px)", Vector2i(16, 0), FilterOperation::Sum},
+		{"blur y (16px)", Vector2i(0, 16), FilterOperation::Sum},
+		{"outline (4px)", Vector2i(4), FilterOperation::Dilation},
+		{"outline (16px)", Vector2i(16), FilterOperation::Dilation},
+	};
+
+	for (const Filter& filter_info : filters)
+	{
+		const Vector2i kernel_size = filter_info.radius * 2 + Vector2i(1);
+		const int radius = Math::Max(filter_info.radius.x, filter_info.radius.y);
+
+		ConvolutionFilter filter;
+		filter.Initialise(filter_info.radius, filter_info.operation);
+		Vector<float> kernel(kernel_size.x * kernel_size.y);
+
+		for (int y = 0; y < kernel_size.y; y++)
+		{
+			for (int x = 0; x < kernel_size.x; x++)
+			{
+				// Set up the kernels similar to the blur and outline font effects.
+				const Vector2i d = Vector2i(x, y) - filter_info.radius;
+				const float distance = Math::SquareRoot(float(d.x * d.x + d.y * d.y));
+				float weight = 0.f;
+				if (filter_info.operation == FilterOperation::Sum)
+					weight = Math::Exp(-distance * distance / (0.32f * float(radius * radius))) / float(radius);
+				else
+					weight = (distance > float(radius) ? Math::Max(float(radius) + 1.f - distance, 0.f) : 1.f);
+
+				filter[y][x] = weight;
+				kernel[y * kernel_size.x + x] = weight;
+			}
+		}
+
+		const Vector2i destination_dimensions = source_dimensions + filter_info.radius * 2;
+		Vector<byte> destination(destination_dimensions.x * destination_dimensions.y);
+		Vector<byte> reference_destination(destination_dimensions.x * destination_dimensions.y);
+
+		bench.run(String("Reference ") + filter_info.name, [&]() {
+			RunReferenceFilter(filter_info.radius, kernel.data(), filter_info.operation, reference_destination.data(), destination_dimensions,
+				source.data(), source_dimensions, filter_info.radius);
+		});
+
+		bench.run(String("ConvolutionFilter ") + filter_info.name, [&]() {
+			filter.Run(destination.data(), destination_dimensions, destination_dimensions.x, ColorFormat::A8, source.data(), source_dimensions,
+				filter_info.radius, ColorFormat::A8);
+		});
+
+		CHECK(destination == reference_destination);
+	}
+}
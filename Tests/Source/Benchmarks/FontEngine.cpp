@@ -0,0 +1,160 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/Geometry.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+TEST_CASE("font_engine")
+{
+	TestsShell::GetContext();
+	FontEngineInterface* font_engine = Rml::GetFontEngineInterface();
+	REQUIRE(font_engine);
+
+	const FontFaceHandle handle = font_engine->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 16);
+	REQUIRE(handle);
+
+	// More distinct words than fit in any cache of shaped strings, with both ASCII and other Latin-1 characters.
+	constexpr int num_words = 4000;
+	const char32_t alphabet[] = U"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZåæéøü";
+	const int alphabet_size = int(sizeof(alphabet) / sizeof(char32_t)) - 1;
+
+	nanobench::Rng rng(42);
+	StringList words(num_words);
+	size_t num_glyphs = 0;
+	for (String& word : words)
+	{
+		const int length = 3 + int(rng.bounded(10));
+		for (int i = 0; i < length; i++)
+			word += StringUtilities::ToUTF8(Character(alphabet[rng.bounded(alphabet_size)]));
+		num_glyphs += size_t(length);
+	}
+
+	nanobench::Bench bench;
+	bench.title("Font engine");
+	bench.unit("glyph");
+	bench.batch(num_glyphs);
+	bench.relative(true);
+
+	// Geometry is appended to, clear it while keeping its buffers between strings.
+	GeometryList geometry;
+	auto GenerateString = [&](const String& word) {
+		for (Geometry& word_geometry : geometry)
+		{
+			word_geometry.GetVertices().clear();
+			word_geometry.GetIndices().clear();
+		}
+		return font_engine->GenerateString(handle, 0, word, Vector2f(0.f), Colourb(255), 1.f, 0.f, geometry);
+	};
+
+	// Generate each word once to load all glyphs before measuring.
+	for (const String& word : words)
+		GenerateString(word);
+
+	int width = 0;
+	bench.run("GetStringWidth (distinct words)", [&] {
+		for (const String& word : words)
+			width += font_engine->GetStringWidth(handle, word, 0.f);
+	});
+
+	bench.run("GenerateString (distinct words)", [&] {
+		for (const String& word : words)
+			width += GenerateString(word);
+	});
+
+	const String& repeated_word = words.front();
+	bench.batch(StringUtilities::LengthUTF8(repeated_word) * num_words);
+	bench.run("GetStringWidth (repeated word)", [&] {
+		for (int i = 0; i < num_words; i++)
+			width += font_engine->GetStringWidth(handle, repeated_word, 0.f);
+	});
+
+	nanobench::doNotOptimizeAway(width);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.fallback")
+{
+	TestsShell::GetContext();
+	FontEngineInterface* font_engine = Rml::GetFontEngineInterface();
+	REQUIRE(font_engine);
+
+	// Eight fallback font faces in total, none of which contain the CJK characters below.
+	for (int i = 0; i < 7; i++)
+	{
+		const char* file_names[] = {"LatoLatin-Regular.ttf", "LatoLatin-Bold.ttf", "LatoLatin-Italic.ttf", "LatoLatin-BoldItalic.ttf"};
+		REQUIRE(Rml::LoadFontFace(String("assets/") + file_names[i % 4], true));
+	}
+
+	const FontFaceHandle handle = font_engine->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 16);
+	REQUIRE(handle);
+
+	// Mixed-script words, where the CJK characters are missing from all fonts and thus rendered with the replacement character.
+	constexpr int num_words = 1000;
+	const char32_t alphabet[] = U"abcdefghijklmnopqrstuvwxyz日本語中文字漢";
+	const int alphabet_size = int(sizeof(alphabet) / sizeof(char32_t)) - 1;
+
+	nanobench::Rng rng(42);
+	StringList words(num_words);
+	size_t num_glyphs = 0;
+	for (String& word : words)
+	{
+		const int length = 3 + int(rng.bounded(10));
+		for (int i = 0; i < length; i++)
+			word += StringUtilities::ToUTF8(Character(alphabet[rng.bounded(alphabet_size)]));
+		num_glyphs += size_t(length);
+	}
+
+	for (const String& word : words)
+		font_engine->GetStringWidth(handle, word, 0.f);
+
+	nanobench::Bench bench;
+	bench.title("Font engine (8 fallback fonts)");
+	bench.unit("glyph");
+	bench.batch(num_glyphs);
+	bench.relative(true);
+
+	int width = 0;
+	bench.run("GetStringWidth (mixed-script words)", [&] {
+		for (const String& word : words)
+			width += font_engine->GetStringWidth(handle, word, 0.f);
+	});
+
+	nanobench::doNotOptimizeAway(width);
+
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,66 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FrameStatsHarness.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/StringUtilities.h>
+#include <doctest.h>
+#include <ostream>
+
+FrameStatsHarness::FrameStatsHarness(ankerl::nanobench::Bench& bench) : bench(bench) {}
+
+FrameStatsHarness::~FrameStatsHarness()
+{
+	std::ostream* output = bench.output();
+	if (!output || rows.empty())
+		return;
+
+	*output << "\n|   draws |  vertices |   indices | compiles | releases | tex binds | tex loads | scissors | transforms | " << bench.title()
+			<< " (render statistics per iteration)\n";
+	*output << "|--------:|----------:|----------:|---------:|---------:|----------:|----------:|---------:|-----------:|:"
+			<< Rml::String(bench.title().size() + 34, '-') << "\n";
+
+	for (const Row& row : rows)
+	{
+		const InstrumentedRenderInterface::FrameStatistics& s = row.statistics;
+		*output << Rml::CreateString(256, "| %7zu | %9zu | %9zu | %8zu | %8zu | %9zu | %9zu | %8zu | %10zu | ", s.draw_calls, s.vertices, s.indices,
+					   s.geometry_compiles, s.geometry_releases, s.texture_binds, s.texture_loads, s.scissor_changes, s.transform_changes)
+				<< row.name << "\n";
+	}
+	*output << std::endl;
+}
+
+void FrameStatsHarness::CollectStatistics(const Rml::String& name, const Rml::Function<void()>& render_frame)
+{
+	InstrumentedRenderInterface* render_interface = TestsShell::GetInstrumentedRenderInterface();
+	REQUIRE(render_interface);
+
+	render_interface->BeginFrame();
+	render_frame();
+	rows.push_back(Row{name, render_interface->GetFrameStatistics()});
+}
@@ -0,0 +1,68 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_TESTS_BENCHMARKS_FRAMESTATSHARNESS_H
+#define RMLUI_TESTS_BENCHMARKS_FRAMESTATSHARNESS_H
+
+#include "../Common/InstrumentedRenderInterface.h"
+#include <RmlUi/Core/Types.h>
+#include <nanobench.h>
+
+/**
+    Benchmark harness for operations which render a frame, reporting the render statistics of each benchmark next to its timings.
+
+    Each operation is run as a regular nanobench benchmark, then once more to collect the statistics of a single iteration from the
+    instrumented render interface. When the harness is destroyed, the statistics are printed to the output of the bench as a table in the
+    same format as the timings, with one row per benchmark.
+ */
+class FrameStatsHarness {
+public:
+	explicit FrameStatsHarness(ankerl::nanobench::Bench& bench);
+	~FrameStatsHarness();
+
+	// Benchmarks the given operation, which should render one or more frames, and collects the render statistics of one iteration.
+	template <typename Op>
+	void Run(const Rml::String& name, Op&& render_frame)
+	{
+		bench.run(name, render_frame);
+		CollectStatistics(name, render_frame);
+	}
+
+private:
+	void CollectStatistics(const Rml::String& name, const Rml::Function<void()>& render_frame);
+
+	struct Row {
+		Rml::String name;
+		InstrumentedRenderInterface::FrameStatistics statistics;
+	};
+
+	ankerl::nanobench::Bench& bench;
+	Rml::Vector<Row> rows;
+};
+
+#endif
@@ -27,6 +27,7 @@
  */
 
 #include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -246,6 +247,7 @@ TEST_CASE("table_basic")
 	nanobench::Bench bench;
 	bench.title("Table basic");
 	bench.relative(true);
+	FrameStatsHarness harness(bench);
 
 	document->SetInnerRML(rml_table_element);
 	context->Update();
@@ -257,7 +259,7 @@ TEST_CASE("table_basic")
 
 	bench.run("Update (unmodified)", [&] { context->Update(); });
 
-	bench.run("Render", [&] { context->Render(); });
+	harness.Run("Render", [&] { context->Render(); });
 
 	bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_table_element); });
 
@@ -266,7 +268,7 @@ TEST_CASE("table_basic")
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	harness.Run("SetInnerRML + Update + Render", [&] {
 		document->SetInnerRML(rml_table_element);
 		context->Update();
 		context->Render();
@@ -287,6 +289,7 @@ TEST_CASE("table_inline-block")
 	nanobench::Bench bench;
 	bench.title("Table inline-block");
 	bench.relative(true);
+	FrameStatsHarness harness(bench);
 
 	document->SetInnerRML(rml_inline_block_element);
 	context->Update();
@@ -298,7 +301,7 @@ TEST_CASE("table_inline-block")
 
 	bench.run("Update (unmodified)", [&] { context->Update(); });
 
-	bench.run("Render", [&] { context->Render(); });
+	harness.Run("Render", [&] { context->Render(); });
 
 	bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_inline_block_element); });
 
@@ -307,7 +310,7 @@ TEST_CASE("table_inline-block")
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	harness.Run("SetInnerRML + Update + Render", [&] {
 		document->SetInnerRML(rml_inline_block_element);
 		context->Update();
 		context->Render();
@@ -0,0 +1,159 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../../Source/Core/TextureLayout.h"
+#include "../../../Source/Core/TextureLayoutSkyline.h"
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+// Places rectangles left to right on shelves below each other, as previously done for glyphs appended to font textures.
+struct TextureLayoutShelf {
+	TextureLayoutShelf(Vector2i dimensions) : dimensions(dimensions) {}
+
+	bool Allocate(Vector2i rectangle_dimensions, Vector2i& out_position)
+	{
+		const Vector2i padded_dimensions = rectangle_dimensions + Vector2i(1);
+		if (shelf_x + padded_dimensions.x > dimensions.x)
+		{
+			shelf_x = 1;
+			shelf_y += shelf_height;
+			shelf_height = 0;
+		}
+		if (shelf_x + padded_dimensions.x > dimensions.x || shelf_y + padded_dimensions.y > dimensions.y)
+			return false;
+
+		out_position = Vector2i(shelf_x, shelf_y);
+		shelf_x += padded_dimensions.x;
+		shelf_height = Math::Max(shelf_height, padded_dimensions.y);
+		return true;
+	}
+
+	Vector2i dimensions;
+	int shelf_x = 1, shelf_y = 1, shelf_height = 0;
+};
+
+TEST_CASE("texture_layout")
+{
+	// Glyph boxes resembling a large CJK font at 24px, along with some narrower Latin glyphs.
+	Vector<Vector2i> rectangle_dimensions;
+	nanobench::Rng rng(42);
+	for (int i = 0; i < 4000; i++)
+		rectangle_dimensions.push_back(Vector2i(14 + int(rng.bounded(11)), 4 + int(rng.bounded(21))));
+	for (int i = 0; i < 200; i++)
+		rectangle_dimensions.push_back(Vector2i(3 + int(rng.bounded(12)), 8 + int(rng.bounded(14))));
+
+	int rectangle_area = 0;
+	for (Vector2i dimensions : rectangle_dimensions)
+		rectangle_area += (dimensions.x + 1) * (dimensions.y + 1);
+
+	constexpr int max_texture_dimensions = 1024;
+
+	auto generate_layout = [&](TextureLayout& layout, TextureLayoutPacking packing) {
+		for (int i = 0; i < (int)rectangle_dimensions.size(); i++)
+			layout.AddRectangle(i, rectangle_dimensions[i]);
+		return layout.GenerateLayout(max_texture_dimensions, packing);
+	};
+
+	// Report the number of textures and how much of them is covered by rectangles, including their padding.
+	auto report_layout = [&](const String& name, TextureLayoutPacking packing) {
+		TextureLayout layout;
+		REQUIRE(generate_layout(layout, packing));
+
+		int texture_area = 0;
+		for (int i = 0; i < layout.GetNumTextures(); i++)
+			texture_area += layout.GetTexture(i).GetDimensions().x * layout.GetTexture(i).GetDimensions().y;
+
+		// The first texture is filled before moving on to the next, so its contents show how tightly the rectangles are packed.
+		int first_texture_area = 0;
+		for (int i = 0; i < layout.GetNumRectangles(); i++)
+		{
+			TextureLayoutRectangle& rectangle = layout.GetRectangle(i);
+			if (rectangle.GetTextureIndex() == 0)
+				first_texture_area += (rectangle.GetDimensions().x + 1) * (rectangle.GetDimensions().y + 1);
+		}
+		const Vector2i first_texture_dimensions = layout.GetTexture(0).GetDimensions();
+
+		const String msg = CreateString(256, "%s: %d textures, %.1f%% occupancy overall, %.1f%% occupancy of the first texture", name.c_str(),
+			layout.GetNumTextures(), 100.0 * double(rectangle_area) / double(texture_area),
+			100.0 * double(first_texture_area) / double(first_texture_dimensions.x * first_texture_dimensions.y));
+		MESSAGE(msg);
+	};
+
+	report_layout("Rows", TextureLayoutPacking::Rows);
+	report_layout("Skyline", TextureLayoutPacking::Skyline);
+
+	nanobench::Bench bench;
+	bench.title("Texture layout");
+	bench.unit("rectangle");
+	bench.batch(rectangle_dimensions.size());
+	bench.relative(true);
+
+	bench.run("Rows", [&] {
+		TextureLayout layout;
+		generate_layout(layout, TextureLayoutPacking::Rows);
+	});
+
+	bench.run("Skyline", [&] {
+		TextureLayout layout;
+		generate_layout(layout, TextureLayoutPacking::Skyline);
+	});
+
+	// Insert the rectangles one at a time in their original order, like glyphs appended to existing font textures, starting a new
+	// texture whenever a rectangle doesn't fit on the current one.
+	constexpr int appended_texture_dimensions = 256;
+
+	auto append_rectangles = [&](auto allocator) {
+		int num_textures = 1;
+		Vector2i position;
+		for (Vector2i dimensions : rectangle_dimensions)
+		{
+			if (!allocator.Allocate(dimensions, position))
+			{
+				allocator = decltype(allocator)(Vector2i(appended_texture_dimensions));
+				allocator.Allocate(dimensions, position);
+				num_textures += 1;
+			}
+		}
+		return num_textures;
+	};
+
+	const int num_shelf_textures = append_rectangles(TextureLayoutShelf(Vector2i(appended_texture_dimensions)));
+	const int num_skyline_textures = append_rectangles(TextureLayoutSkyline(Vector2i(appended_texture_dimensions)));
+	const String msg = CreateString(128, "Appended: %d textures with shelves, %d textures with skyline", num_shelf_textures, num_skyline_textures);
+	MESSAGE(msg);
+
+	bench.title("Texture layout (appended)");
+
+	bench.run("Shelves", [&] { bench.doNotOptimizeAway(append_rectangles(TextureLayoutShelf(Vector2i(appended_texture_dimensions)))); });
+	bench.run("Skyline", [&] { bench.doNotOptimizeAway(append_rectangles(TextureLayoutSkyline(Vector2i(appended_texture_dimensions)))); });
+}
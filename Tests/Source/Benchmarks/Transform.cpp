@@ -0,0 +1,161 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsShell.h"
+#include "FrameStatsHarness.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static const String rml_transform_document = R"(
+<rml>
+<head>
+    <link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		#carousel {
+			position: absolute;
+			top: 100px;
+			left: 300px;
+			width: 200px;
+			height: 300px;
+			perspective: 800px;
+		}
+		.card {
+			position: absolute;
+			width: 200px;
+			height: 300px;
+			background: #c3c3c3;
+			border: 2px #55f;
+		}
+		.card div {
+			margin: 10px;
+			height: 50px;
+			background: #afa;
+		}
+	</style>
+</head>
+<body>
+<div id="carousel"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("transform")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml_transform_document);
+	REQUIRE(document);
+	document->Show();
+
+	// A carousel of transformed cards, each with a few plain descendants inheriting the card's transform.
+	constexpr int num_cards = 50;
+	Element* carousel = document->GetElementById("carousel");
+	String cards_rml;
+	for (int i = 0; i < num_cards; i++)
+		cards_rml += "<div class='card'><div/><div/><div/><div/></div>";
+	carousel->SetInnerRML(cards_rml);
+
+	ElementList cards;
+	document->GetElementsByClassName(cards, "card");
+	REQUIRE(cards.size() == num_cards);
+
+	TestsShell::RenderLoop();
+
+	nanobench::Bench bench;
+	bench.title("Transform");
+	bench.relative(true);
+	bench.minEpochIterations(100);
+	bench.warmup(10);
+	FrameStatsHarness harness(bench);
+
+	harness.Run("Reference (update + render)", [&] {
+		context->Update();
+		context->Render();
+	});
+
+	int frame = 0;
+	harness.Run("Rotate carousel", [&] {
+		frame += 1;
+		for (int i = 0; i < num_cards; i++)
+		{
+			const float angle = float(frame + i * 360 / num_cards);
+			cards[i]->SetProperty("transform", CreateString(64, "rotateY(%gdeg) translateZ(400px) rotateX(10deg)", angle));
+		}
+		context->Update();
+		context->Render();
+	});
+
+	int mouse_x = 0;
+	bench.run("Hit test", [&] {
+		// Every element under a transformed ancestor is projected into its own space to test whether it is hovered.
+		mouse_x = (mouse_x + 7) % 800;
+		context->ProcessMouseMove(mouse_x, 250, 0);
+	});
+
+	document->Close();
+}
+
+TEST_CASE("transform.matrix4")
+{
+	nanobench::Bench bench;
+	bench.title("Matrix4f");
+	bench.relative(true);
+	bench.minEpochIterations(100000);
+
+	const Matrix4f a = Matrix4f::Translate(400.f, 300.f, 0.f) * Matrix4f::Perspective(500.f) * Matrix4f::RotateY(0.6f);
+	const Matrix4f b = Matrix4f::RotateZ(-0.3f) * Matrix4f::Scale(1.5f, 0.5f, 1.f) * Matrix4f::Translate(-50.f, -20.f, 0.f);
+	Matrix4f result = a;
+	Vector4f point(120.f, 75.f, 0.f, 1.f);
+
+	bench.run("Multiply", [&] {
+		result = a * result;
+		nanobench::doNotOptimizeAway(result);
+		result = b;
+	});
+
+	bench.run("Transform vector", [&] {
+		point = a * point;
+		nanobench::doNotOptimizeAway(point);
+		point = Vector4f(120.f, 75.f, 0.f, 1.f);
+	});
+
+	bench.run("Invert", [&] {
+		result = a;
+		nanobench::doNotOptimizeAway(result.Invert());
+		nanobench::doNotOptimizeAway(result);
+	});
+}
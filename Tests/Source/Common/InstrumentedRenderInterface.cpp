@@ -0,0 +1,231 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "InstrumentedRenderInterface.h"
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/StringUtilities.h>
+
+InstrumentedRenderInterface::InstrumentedRenderInterface(Rml::RenderInterface* render_interface) : render_interface(render_interface) {}
+
+void InstrumentedRenderInterface::SetRenderInterface(Rml::RenderInterface* in_render_interface)
+{
+	render_interface = in_render_interface;
+	compiled_geometry.clear();
+	bound_texture = 0;
+	scissor_enabled = false;
+}
+
+void InstrumentedRenderInterface::BeginFrame()
+{
+	statistics = {};
+	bound_texture = 0;
+}
+
+Rml::String InstrumentedRenderInterface::ToString(const FrameStatistics& statistics)
+{
+	return Rml::CreateString(512,
+		"Frame statistics:\n"
+		"  Draw calls: %zu (%zu immediate, %zu compiled)\n"
+		"  Vertices: %zu\n"
+		"  Indices: %zu\n"
+		"  Geometry compiles: %zu (%zu batches)\n"
+		"  Geometry releases: %zu\n"
+		"  Texture binds: %zu\n"
+		"  Texture loads: %zu\n"
+		"  Texture releases: %zu\n"
+		"  Scissor changes: %zu\n"
+		"  Transform changes: %zu",
+		statistics.draw_calls, statistics.immediate_draws, statistics.compiled_draws, statistics.vertices, statistics.indices,
+		statistics.geometry_compiles, statistics.geometry_batches, statistics.geometry_releases, statistics.texture_binds,
+		statistics.texture_loads, statistics.texture_releases, statistics.scissor_changes, statistics.transform_changes);
+}
+
+void InstrumentedRenderInterface::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture,
+	const Rml::Vector2f& translation)
+{
+	RecordDraw(texture);
+	statistics.immediate_draws += 1;
+	statistics.vertices += num_vertices;
+	statistics.indices += num_indices;
+
+	render_interface->RenderGeometry(vertices, num_vertices, indices, num_indices, texture, translation);
+}
+
+Rml::CompiledGeometryHandle InstrumentedRenderInterface::CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+	Rml::TextureHandle texture)
+{
+	const Rml::CompiledGeometryHandle handle = render_interface->CompileGeometry(vertices, num_vertices, indices, num_indices, texture);
+	if (handle)
+	{
+		statistics.geometry_compiles += 1;
+		compiled_geometry[handle] = CompiledGeometry{num_vertices, num_indices, texture};
+	}
+	return handle;
+}
+
+void InstrumentedRenderInterface::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation)
+{
+	auto it = compiled_geometry.find(geometry);
+	RMLUI_ASSERT(it != compiled_geometry.end());
+	if (it != compiled_geometry.end())
+	{
+		RecordDraw(it->second.texture);
+		statistics.compiled_draws += 1;
+		statistics.vertices += it->second.num_vertices;
+		statistics.indices += it->second.num_indices;
+	}
+
+	render_interface->RenderCompiledGeometry(geometry, translation);
+}
+
+void InstrumentedRenderInterface::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry)
+{
+	statistics.geometry_releases += 1;
+	compiled_geometry.erase(geometry);
+
+	render_interface->ReleaseCompiledGeometry(geometry);
+}
+
+void InstrumentedRenderInterface::CompileGeometryBatch(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+	const Rml::GeometryBatchEntry* geometries, int num_geometries, Rml::CompiledGeometryHandle* compiled_geometries)
+{
+	// Forward the whole batch, so that the wrapped render interface can use its own batching or the per-geometry fallback.
+	render_interface->CompileGeometryBatch(vertices, num_vertices, indices, num_indices, geometries, num_geometries, compiled_geometries);
+	statistics.geometry_batches += 1;
+
+	for (int i = 0; i < num_geometries; i++)
+	{
+		if (const Rml::CompiledGeometryHandle handle = compiled_geometries[i])
+		{
+			statistics.geometry_compiles += 1;
+			compiled_geometry[handle] = CompiledGeometry{geometries[i].num_vertices, geometries[i].num_indices, geometries[i].texture};
+		}
+	}
+}
+
+Rml::CompiledGeometryHandle InstrumentedRenderInterface::CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices)
+{
+	const Rml::CompiledGeometryHandle handle = render_interface->CompileGeometryChunk(vertices, num_vertices, indices, num_indices);
+	if (handle)
+	{
+		statistics.geometry_compiles += 1;
+		compiled_geometry[handle] = CompiledGeometry{num_vertices, num_indices, 0};
+	}
+	return handle;
+}
+
+void InstrumentedRenderInterface::RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices,
+	Rml::TextureHandle texture, const Rml::Vector2f& translation)
+{
+	RecordDraw(texture);
+	statistics.compiled_draws += 1;
+	statistics.indices += num_indices;
+
+	render_interface->RenderCompiledGeometryChunk(chunk, first_index, num_indices, texture, translation);
+}
+
+void InstrumentedRenderInterface::EnableScissorRegion(bool enable)
+{
+	if (enable != scissor_enabled)
+	{
+		scissor_enabled = enable;
+		statistics.scissor_changes += 1;
+	}
+
+	render_interface->EnableScissorRegion(enable);
+}
+
+void InstrumentedRenderInterface::SetScissorRegion(int x, int y, int width, int height)
+{
+	statistics.scissor_changes += 1;
+	render_interface->SetScissorRegion(x, y, width, height);
+}
+
+bool InstrumentedRenderInterface::LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	statistics.texture_loads += 1;
+	return render_interface->LoadTexture(texture_handle, texture_dimensions, source);
+}
+
+bool InstrumentedRenderInterface::LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	return render_interface->LoadTextureData(texture_data, texture_dimensions, source);
+}
+
+bool InstrumentedRenderInterface::GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions)
+{
+	statistics.texture_loads += 1;
+	return render_interface->GenerateTexture(texture_handle, source, source_dimensions);
+}
+
+bool InstrumentedRenderInterface::SupportsDistanceFieldTextures()
+{
+	return render_interface->SupportsDistanceFieldTextures();
+}
+
+bool InstrumentedRenderInterface::GenerateDistanceFieldTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source,
+	const Rml::Vector2i& source_dimensions)
+{
+	statistics.texture_loads += 1;
+	return render_interface->GenerateDistanceFieldTexture(texture_handle, source, source_dimensions);
+}
+
+void InstrumentedRenderInterface::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	statistics.texture_releases += 1;
+	if (texture_handle == bound_texture)
+		bound_texture = 0;
+
+	render_interface->ReleaseTexture(texture_handle);
+}
+
+void InstrumentedRenderInterface::SetTransform(const Rml::Matrix4f* transform)
+{
+	statistics.transform_changes += 1;
+	render_interface->SetTransform(transform);
+}
+
+bool InstrumentedRenderInterface::SupportsColourModulation()
+{
+	return render_interface->SupportsColourModulation();
+}
+
+void InstrumentedRenderInterface::SetColourModulation(const Rml::Colourb& colour)
+{
+	render_interface->SetColourModulation(colour);
+}
+
+void InstrumentedRenderInterface::RecordDraw(Rml::TextureHandle texture)
+{
+	statistics.draw_calls += 1;
+	if (texture != bound_texture)
+	{
+		bound_texture = texture;
+		statistics.texture_binds += 1;
+	}
+}
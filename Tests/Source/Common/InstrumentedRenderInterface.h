@@ -0,0 +1,125 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_TESTS_COMMON_INSTRUMENTEDRENDERINTERFACE_H
+#define RMLUI_TESTS_COMMON_INSTRUMENTEDRENDERINTERFACE_H
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/Types.h>
+
+/**
+    Render interface wrapper which forwards all calls to another render interface, while collecting per-frame statistics.
+
+    Can be placed around the dummy tests renderer or any backend renderer. Call BeginFrame() before rendering the context to start
+    collecting statistics for a new frame.
+ */
+class InstrumentedRenderInterface : public Rml::RenderInterface {
+public:
+	struct FrameStatistics {
+		size_t draw_calls;
+		size_t immediate_draws;
+		size_t compiled_draws;
+		// Vertices of immediate and compiled geometry drawn. Ranges of geometry chunks only contribute to their indices.
+		size_t vertices;
+		size_t indices;
+		size_t geometry_compiles;
+		// Number of calls compiling several geometries at once, their geometries also count as separate compiles.
+		size_t geometry_batches;
+		size_t geometry_releases;
+		// Number of draws using a different texture than the previous draw.
+		size_t texture_binds;
+		// Number of textures loaded from file or generated from memory.
+		size_t texture_loads;
+		size_t texture_releases;
+		size_t scissor_changes;
+		size_t transform_changes;
+	};
+
+	explicit InstrumentedRenderInterface(Rml::RenderInterface* render_interface = nullptr);
+
+	// Sets the render interface to forward calls to, must be set before use.
+	void SetRenderInterface(Rml::RenderInterface* render_interface);
+	Rml::RenderInterface* GetRenderInterface() const { return render_interface; }
+
+	// Resets the statistics and render state tracking at the start of a new frame.
+	void BeginFrame();
+
+	// Returns the statistics collected since the frame began.
+	const FrameStatistics& GetFrameStatistics() const { return statistics; }
+
+	static Rml::String ToString(const FrameStatistics& statistics);
+
+	// -- Inherited from Rml::RenderInterface --
+
+	void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture,
+		const Rml::Vector2f& translation) override;
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+		Rml::TextureHandle texture) override;
+	void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override;
+	void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override;
+	void CompileGeometryBatch(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, const Rml::GeometryBatchEntry* geometries,
+		int num_geometries, Rml::CompiledGeometryHandle* compiled_geometries) override;
+
+	Rml::CompiledGeometryHandle CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices) override;
+	void RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices, Rml::TextureHandle texture,
+		const Rml::Vector2f& translation) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(int x, int y, int width, int height) override;
+
+	bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
+	bool SupportsDistanceFieldTextures() override;
+	bool GenerateDistanceFieldTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	bool SupportsColourModulation() override;
+	void SetColourModulation(const Rml::Colourb& colour) override;
+
+private:
+	struct CompiledGeometry {
+		int num_vertices;
+		int num_indices;
+		Rml::TextureHandle texture;
+	};
+
+	void RecordDraw(Rml::TextureHandle texture);
+
+	Rml::RenderInterface* render_interface = nullptr;
+	FrameStatistics statistics = {};
+
+	Rml::UnorderedMap<Rml::CompiledGeometryHandle, CompiledGeometry> compiled_geometry;
+	Rml::TextureHandle bound_texture = 0;
+	bool scissor_enabled = false;
+};
+
+#endif
@@ -89,6 +89,47 @@ void TestsRenderInterface::RenderGeometry(Rml::Vertex* /*vertices*/, int /*num_v
 	counters.render_calls += 1;
 }
 
+Rml::CompiledGeometryHandle TestsRenderInterface::CompileGeometry(Rml::Vertex* /*vertices*/, int /*num_vertices*/, int* /*indices*/,
+	int /*num_indices*/, Rml::TextureHandle /*texture*/)
+{
+	counters.compile_geometry += 1;
+	return Rml::CompiledGeometryHandle(counters.compile_geometry);
+}
+
+void TestsRenderInterface::RenderCompiledGeometry(Rml::CompiledGeometryHandle /*geometry*/, const Rml::Vector2f& /*translation*/)
+{
+	counters.render_calls += 1;
+}
+
+void TestsRenderInterface::CompileGeometryBatch(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+	const Rml::GeometryBatchEntry* geometries, int num_geometries, Rml::CompiledGeometryHandle* compiled_geometries)
+{
+	counters.compile_geometry_batch += 1;
+	Rml::RenderInterface::CompileGeometryBatch(vertices, num_vertices, indices, num_indices, geometries, num_geometries, compiled_geometries);
+}
+
+Rml::CompiledGeometryHandle TestsRenderInterface::CompileGeometryChunk(Rml::Vertex* /*vertices*/, int /*num_vertices*/, int* /*indices*/,
+	int /*num_indices*/)
+{
+	if (!geometry_chunks_supported)
+		return 0;
+
+	counters.compile_geometry += 1;
+	return Rml::CompiledGeometryHandle(counters.compile_geometry);
+}
+
+void TestsRenderInterface::RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle /*chunk*/, int /*first_index*/, int /*num_indices*/,
+	Rml::TextureHandle /*texture*/, const Rml::Vector2f& /*translation*/)
+{
+	counters.render_calls += 1;
+	counters.render_chunk_calls += 1;
+}
+
+void TestsRenderInterface::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle /*geometry*/)
+{
+	counters.release_geometry += 1;
+}
+
 void TestsRenderInterface::EnableScissorRegion(bool /*enable*/)
 {
 	counters.enable_scissor += 1;
@@ -108,6 +149,17 @@ bool TestsRenderInterface::LoadTexture(Rml::TextureHandle& texture_handle, Rml::
 	return true;
 }
 
+bool TestsRenderInterface::LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& /*source*/)
+{
+	if (!texture_data_supported)
+		return false;
+
+	counters.load_texture_data += 1;
+	texture_dimensions = Rml::Vector2i(16, 16);
+	texture_data.assign(size_t(texture_dimensions.x * texture_dimensions.y * 4), Rml::byte(255));
+	return true;
+}
+
 bool TestsRenderInterface::GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* /*source*/,
 	const Rml::Vector2i& /*source_dimensions*/)
 {
@@ -116,6 +168,19 @@ bool TestsRenderInterface::GenerateTexture(Rml::TextureHandle& texture_handle, c
 	return true;
 }
 
+bool TestsRenderInterface::SupportsDistanceFieldTextures()
+{
+	return distance_field_textures_supported;
+}
+
+bool TestsRenderInterface::GenerateDistanceFieldTexture(Rml::TextureHandle& texture_handle, const Rml::byte* /*source*/,
+	const Rml::Vector2i& /*source_dimensions*/)
+{
+	counters.generate_distance_field_texture += 1;
+	texture_handle = 1;
+	return true;
+}
+
 void TestsRenderInterface::ReleaseTexture(Rml::TextureHandle /*texture_handle*/)
 {
 	counters.release_texture += 1;
@@ -125,3 +190,13 @@ void TestsRenderInterface::SetTransform(const Rml::Matrix4f* /*transform*/)
 {
 	counters.set_transform += 1;
 }
+
+bool TestsRenderInterface::SupportsColourModulation()
+{
+	return colour_modulation_supported;
+}
+
+void TestsRenderInterface::SetColourModulation(const Rml::Colourb& /*colour*/)
+{
+	counters.set_colour_modulation += 1;
+}
@@ -58,32 +58,69 @@ class TestsRenderInterface : public Rml::RenderInterface {
 public:
 	struct Counters {
 		size_t render_calls;
+		size_t render_chunk_calls;
+		size_t compile_geometry;
+		size_t compile_geometry_batch;
+		size_t release_geometry;
 		size_t enable_scissor;
 		size_t set_scissor;
 		size_t load_texture;
+		size_t load_texture_data;
 		size_t generate_texture;
+		size_t generate_distance_field_texture;
 		size_t release_texture;
 		size_t set_transform;
+		size_t set_colour_modulation;
 	};
 
 	void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture,
 		const Rml::Vector2f& translation) override;
 
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
+		Rml::TextureHandle texture) override;
+	void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override;
+	void CompileGeometryBatch(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, const Rml::GeometryBatchEntry* geometries,
+		int num_geometries, Rml::CompiledGeometryHandle* compiled_geometries) override;
+
+	Rml::CompiledGeometryHandle CompileGeometryChunk(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices) override;
+	void RenderCompiledGeometryChunk(Rml::CompiledGeometryHandle chunk, int first_index, int num_indices, Rml::TextureHandle texture,
+		const Rml::Vector2f& translation) override;
+	void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override;
+
 	void EnableScissorRegion(bool enable) override;
 	void SetScissorRegion(int x, int y, int width, int height) override;
 
 	bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& texture_data, Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
 	bool GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
+	bool SupportsDistanceFieldTextures() override;
+	bool GenerateDistanceFieldTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
 
 	void SetTransform(const Rml::Matrix4f* transform) override;
 
+	bool SupportsColourModulation() override;
+	void SetColourModulation(const Rml::Colourb& colour) override;
+
 	const Counters& GetCounters() const { return counters; }
 
 	void ResetCounters() { counters = {}; }
 
+	// Toggles support for colour modulation, to test the fallback where it is applied to the vertex colours instead.
+	void SetColourModulationSupported(bool supported) { colour_modulation_supported = supported; }
+	// Toggles support for geometry chunks, to test compiling geometry outside the geometry arena.
+	void SetGeometryChunksSupported(bool supported) { geometry_chunks_supported = supported; }
+	// Toggles support for distance field textures, to test rendering the glyphs of all font sizes from a shared atlas.
+	void SetDistanceFieldTexturesSupported(bool supported) { distance_field_textures_supported = supported; }
+	// Toggles support for loading texture data, to test placing images in the texture atlas.
+	void SetTextureDataSupported(bool supported) { texture_data_supported = supported; }
+
 private:
 	Counters counters = {};
+	bool colour_modulation_supported = true;
+	bool geometry_chunks_supported = true;
+	bool distance_field_textures_supported = false;
+	bool texture_data_supported = false;
 };
 
 #endif
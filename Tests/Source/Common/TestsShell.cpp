@@ -27,6 +27,8 @@
  */
 
 #include "TestsShell.h"
+#include "../../../Source/Core/GeometryDatabase.h"
+#include "InstrumentedRenderInterface.h"
 #include "TestsInterface.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
@@ -50,6 +52,9 @@ Rml::Context* shell_context = nullptr;
 
 TestsSystemInterface tests_system_interface;
 
+// Collects render statistics while forwarding to either the shell's or the tests render interface.
+InstrumentedRenderInterface instrumented_render_interface;
+
 #ifdef RMLUI_TESTS_USE_SHELL
 class TestsShellEventListener : public Rml::EventListener {
 public:
@@ -87,7 +92,8 @@ static void InitializeShell(bool allow_debugger)
 		// Use our custom tests system interface.
 		Rml::SetSystemInterface(&tests_system_interface);
 		// However, use the backend's render interface.
-		Rml::SetRenderInterface(Backend::GetRenderInterface());
+		instrumented_render_interface.SetRenderInterface(Backend::GetRenderInterface());
+		Rml::SetRenderInterface(&instrumented_render_interface);
 
 		REQUIRE(Rml::Initialise());
 		shell_context = Rml::CreateContext("main", window_size);
@@ -104,7 +110,8 @@ static void InitializeShell(bool allow_debugger)
 #else
 		// Set our custom system and render interfaces.
 		Rml::SetSystemInterface(&tests_system_interface);
-		Rml::SetRenderInterface(&shell_render_interface);
+		instrumented_render_interface.SetRenderInterface(&shell_render_interface);
+		Rml::SetRenderInterface(&instrumented_render_interface);
 
 		REQUIRE(Rml::Initialise());
 		shell_context = Rml::CreateContext("main", window_size);
@@ -121,6 +128,7 @@ Rml::Context* TestsShell::GetContext(bool allow_debugger)
 
 void TestsShell::BeginFrame()
 {
+	instrumented_render_interface.BeginFrame();
 #ifdef RMLUI_TESTS_USE_SHELL
 	Backend::BeginFrame();
 #endif
@@ -191,26 +199,46 @@ Rml::String TestsShell::GetRenderStats()
 
 	shell_context->Update();
 	shell_render_interface.ResetCounters();
+	instrumented_render_interface.BeginFrame();
 	shell_context->Render();
 	auto& counters = shell_render_interface.GetCounters();
 
-	result = Rml::CreateString(256,
+	result = Rml::CreateString(512,
 		"Context::Render() stats:\n"
 		"  Render calls: %zu\n"
+		"  Geometry compile: %zu\n"
+		"  Geometry release: %zu\n"
 		"  Scissor enable: %zu\n"
 		"  Scissor set: %zu\n"
 		"  Texture load: %zu\n"
 		"  Texture generate: %zu\n"
 		"  Texture release: %zu\n"
-		"  Transform set: %zu",
-		counters.render_calls, counters.enable_scissor, counters.set_scissor, counters.load_texture, counters.generate_texture,
-		counters.release_texture, counters.set_transform);
+		"  Transform set: %zu\n"
+		"  Colour modulation set: %zu",
+		counters.render_calls, counters.compile_geometry, counters.release_geometry, counters.enable_scissor, counters.set_scissor,
+		counters.load_texture, counters.generate_texture, counters.release_texture, counters.set_transform, counters.set_colour_modulation);
+
+	const auto arena = Rml::GeometryDatabase::GetArenaStatistics();
+	result += Rml::CreateString(256, "\nGeometry arena: %d chunks, %d allocations shared by %d geometries, %zu KiB reserved, %zu KiB used",
+		arena.num_chunks, arena.num_allocations, arena.num_references, arena.reserved_bytes / 1024, arena.used_bytes / 1024);
+
+	result += '\n' + InstrumentedRenderInterface::ToString(instrumented_render_interface.GetFrameStatistics());
 
 #endif
 
 	return result;
 }
 
+Rml::String TestsShell::GetFrameStats(const Rml::Function<void()>& render_frame)
+{
+	REQUIRE(shell_context);
+
+	instrumented_render_interface.BeginFrame();
+	render_frame();
+
+	return InstrumentedRenderInterface::ToString(instrumented_render_interface.GetFrameStatistics());
+}
+
 TestsRenderInterface* TestsShell::GetTestsRenderInterface()
 {
 #if defined(RMLUI_TESTS_USE_SHELL)
@@ -224,3 +252,8 @@ TestsSystemInterface* TestsShell::GetTestsSystemInterface()
 {
 	return &tests_system_interface;
 }
+
+InstrumentedRenderInterface* TestsShell::GetInstrumentedRenderInterface()
+{
+	return &instrumented_render_interface;
+}
@@ -35,6 +35,7 @@ class RenderInterface;
 }
 class TestsRenderInterface;
 class TestsSystemInterface;
+class InstrumentedRenderInterface;
 
 namespace TestsShell {
 
@@ -60,9 +61,15 @@ void SetTime(double t);
 // Stats only available for the dummy renderer.
 Rml::String GetRenderStats();
 
+// Returns the render statistics collected while calling the given function, which should update and render a single frame.
+// Available for both the dummy renderer and the shell backend.
+Rml::String GetFrameStats(const Rml::Function<void()>& render_frame);
+
 // Returns nullptr if the dummy renderer is not being used.
 TestsRenderInterface* GetTestsRenderInterface();
 TestsSystemInterface* GetTestsSystemInterface();
+// Returns the render interface wrapper collecting statistics, placed around the renderer in use.
+InstrumentedRenderInterface* GetInstrumentedRenderInterface();
 
 } // namespace TestsShell
 
@@ -26,8 +26,10 @@
  *
  */
 
+#include "../../../Source/Core/TransformState.h"
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -225,3 +227,94 @@ TEST_CASE("animation.decorator")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String document_compositing_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		@keyframes fade-spin {
+			from { opacity: 1; transform: rotate(0deg); }
+			to   { opacity: 0; transform: rotate(90deg); }
+		}
+		#icon {
+			position: absolute;
+			left: 0;
+			top: 0;
+			width: 100px;
+			height: 100px;
+			transform: rotate(0deg);
+			animation: 1s fade-spin;
+		}
+		#opaque {
+			opacity: 1;
+		}
+	</style>
+</head>
+
+<body>
+<div id="icon"><div id="inherit"><div id="nested"/></div><div id="opaque"/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("animation.compositing_properties")
+{
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+
+	system_interface->SetTime(0.0);
+	ElementDocument* document = context->LoadDocumentFromMemory(document_compositing_rml, "assets/");
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* icon = document->GetElementById("icon");
+	Element* inherit = document->GetElementById("inherit");
+	Element* nested = document->GetElementById("nested");
+	Element* opaque = document->GetElementById("opaque");
+
+	// Opacity and transform animations are applied directly to the computed values and transform state, make sure they match the regular
+	// property handling. Animations advance by at most 0.1 seconds per update.
+	for (int i = 1; i < 10; i++)
+	{
+		const double t = 0.1 * i;
+		system_interface->SetTime(t);
+		TestsShell::RenderLoop();
+
+		const float expected_opacity = float(1.0 - t);
+		CHECK(icon->GetComputedValues().opacity() == doctest::Approx(expected_opacity));
+		CHECK(inherit->GetComputedValues().opacity() == doctest::Approx(expected_opacity));
+		CHECK(nested->GetComputedValues().opacity() == doctest::Approx(expected_opacity));
+		CHECK(opaque->GetComputedValues().opacity() == 1.f);
+
+		const TransformState* transform_state = icon->GetTransformState();
+		REQUIRE(transform_state);
+		REQUIRE(transform_state->GetTransform());
+		const Matrix4f expected_transform = Matrix4f::Translate(50.f, 50.f, 0.f) * Matrix4f::RotateZ(float(t) * 0.5f * Math::RMLUI_PI) *
+			Matrix4f::Translate(-50.f, -50.f, 0.f);
+		const Vector4f point(100.f, 0.f, 0.f, 1.f);
+		const Vector4f result = *transform_state->GetTransform() * point;
+		const Vector4f expected = expected_transform * point;
+		CHECK(result.x == doctest::Approx(expected.x));
+		CHECK(result.y == doctest::Approx(expected.y));
+
+		// Descendants inherit the animated transform.
+		REQUIRE(nested->GetTransformState());
+		CHECK(*nested->GetTransformState()->GetTransform() == *transform_state->GetTransform());
+	}
+
+	// Once completed, the animated values are removed and the style sheet values apply again.
+	system_interface->SetTime(1.0);
+	TestsShell::RenderLoop();
+	system_interface->SetTime(1.1);
+	TestsShell::RenderLoop();
+	CHECK(icon->GetComputedValues().opacity() == 1.f);
+	CHECK(nested->GetComputedValues().opacity() == 1.f);
+	CHECK(icon->GetProperty<String>("transform") == "rotate(0deg)");
+
+	document->Close();
+	system_interface->SetTime(0.0);
+
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,161 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <RmlUi/Core/ConvolutionFilter.h>
+#include <RmlUi/Core/Math.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+namespace {
+
+// Straightforward implementation visiting every kernel position for each pixel, the filter should produce identical results.
+void RunReference(const Vector2i kernel_radius, const Vector<float>& kernel, FilterOperation operation, byte* destination,
+	Vector2i destination_dimensions, int destination_stride, int destination_bytes_per_pixel, const byte* source, Vector2i source_dimensions,
+	Vector2i source_offset, int source_bytes_per_pixel)
+{
+	const Vector2i kernel_size = kernel_radius * 2 + Vector2i(1);
+	const int destination_alpha_offset = destination_bytes_per_pixel - 1;
+	const int source_alpha_offset = source_bytes_per_pixel - 1;
+
+	for (int y = 0; y < destination_dimensions.y; ++y)
+	{
+		for (int x = 0; x < destination_dimensions.x; ++x)
+		{
+			float opacity = 0.f;
+			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			{
+				const int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
+				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+				{
+					const int source_x = x - source_offset.x - kernel_radius.x + kernel_x;
+					if (source_y >= 0 && source_y < source_dimensions.y && source_x >= 0 && source_x < source_dimensions.x)
+					{
+						const int source_index = (source_y * source_dimensions.x + source_x) * source_bytes_per_pixel + source_alpha_offset;
+						const float pixel_opacity = float(source[source_index]) * kernel[kernel_y * kernel_size.x + kernel_x];
+						if (operation == FilterOperation::Sum)
+							opacity += pixel_opacity;
+						else
+							opacity = Math::Max(opacity, pixel_opacity);
+					}
+				}
+			}
+			destination[y * destination_stride + x * destination_bytes_per_pixel + destination_alpha_offset] = byte(Math::Min(255.f, opacity));
+		}
+	}
+}
+
+struct Random {
+	uint32_t state = 12345;
+	int operator()(int max)
+	{
+		state = state * 1664525u + 1013904223u;
+		return int((state >> 8) % uint32_t(max + 1));
+	}
+};
+
+} // namespace
+
+TEST_CASE("ConvolutionFilter")
+{
+	Random random;
+
+	const Vector2i source_dimensions(37, 23);
+	const int source_bytes_per_pixel = 4;
+	Vector<byte> source(source_dimensions.x * source_dimensions.y * source_bytes_per_pixel);
+	for (byte& value : source)
+		value = byte(random(3) == 0 ? 0 : random(255));
+
+	struct TestCase {
+		const char* name;
+		Vector2i radius;
+		FilterOperation operation;
+	};
+	const TestCase test_cases[] = {
+		{"Sum horizontal", Vector2i(6, 0), FilterOperation::Sum},
+		{"Sum vertical", Vector2i(0, 9), FilterOperation::Sum},
+		{"Sum square", Vector2i(3, 3), FilterOperation::Sum},
+		{"Dilation disc", Vector2i(8, 8), FilterOperation::Dilation},
+		{"Dilation small", Vector2i(1, 1), FilterOperation::Dilation},
+		{"Dilation wide", Vector2i(12, 2), FilterOperation::Dilation},
+	};
+
+	for (const TestCase& test_case : test_cases)
+	{
+		for (const int destination_bytes_per_pixel : {1, 4})
+		{
+			SUBCASE(CreateString(64, "%s, destination %d bytes per pixel", test_case.name, destination_bytes_per_pixel).c_str())
+			{
+				const Vector2i kernel_size = test_case.radius * 2 + Vector2i(1);
+				Vector<float> kernel(kernel_size.x * kernel_size.y);
+
+				ConvolutionFilter filter;
+				REQUIRE(filter.Initialise(test_case.radius, test_case.operation));
+
+				for (int y = 0; y < kernel_size.y; y++)
+				{
+					for (int x = 0; x < kernel_size.x; x++)
+					{
+						float weight = 0.f;
+						if (test_case.operation == FilterOperation::Sum)
+						{
+							weight = float(random(100)) / float(50 * kernel_size.x * kernel_size.y);
+						}
+						else
+						{
+							// Outline kernel with unit weights inside the radius, and fractional weights along its edge.
+							const Vector2i d = Vector2i(x, y) - test_case.radius;
+							const float distance = Math::SquareRoot(float(d.x * d.x + d.y * d.y));
+							const float radius = float(Math::Max(test_case.radius.x, test_case.radius.y));
+							weight = (distance > radius ? Math::Max(radius + 1.f - distance, 0.f) : 1.f);
+						}
+						filter[y][x] = weight;
+						kernel[y * kernel_size.x + x] = weight;
+					}
+				}
+
+				const Vector2i source_offset = test_case.radius;
+				const Vector2i destination_dimensions = source_dimensions + test_case.radius * 2;
+				const int destination_stride = destination_dimensions.x * destination_bytes_per_pixel + 3;
+				const ColorFormat destination_format = (destination_bytes_per_pixel == 4 ? ColorFormat::RGBA8 : ColorFormat::A8);
+
+				Vector<byte> result(destination_stride * destination_dimensions.y);
+				Vector<byte> expected(destination_stride * destination_dimensions.y);
+
+				filter.Run(result.data(), destination_dimensions, destination_stride, destination_format, source.data(), source_dimensions,
+					source_offset, ColorFormat::RGBA8);
+				RunReference(test_case.radius, kernel, test_case.operation, expected.data(), destination_dimensions, destination_stride,
+					destination_bytes_per_pixel, source.data(), source_dimensions, source_offset, source_bytes_per_pixel);
+
+				CHECK(result == expected);
+			}
+		}
+	}
+}
@@ -26,12 +26,14 @@
  *
  */
 
+#include "../Common/InstrumentedRenderInterface.h"
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FontEngineInterface.h>
 #include <algorithm>
 #include <doctest.h>
 
@@ -172,6 +174,27 @@ TEST_CASE("core.release_textures")
 		CHECK(counters.release_texture == counter_release_before + 1);
 	}
 
+	SUBCASE("FontGlyphAppend")
+	{
+		const FontFaceHandle font_face_handle = element->GetFontFaceHandle();
+		REQUIRE(font_face_handle);
+		const int version_before = GetFontEngineInterface()->GetVersion(font_face_handle);
+		const auto counter_generate_before = counters.generate_texture;
+
+		// New glyphs are appended to the existing font textures, so that text already generated with the font face remains valid.
+		element->SetInnerRML(reinterpret_cast<const char*>(u8"π ÆØÅ æøå ßđŧ ŋħĸ"));
+		TestsShell::RenderLoop();
+		CHECK(GetFontEngineInterface()->GetVersion(font_face_handle) == version_before);
+
+		// Only textures receiving new glyphs are regenerated, each at most once per frame.
+		const auto num_generated = counters.generate_texture - counter_generate_before;
+		CHECK(num_generated >= 1);
+		CHECK(num_generated <= 2);
+
+		TestsShell::RenderLoop();
+		CHECK(counters.generate_texture == counter_generate_before + num_generated);
+	}
+
 	document->Close();
 
 	TestsShell::ShutdownShell();
@@ -179,3 +202,59 @@ TEST_CASE("core.release_textures")
 	// Finally, verify that all generated and loaded textures are released during shutdown.
 	CHECK(counters.generate_texture + counters.load_texture == counters.release_texture);
 }
+
+TEST_CASE("core.instrumented_render_interface")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	InstrumentedRenderInterface* instrumented = TestsShell::GetInstrumentedRenderInterface();
+	REQUIRE(instrumented);
+	const auto& counters = render_interface->GetCounters();
+	const auto& statistics = instrumented->GetFrameStatistics();
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocument("assets/demo.rml");
+	REQUIRE(document);
+	document->Show();
+
+	// The wrapper forwards all calls to the wrapped render interface while counting them.
+	context->Update();
+	render_interface->ResetCounters();
+	instrumented->BeginFrame();
+	context->Render();
+
+	CHECK(statistics.draw_calls > 0);
+	CHECK(statistics.draw_calls == counters.render_calls);
+	CHECK(statistics.draw_calls == statistics.immediate_draws + statistics.compiled_draws);
+	CHECK(statistics.indices > 0);
+	CHECK(statistics.texture_binds > 0);
+	CHECK(statistics.texture_binds <= statistics.draw_calls);
+	CHECK(statistics.geometry_compiles == counters.compile_geometry);
+	CHECK(statistics.transform_changes == counters.set_transform);
+
+	// Statistics are collected per frame. Once settled, an unchanged document should not compile any new geometry.
+	const size_t draw_calls = statistics.draw_calls;
+	TestsShell::RenderLoop();
+	context->Update();
+	instrumented->BeginFrame();
+	context->Render();
+
+	CHECK(statistics.draw_calls == draw_calls);
+	CHECK(statistics.geometry_compiles == 0);
+	CHECK(statistics.texture_loads == 0);
+
+	const String stats = TestsShell::GetFrameStats([&] {
+		context->Update();
+		context->Render();
+	});
+	CHECK(stats.find("Draw calls: " + ToString(draw_calls)) != String::npos);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,164 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Decorator.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/PropertyIdSet.h>
+#include <RmlUi/Core/StyleSheet.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static const String document_decorator_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<style>
+		@spritesheet test_sheet
+		{
+			src: /assets/invader.tga;
+			outer: 162px 193px 145px 31px;
+			inner: 173px 206px 127px 10px;
+		}
+		body {
+			left: 0;
+			top: 0;
+			right: 0;
+			bottom: 0;
+		}
+		div {
+			display: block;
+			width: 100px;
+			height: 50px;
+		}
+		.image { decorator: image(/assets/high_scores_alien_1.tga); }
+		.ninepatch { decorator: ninepatch(outer, inner); }
+		.edges { decorator: ninepatch(outer, inner, 1em); }
+		.wide { width: 200px; }
+		.large { font-size: 30px; }
+	</style>
+</head>
+
+<body>
+	<div id="image_a" class="image"/>
+	<div id="image_b" class="image"/>
+	<div id="ninepatch_a" class="ninepatch"/>
+	<div id="ninepatch_b" class="ninepatch"/>
+	<div id="edges_a" class="edges"/>
+	<div id="edges_b" class="edges"/>
+	<div id="edges_large" class="edges large"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("decorator.element_data_cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml);
+	REQUIRE(document);
+	document->Show();
+
+	context->Update();
+	context->Render();
+
+	// Generates data for each element from the decorator instanced for it, which is shared with the data generated during rendering if the
+	// elements are given the same data. Returns true if all the elements were given identical, valid data.
+	auto IsDataShared = [document](std::initializer_list<const char*> ids) {
+		Vector<std::pair<const Decorator*, DecoratorDataHandle>> data;
+		for (const char* id : ids)
+		{
+			Element* element = document->GetElementById(id);
+			REQUIRE(element);
+			const Property* property = element->GetLocalProperty(PropertyId::Decorator);
+			REQUIRE(property);
+			const DecoratorPtrList& decorators =
+				element->GetStyleSheet()->InstanceDecorators(*property->Get<DecoratorsPtr>(), property->source.get());
+			REQUIRE(decorators.size() == 1);
+			data.emplace_back(decorators[0].get(), decorators[0]->GenerateElementData(element));
+		}
+
+		bool result = true;
+		for (auto& entry : data)
+		{
+			result &= (entry.second != 0 && entry.second == data[0].second);
+			entry.first->ReleaseElementData(entry.second);
+		}
+		return result;
+	};
+
+	for (const String name : {"image", "ninepatch", "edges"})
+	{
+		const String id_a = name + "_a";
+		const String id_b = name + "_b";
+		Element* element_a = document->GetElementById(id_a);
+
+		// Elements of identical size share their data.
+		CHECK(IsDataShared({id_a.c_str(), id_b.c_str()}));
+
+		// A resized element gets its own data.
+		element_a->SetClass("wide", true);
+		context->Update();
+		context->Render();
+		CHECK(!IsDataShared({id_a.c_str(), id_b.c_str()}));
+
+		// Returning to the original size shares the data again.
+		element_a->SetClass("wide", false);
+		context->Update();
+		context->Render();
+		CHECK(IsDataShared({id_a.c_str(), id_b.c_str()}));
+	}
+
+	// Nine-patch edges given in 'em' units depend on the font size, so equally sized elements with different font sizes need their own data.
+	CHECK(!IsDataShared({"edges_large", "edges_b"}));
+
+	// Without colour modulation in the renderer, the opacity of each element is applied to the vertices of its own geometry, thus data is not
+	// shared between elements.
+	if (TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface())
+	{
+		render_interface->SetColourModulationSupported(false);
+		for (bool wide : {true, false})
+		{
+			document->GetElementById("image_a")->SetClass("wide", wide);
+			document->GetElementById("image_b")->SetClass("wide", wide);
+			context->Update();
+			context->Render();
+		}
+		CHECK(!IsDataShared({"image_a", "image_b"}));
+		render_interface->SetColourModulationSupported(true);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
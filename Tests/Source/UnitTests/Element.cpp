@@ -33,6 +33,7 @@
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/ElementInstancer.h>
 #include <RmlUi/Core/Factory.h>
 #include <doctest.h>
 
@@ -421,3 +422,279 @@ TEST_CASE("Element.ScrollIntoView")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("Element.Culling")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_scroll_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Run(context);
+
+	Element* scrollable = document->GetElementById("scrollable");
+	REQUIRE(scrollable);
+
+	const Context::RenderStatistics& statistics = context->GetRenderStatistics();
+
+	// Only the two top rows and their two leftmost cells are placed inside the scroll container's clipping region.
+	CHECK(statistics.num_elements_culled == 14);
+	CHECK(statistics.num_subtrees_culled == 0);
+
+	SUBCASE("Scrolled")
+	{
+		scrollable->SetScrollLeft(100);
+		scrollable->SetScrollTop(100);
+		Run(context);
+
+		CHECK(statistics.num_elements_culled == 14);
+		CHECK(statistics.num_subtrees_culled == 0);
+	}
+
+	SUBCASE("Subtree")
+	{
+		Element* row = document->GetElementById("row3");
+		REQUIRE(row);
+		row->SetProperty("position", "relative");
+		row->SetProperty("z-index", "1");
+		row->SetProperty("overflow", "hidden");
+		row->SetProperty("height", "20px");
+		Run(context);
+
+		// The row is now a local stacking context clipping all its cells, which are culled together with the row.
+		CHECK(statistics.num_elements_culled == 14);
+		CHECK(statistics.num_subtrees_culled == 1);
+
+		document->GetElementById("cell30")->SetProperty("position", "fixed");
+		Run(context);
+
+		// A fixed cell may escape the row's clipping region, thus the cells must be considered separately.
+		CHECK(statistics.num_subtrees_culled == 0);
+	}
+
+	SUBCASE("TransformedClippingAncestor")
+	{
+		// The clipping region is transformed along with the scroll container, thus its cells can't be culled by their untransformed boxes.
+		scrollable->SetProperty("transform", "translateX(300px)");
+		Run(context);
+
+		CHECK(statistics.num_elements_culled == 0);
+		CHECK(statistics.num_subtrees_culled == 0);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_stacking_context_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { left: 0; top: 0; width: 400px; height: 300px; }
+		div { position: absolute; left: 0; top: 0; width: 100px; height: 100px; }
+	</style>
+</head>
+<body>
+	<div id="a"></div>
+	<div id="b" style="z-index: 1"></div>
+	<div id="c"></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Element.StackingContext")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_stacking_context_rml);
+	REQUIRE(document);
+	document->Show();
+
+	const Context::RenderStatistics& statistics = context->GetRenderStatistics();
+	auto UpdateAndRender = [&]() {
+		context->Update();
+		context->Render();
+	};
+	auto Append = [&](const String& id, const String& z_index, Element* before = nullptr) {
+		ElementPtr element = document->CreateElement("div");
+		element->SetId(id);
+		if (!z_index.empty())
+			element->SetProperty("z-index", z_index);
+		return before ? document->InsertBefore(std::move(element), before) : document->AppendChild(std::move(element));
+	};
+	auto GetTopElementId = [&]() {
+		const Vector2f point = document->GetAbsoluteOffset(BoxArea::Border) + Vector2f(50, 50);
+		Element* element = context->GetElementAtPoint(point);
+		return element ? element->GetId() : String();
+	};
+
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built > 0);
+	CHECK(GetTopElementId() == "b");
+
+	// Elements added to or removed from an existing stacking context are spliced into its render order, without rebuilding it.
+	Append("d", "");
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 0);
+	CHECK(statistics.num_stacking_context_insertions == 1);
+	CHECK(GetTopElementId() == "b");
+
+	// Only the new element's own stacking context is built.
+	Element* e = Append("e", "1");
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 1);
+	CHECK(statistics.num_stacking_context_insertions == 1);
+	CHECK(GetTopElementId() == "e");
+
+	// Elements with equal z-index are rendered in tree order.
+	Element* f = Append("f", "1", e);
+	Append("g", "-1");
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 2);
+	CHECK(statistics.num_stacking_context_insertions == 2);
+	CHECK(GetTopElementId() == "e");
+
+	document->RemoveChild(e);
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 0);
+	CHECK(statistics.num_stacking_context_insertions == 0);
+	CHECK(GetTopElementId() == "f");
+
+	document->RemoveChild(f);
+	Append("h", "1", document->GetElementById("b"));
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 1);
+	CHECK(statistics.num_stacking_context_insertions == 1);
+	CHECK(GetTopElementId() == "b");
+
+	document->RemoveChild(document->GetElementById("b"));
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 0);
+	CHECK(GetTopElementId() == "h");
+
+	// Removing an element queued for insertion before it is rendered leaves the render order unchanged.
+	Append("i", "2");
+	document->RemoveChild(document->GetElementById("i"));
+	UpdateAndRender();
+	CHECK(statistics.num_stacking_contexts_built == 0);
+	CHECK(statistics.num_stacking_context_insertions == 0);
+	CHECK(GetTopElementId() == "h");
+
+	SUBCASE("Rebuild")
+	{
+		// Positioned elements sort their descendants among themselves, adding to them requires a rebuild. The new element builds its own too.
+		ElementPtr child = document->CreateElement("div");
+		child->SetId("c_child");
+		child->SetProperty("z-index", "3");
+		document->GetElementById("c")->AppendChild(std::move(child));
+		UpdateAndRender();
+		CHECK(statistics.num_stacking_contexts_built == 2);
+		CHECK(statistics.num_stacking_context_insertions == 0);
+		CHECK(GetTopElementId() == "c_child");
+
+		// Giving an element of the stacking context a z-index also requires a rebuild, in addition to building its own.
+		document->GetElementById("a")->SetProperty("z-index", "4");
+		UpdateAndRender();
+		CHECK(statistics.num_stacking_contexts_built == 2);
+		CHECK(GetTopElementId() == "a");
+	}
+
+	SUBCASE("QueuedChildOfNewStackingContext")
+	{
+		// Allocate the elements individually so that any stale pointer to a removed element is not hidden by the element pool.
+		static ElementInstancerGeneric<Element> instancer;
+		Factory::RegisterElementInstancer("div", &instancer);
+
+		Element* parent = Append("parent", "");
+		UpdateAndRender();
+
+		// The child is queued on the stacking context of the document, until its parent becomes a stacking context of its own.
+		Element* child = parent->AppendChild(document->CreateElement("div"));
+		parent->SetProperty("z-index", "5");
+		context->Update();
+
+		parent->RemoveChild(child);
+		UpdateAndRender();
+		CHECK(statistics.num_stacking_context_insertions == 0);
+		CHECK(GetTopElementId() == "parent");
+
+		parent->AppendChild(document->CreateElement("div"))->SetId("child");
+		UpdateAndRender();
+		CHECK(statistics.num_stacking_context_insertions == 1);
+		CHECK(GetTopElementId() == "child");
+	}
+
+	SUBCASE("HitTestBeforeRender")
+	{
+		UpdateAndRender();
+		const int num_elements_rendered = statistics.num_elements_rendered;
+
+		// Hit testing sees elements queued for insertion before they are rendered.
+		Append("j", "6");
+		context->Update();
+		CHECK(GetTopElementId() == "j");
+		context->Render();
+		CHECK(statistics.num_elements_rendered == num_elements_rendered + 1);
+
+		// When the stacking context is dirtied after queuing an element, hit testing rebuilds it, the element must not be inserted again.
+		Append("k", "7");
+		document->GetElementById("a")->SetProperty("z-index", "-1");
+		context->Update();
+		CHECK(GetTopElementId() == "k");
+		context->Render();
+		CHECK(statistics.num_elements_rendered == num_elements_rendered + 2);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.Opacity")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer, where we can toggle support for colour modulation.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_clone_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Run(context);
+	Run(context);
+
+	render_interface->ResetCounters();
+	const auto& counters = render_interface->GetCounters();
+
+	// Opacity is applied by modulating the colour of the rendered geometry, thus no new geometry should be compiled.
+	document->SetProperty("opacity", "0.5");
+	Run(context);
+	Run(context);
+	CHECK(counters.compile_geometry == 0);
+	CHECK(counters.set_colour_modulation > 0);
+
+	SUBCASE("Fallback")
+	{
+		// Without support in the renderer, the opacity is applied to the vertex colours which then need to be compiled again.
+		render_interface->SetColourModulationSupported(false);
+		document->SetProperty("opacity", "0.25");
+		Run(context);
+		Run(context);
+		CHECK(counters.compile_geometry > 0);
+
+		// Returning to full opacity restores the original vertex colours.
+		render_interface->SetColourModulationSupported(true);
+		document->SetProperty("opacity", "1");
+		Run(context);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
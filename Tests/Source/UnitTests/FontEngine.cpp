@@ -0,0 +1,720 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../../Source/Core/FileInterfaceDefault.h"
+#include "../../../Source/Core/FontEffectBlur.h"
+#include "../../../Source/Core/FontEffectGlow.h"
+#include "../../../Source/Core/FontEngineDefault/CharacterTable.h"
+#include "../../../Source/Core/FontEngineDefault/FontDistanceFieldAtlas.h"
+#include "../../../Source/Core/FontEngineDefault/FontFaceHandleDefault.h"
+#include "../../../Source/Core/FontEngineDefault/FontFileCache.h"
+#include "../../../Source/Core/FontEngineDefault/FontProvider.h"
+#include "../../../Source/Core/FontEngineDefault/ShapedRunCache.h"
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <PlatformExtensions.h>
+#include <RmlUi/Core/FileInterface.h>
+#include <doctest.h>
+
+#if defined(RMLUI_PLATFORM_WIN32)
+	#include <direct.h>
+#else
+	#include <unistd.h>
+#endif
+
+using namespace Rml;
+
+static const String document_font_effects_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; color: #fff; }
+		.outline { font-effect: outline(2px #f00); font-size: 20px; }
+		.glow { font-effect: glow(2px 4px 1px 1px #0f0); font-size: 32px; }
+		.large { font-effect: outline(30px #00f); font-size: 12px; }
+	</style>
+</head>
+<body>
+	<p class="outline">Outlined text</p>
+	<p class="glow">Glowing text</p>
+	<p class="large">Outline wider than the field</p>
+</body>
+</rml>
+)";
+
+struct GlyphImage {
+	Vector2i bearing;
+	Vector2i dimensions;
+	Vector<byte> data;
+	bool has_distance_field = false;
+
+	int Get(int x, int y) const
+	{
+		// Coordinates relative to the glyph origin, with y pointing down.
+		x -= bearing.x;
+		y += bearing.y;
+		if (x < 0 || y < 0 || x >= dimensions.x || y >= dimensions.y)
+			return 0;
+		return data[y * dimensions.x + x];
+	}
+};
+
+static GlyphImage GetGlyphImage(int font_size, Character character)
+{
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, font_size);
+	REQUIRE(handle);
+
+	auto it = handle->GetGlyphs().find(character);
+	REQUIRE(it != handle->GetGlyphs().end());
+	const FontGlyph& glyph = it->second;
+
+	GlyphImage image;
+	image.bearing = glyph.bearing;
+	image.dimensions = glyph.bitmap_dimensions;
+	image.data.assign(glyph.bitmap_data, glyph.bitmap_data + glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y);
+	image.has_distance_field = (glyph.distance_field != nullptr);
+	return image;
+}
+
+TEST_CASE("font_engine.distance_field")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const Vector<int> font_sizes = {12, 24, 48, 96};
+	const String characters = "Ag&";
+
+	Vector<GlyphImage> rendered_glyphs;
+	for (int font_size : font_sizes)
+		for (char c : characters)
+			rendered_glyphs.push_back(GetGlyphImage(font_size, Character(c)));
+
+	Rml::SetFontDistanceFieldSize(64);
+	Rml::ReleaseFontResources();
+
+	size_t i = 0;
+	for (int font_size : font_sizes)
+	{
+		for (char c : characters)
+		{
+			const GlyphImage& rendered = rendered_glyphs[i++];
+			const GlyphImage generated = GetGlyphImage(font_size, Character(c));
+			CHECK(!rendered.has_distance_field);
+			CHECK(generated.has_distance_field);
+
+			// The glyphs generated from the distance field should closely match the glyphs rendered at each size.
+			const int left = Math::Min(rendered.bearing.x, generated.bearing.x);
+			const int top = Math::Min(-rendered.bearing.y, -generated.bearing.y);
+			const int right = Math::Max(rendered.bearing.x + rendered.dimensions.x, generated.bearing.x + generated.dimensions.x);
+			const int bottom = Math::Max(-rendered.bearing.y + rendered.dimensions.y, -generated.bearing.y + generated.dimensions.y);
+
+			int sum_rendered = 0;
+			int sum_generated = 0;
+			int sum_difference = 0;
+			for (int y = top; y < bottom; y++)
+			{
+				for (int x = left; x < right; x++)
+				{
+					sum_rendered += rendered.Get(x, y);
+					sum_generated += generated.Get(x, y);
+					sum_difference += Math::Absolute(rendered.Get(x, y) - generated.Get(x, y));
+				}
+			}
+
+			INFO("Character '", c, "' at size ", font_size);
+			CHECK(Math::Absolute(sum_generated - sum_rendered) < sum_rendered / 10);
+			CHECK(sum_difference < sum_rendered / 6);
+		}
+	}
+
+	// Text effects should be generated from the distance field, or otherwise fall back to filtering the glyph bitmaps.
+	ElementDocument* document = context->LoadDocumentFromMemory(document_font_effects_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+	document->Close();
+
+	Rml::SetFontDistanceFieldSize(0);
+	Rml::ReleaseFontResources();
+	CHECK(!GetGlyphImage(24, Character('A')).has_distance_field);
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_font_sizes_rml = R"(
+<rml>
+<head>
+	<style>
+		body { font-family: LatoLatin; color: #fff; display: block; }
+		p { display: block; }
+	</style>
+</head>
+<body>
+	<p style="font-size: 12px">Small text</p>
+	<p style="font-size: 24px">Medium text</p>
+	<p style="font-size: 48px">Large text</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("font_engine.distance_field_atlas")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer, which can be toggled to support distance field textures.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	auto RenderFontSizes = [&]() {
+		ElementDocument* document = context->LoadDocumentFromMemory(document_font_sizes_rml);
+		REQUIRE(document);
+		document->Show();
+		render_interface->ResetCounters();
+		TestsShell::RenderLoop();
+		document->Close();
+		context->Update();
+		return render_interface->GetCounters();
+	};
+
+	// Without support in the render interface, the glyphs are generated from the distance fields into separate textures for each font size.
+	Rml::SetFontDistanceFieldSize(64);
+	Rml::ReleaseFontResources();
+	const TestsRenderInterface::Counters counters_per_size = RenderFontSizes();
+	CHECK(counters_per_size.generate_texture >= 3);
+	CHECK(counters_per_size.generate_distance_field_texture == 0);
+
+	// With support, every size renders from the same distance field textures.
+	render_interface->SetDistanceFieldTexturesSupported(true);
+	Rml::ReleaseFontResources();
+
+	FontFaceHandleDefault* handle_small = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 12);
+	FontFaceHandleDefault* handle_large = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 48);
+	REQUIRE(handle_small);
+	REQUIRE(handle_large);
+	FontDistanceFieldAtlas* atlas = handle_small->GetDistanceFieldAtlas();
+	REQUIRE(atlas);
+	CHECK(handle_large->GetDistanceFieldAtlas() == atlas);
+
+	GeometryList geometry_small, geometry_large;
+	handle_small->GenerateString(geometry_small, "Ag", Vector2f(0, 0), Colourb(255), 1.f, 0.f);
+	handle_large->GenerateString(geometry_large, "Ag", Vector2f(0, 0), Colourb(255), 1.f, 0.f);
+	// The textures of the atlas follow any textures of glyphs without distance fields.
+	const int num_atlas_textures = atlas->GetNumTextures();
+	REQUIRE(num_atlas_textures > 0);
+	REQUIRE(geometry_small.size() == geometry_large.size());
+	REQUIRE(geometry_small.size() >= (size_t)num_atlas_textures);
+	const size_t first_atlas_geometry = geometry_small.size() - (size_t)num_atlas_textures;
+
+	// The glyph quads are scaled with the font size, while their textures and texture coordinates are the same.
+	int num_quads = 0;
+	for (size_t i = 0; i < geometry_small.size(); i++)
+	{
+		Geometry& small = geometry_small[i];
+		Geometry& large = geometry_large[i];
+		if (i < first_atlas_geometry)
+		{
+			CHECK(small.GetVertices().empty());
+			CHECK(large.GetVertices().empty());
+			continue;
+		}
+
+		CHECK(small.GetTexture() == atlas->GetTexture(int(i - first_atlas_geometry)));
+		CHECK(large.GetTexture() == atlas->GetTexture(int(i - first_atlas_geometry)));
+		REQUIRE(small.GetVertices().size() == large.GetVertices().size());
+
+		for (size_t j = 0; j + 1 < small.GetVertices().size(); j += 4)
+		{
+			CHECK(small.GetVertices()[j].tex_coord == large.GetVertices()[j].tex_coord);
+			CHECK(small.GetVertices()[j + 2].tex_coord == large.GetVertices()[j + 2].tex_coord);
+			const float small_width = small.GetVertices()[j + 1].position.x - small.GetVertices()[j].position.x;
+			const float large_width = large.GetVertices()[j + 1].position.x - large.GetVertices()[j].position.x;
+			CHECK(large_width == doctest::Approx(4.f * small_width));
+			num_quads += 1;
+		}
+	}
+	CHECK(num_quads == 2);
+
+	const TestsRenderInterface::Counters counters_atlas = RenderFontSizes();
+	CHECK(counters_atlas.generate_texture == 0);
+	CHECK(counters_atlas.generate_distance_field_texture > 0);
+	CHECK(counters_atlas.generate_distance_field_texture <= (size_t)atlas->GetNumTextures());
+
+	render_interface->SetDistanceFieldTexturesSupported(false);
+	Rml::SetFontDistanceFieldSize(0);
+	Rml::ReleaseFontResources();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.shaped_run_cache")
+{
+	ShapedRunCache cache(2);
+
+	cache.Insert("a", 0.f, Character::Null).width = 1;
+	cache.Insert("b", 0.f, Character::Null).width = 2;
+	REQUIRE(cache.Find("a", 0.f, Character::Null));
+	CHECK(cache.Find("a", 0.f, Character::Null)->width == 1);
+	CHECK(!cache.Find("a", 1.f, Character::Null));
+	CHECK(!cache.Find("a", 0.f, Character('b')));
+
+	// The least recently used run should be evicted.
+	cache.Insert("c", 0.f, Character::Null).width = 3;
+	CHECK(cache.GetNumRuns() == 2);
+	CHECK(!cache.Find("b", 0.f, Character::Null));
+	REQUIRE(cache.Find("a", 0.f, Character::Null));
+	REQUIRE(cache.Find("c", 0.f, Character::Null));
+	CHECK(cache.Find("a", 0.f, Character::Null)->width == 1);
+	CHECK(cache.Find("c", 0.f, Character::Null)->width == 3);
+
+	TestsShell::GetContext();
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 16);
+	REQUIRE(handle);
+
+	const String text = "AVAST ye, WAVy text";
+	const int width = handle->GetStringWidth(text, 0.f);
+	CHECK(width > 0);
+
+	// Measuring the same string again should give the cached result, while other parameters should be shaped separately.
+	CHECK(handle->GetStringWidth(text, 0.f) == width);
+	CHECK(handle->GetStringWidth(text, 2.f) == width + 2 * (int)text.size());
+	CHECK(handle->GetStringWidth(text, 0.f, Character('T')) != width);
+
+	GeometryList geometry;
+	CHECK(handle->GenerateString(geometry, text, Vector2f(0.f), Colourb(255), 1.f, 0.f) == width);
+	REQUIRE(geometry.size() == 1);
+	const size_t num_vertices = geometry[0].GetVertices().size();
+	CHECK(num_vertices > 0);
+
+	GeometryList geometry_cached;
+	CHECK(handle->GenerateString(geometry_cached, text, Vector2f(0.f), Colourb(255), 1.f, 0.f) == width);
+	REQUIRE(geometry_cached.size() == 1);
+	CHECK(geometry_cached[0].GetVertices().size() == num_vertices);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.character_table")
+{
+	CharacterTable<int> table;
+	CHECK(table.find(Character('a')) == table.end());
+
+	// Characters in the dense pages, and outside them.
+	const Vector<Character> characters = {Character('a'), Character(0xe9), Character(0x4e2d), Character(0xffff), Character(0x1f600), Character('b')};
+	for (size_t i = 0; i < characters.size(); i++)
+		CHECK(table.emplace(characters[i], int(i)).second);
+
+	CHECK(!table.emplace(Character(0x1f600), -1).second);
+	CHECK(!table.emplace(Character('a'), -1).second);
+	CHECK(table.find(Character('c')) == table.end());
+	CHECK(table.find(Character(0x4e2e)) == table.end());
+	CHECK(table.find(Character(0x1f601)) == table.end());
+	REQUIRE(table.size() == characters.size());
+
+	// Entries iterate in insertion order.
+	int i = 0;
+	for (const auto& pair : table)
+	{
+		CHECK(pair.first == characters[i]);
+		CHECK(pair.second == i);
+		i++;
+	}
+
+	const CharacterTable<int> table_copy = table;
+	for (size_t j = 0; j < characters.size(); j++)
+	{
+		auto it = table_copy.find(characters[j]);
+		REQUIRE(it != table_copy.end());
+		CHECK(it->second == int(j));
+	}
+
+	table[Character(0x4e2d)] = 10;
+	table[Character(0x10000)] = 11;
+	CHECK(table.find(Character(0x4e2d))->second == 10);
+	CHECK(table.find(Character(0x10000))->second == 11);
+	CHECK(table.size() == characters.size() + 1);
+
+	table.clear();
+	CHECK(table.empty());
+	CHECK(table.find(Character('a')) == table.end());
+}
+
+// Counts the glyphs it generates, otherwise filling their boxes.
+class FontEffectCountGlyphs : public FontEffect {
+public:
+	bool HasUniqueTexture() const override { return true; }
+	bool GetGlyphMetrics(Vector2i& /*origin*/, Vector2i& /*dimensions*/, const FontGlyph& /*glyph*/) const override { return true; }
+	void GenerateGlyphTexture(byte* destination_data, Vector2i destination_dimensions, int destination_stride,
+		const FontGlyph& /*glyph*/) const override
+	{
+		num_generated_glyphs += 1;
+		for (int y = 0; y < destination_dimensions.y; y++)
+			for (int x = 0; x < destination_dimensions.x; x++)
+				destination_data[y * destination_stride + x * 4 + 3] = 255;
+	}
+
+	mutable int num_generated_glyphs = 0;
+};
+
+TEST_CASE("font_engine.append_glyph_effect")
+{
+	TestsShell::GetContext();
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 22);
+	REQUIRE(handle);
+
+	auto effect = MakeShared<FontEffectCountGlyphs>();
+	effect->SetFingerprint(1);
+	const int configuration = handle->GenerateLayerConfiguration(FontEffectList{effect});
+
+	GeometryList geometry;
+	auto GenerateTextures = [&](const String& text) {
+		handle->GenerateString(geometry, text, Vector2f(0.f), Colourb(255), 1.f, 0.f, configuration);
+		for (const Geometry& item : geometry)
+			item.GetTexture()->GetHandle();
+	};
+
+	GenerateTextures("A");
+	const int version = handle->GetVersion();
+	CHECK(effect->num_generated_glyphs > 1);
+
+	// The first glyph appended to a page generates the page again, after which a copy of it is kept.
+	GenerateTextures(reinterpret_cast<const char*>(u8"π"));
+	CHECK(handle->GetVersion() == version);
+	REQUIRE(effect->num_generated_glyphs > 1);
+
+	// Further appended glyphs are generated into the copy, without applying the effect to the other glyphs again.
+	effect->num_generated_glyphs = 0;
+	GenerateTextures(reinterpret_cast<const char*>(u8"Æ"));
+	CHECK(effect->num_generated_glyphs == 1);
+
+	effect->num_generated_glyphs = 0;
+	GenerateTextures(reinterpret_cast<const char*>(u8"ØÅ"));
+	CHECK(effect->num_generated_glyphs == 2);
+	CHECK(handle->GetVersion() == version);
+
+	// Textures released by the render interface are restored from the copy.
+	effect->num_generated_glyphs = 0;
+	Rml::ReleaseTextures();
+	GenerateTextures(reinterpret_cast<const char*>(u8"AπÆØÅ"));
+	CHECK(effect->num_generated_glyphs == 0);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.effect_threads")
+{
+	TestsShell::GetContext();
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 24);
+	REQUIRE(handle);
+
+	auto blur = MakeShared<FontEffectBlur>();
+	REQUIRE(blur->Initialise(3));
+	auto glow = MakeShared<FontEffectGlow>();
+	REQUIRE(glow->Initialise(2, 4, Vector2i(1, 1)));
+	blur->SetFingerprint(1);
+	glow->SetFingerprint(2);
+	handle->GenerateLayerConfiguration(FontEffectList{blur, glow});
+
+	for (const FontEffect* effect : {(const FontEffect*)blur.get(), (const FontEffect*)glow.get()})
+	{
+		Rml::SetFontEffectThreads(1);
+		UniquePtr<const byte[]> data;
+		Vector2i dimensions;
+		REQUIRE(handle->GenerateLayerTexture(data, dimensions, effect, 0, handle->GetVersion()));
+
+		// Generating the glyphs in parallel should give the same texture.
+		Rml::SetFontEffectThreads(4);
+		UniquePtr<const byte[]> data_threaded;
+		Vector2i dimensions_threaded;
+		REQUIRE(handle->GenerateLayerTexture(data_threaded, dimensions_threaded, effect, 0, handle->GetVersion()));
+
+		REQUIRE(dimensions == dimensions_threaded);
+		CHECK(memcmp(data.get(), data_threaded.get(), size_t(dimensions.x * dimensions.y * 4)) == 0);
+	}
+
+	Rml::SetFontEffectThreads(1);
+	TestsShell::ShutdownShell();
+}
+
+// Maps files by reading them through another file interface, keeping track of the files currently mapped.
+class MappingFileInterface : public FileInterface {
+public:
+	MappingFileInterface(FileInterface* file_interface) : file_interface(file_interface) {}
+
+	FileHandle Open(const String& path) override { return file_interface->Open(path); }
+	void Close(FileHandle file) override { file_interface->Close(file); }
+	size_t Read(void* buffer, size_t size, FileHandle file) override { return file_interface->Read(buffer, size, file); }
+	bool Seek(FileHandle file, long offset, int origin) override { return file_interface->Seek(file, offset, origin); }
+	size_t Tell(FileHandle file) override { return file_interface->Tell(file); }
+
+	bool MapFile(const String& path, const byte*& out_data, size_t& out_size) override
+	{
+		String data;
+		if (!file_interface->LoadFile(path, data) || data.empty())
+			return false;
+
+		byte* mapped_data = new byte[data.size()];
+		memcpy(mapped_data, data.data(), data.size());
+		out_data = mapped_data;
+		out_size = data.size();
+		num_mapped_files += 1;
+		return true;
+	}
+	void UnmapFile(const byte* data, size_t /*size*/) override
+	{
+		delete[] data;
+		num_mapped_files -= 1;
+	}
+
+	int num_mapped_files = 0;
+
+private:
+	FileInterface* file_interface;
+};
+
+TEST_CASE("font_engine.mapped_font_file")
+{
+	TestsShell::GetContext();
+
+	FileInterface* shell_file_interface = Rml::GetFileInterface();
+	MappingFileInterface file_interface(shell_file_interface);
+	Rml::SetFileInterface(&file_interface);
+
+	// Font faces loaded from files should refer to the mapped file, which should be released when the face is released.
+	CHECK(Rml::LoadFontFace("assets/LatoLatin-Bold.ttf"));
+	CHECK(file_interface.num_mapped_files == 1);
+	TestsShell::SetNumExpectedWarnings(2);
+	CHECK(!Rml::LoadFontFace("assets/rml.rcss"));
+	CHECK(!Rml::LoadFontFace("does_not_exist.ttf"));
+	CHECK(file_interface.num_mapped_files == 1);
+
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Bold, 16);
+	REQUIRE(handle);
+	CHECK(handle->GetStringWidth("Mapped", 0.f) > 0);
+
+	Rml::SetFileInterface(shell_file_interface);
+	TestsShell::ShutdownShell();
+	CHECK(file_interface.num_mapped_files == 0);
+
+	// The default file interface maps files directly where supported.
+	const String file_name = "font_engine_mapped_file.tmp";
+	const String contents = "Mapped file contents";
+	FILE* file = fopen(file_name.c_str(), "wb");
+	REQUIRE(file);
+	fwrite(contents.data(), 1, contents.size(), file);
+	fclose(file);
+
+	FileInterfaceDefault default_file_interface;
+	const byte* data = nullptr;
+	size_t size = 0;
+	if (default_file_interface.MapFile(file_name, data, size))
+	{
+		REQUIRE(size == contents.size());
+		CHECK(memcmp(data, contents.data(), size) == 0);
+		default_file_interface.UnmapFile(data, size);
+	}
+	CHECK(!default_file_interface.MapFile("does_not_exist.tmp", data, size));
+
+	remove(file_name.c_str());
+}
+
+TEST_CASE("font_engine.file_cache")
+{
+	TestsShell::GetContext();
+
+	auto glow = MakeShared<FontEffectGlow>();
+	REQUIRE(glow->Initialise(2, 3, Vector2i(1, 1)));
+	glow->SetFingerprint(3);
+
+	struct HandleData {
+		int string_width;
+		Vector2i base_dimensions, glow_dimensions;
+		String base_texture, glow_texture;
+	};
+	auto GetHandleData = [&]() {
+		HandleData result = {};
+		FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 20);
+		REQUIRE(handle);
+		result.string_width = handle->GetStringWidth("Cached glyphs", 0.f);
+		handle->GenerateLayerConfiguration(FontEffectList{glow});
+
+		UniquePtr<const byte[]> data;
+		REQUIRE(handle->GenerateLayerTexture(data, result.base_dimensions, nullptr, 0, handle->GetVersion()));
+		result.base_texture.assign((const char*)data.get(), size_t(result.base_dimensions.x * result.base_dimensions.y * 4));
+		REQUIRE(handle->GenerateLayerTexture(data, result.glow_dimensions, glow.get(), 0, handle->GetVersion()));
+		result.glow_texture.assign((const char*)data.get(), size_t(result.glow_dimensions.x * result.glow_dimensions.y * 4));
+		return result;
+	};
+	auto CheckEqual = [](const HandleData& a, const HandleData& b) {
+		CHECK(a.string_width == b.string_width);
+		CHECK(a.base_dimensions == b.base_dimensions);
+		CHECK(a.glow_dimensions == b.glow_dimensions);
+		CHECK(a.base_texture == b.base_texture);
+		CHECK(a.glow_texture == b.glow_texture);
+	};
+
+	const String cache_directory = "font_engine_cache";
+	auto ClearCacheDirectory = [&]() {
+		for (const String& file_name : PlatformExtensions::ListFiles(cache_directory))
+			remove((cache_directory + '/' + file_name).c_str());
+	};
+
+	const HandleData reference = GetHandleData();
+	Rml::ReleaseFontResources();
+
+	Rml::SetFontCacheDirectory(cache_directory);
+	ClearCacheDirectory();
+	CheckEqual(reference, GetHandleData());
+	CHECK(FontFileCache::GetNumLoadedEntries() == 0);
+	Rml::ReleaseFontResources();
+
+	// Now the glyphs and the glow texture must be loaded from the cache, and give the same results as when generated.
+	const int num_loaded_entries = FontFileCache::GetNumLoadedEntries();
+	CheckEqual(reference, GetHandleData());
+	CHECK(FontFileCache::GetNumLoadedEntries() == num_loaded_entries + 2);
+
+	// Appending glyphs changes the textures of the layers, these are not saved until the layers are generated from scratch.
+	const size_t num_cache_files = PlatformExtensions::ListFiles(cache_directory).size();
+	{
+		FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 20);
+		REQUIRE(handle);
+		CHECK(handle->GetStringWidth(u8"ÆØÅ", 0.f) > 0);
+
+		UniquePtr<const byte[]> data;
+		Vector2i dimensions;
+		REQUIRE(handle->GenerateLayerTexture(data, dimensions, glow.get(), 0, handle->GetVersion()));
+	}
+	CHECK(PlatformExtensions::ListFiles(cache_directory).size() == num_cache_files);
+
+	// The least recently used files are removed to keep the cache within its maximum size, only the index remains here.
+	Rml::SetFontCacheDirectory(cache_directory, 1);
+	CHECK(PlatformExtensions::ListFiles(cache_directory).size() == 1);
+
+	Rml::SetFontCacheDirectory("");
+	ClearCacheDirectory();
+#if defined(RMLUI_PLATFORM_WIN32)
+	_rmdir(cache_directory.c_str());
+#else
+	rmdir(cache_directory.c_str());
+#endif
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.fallback_font_cache")
+{
+	TestsShell::GetContext();
+
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 16);
+	FontFaceHandleDefault* emoji_handle = FontProvider::GetFontFaceHandle("noto emoji", Style::FontStyle::Normal, Style::FontWeight::Normal, 16);
+	REQUIRE(handle);
+	REQUIRE(emoji_handle);
+
+	// The emoji is found in the fallback font, also when looked up again from a handle of another size.
+	int index = 0;
+	const String emoji = u8"\U0001F600";
+	CHECK(handle->GetStringWidth(emoji, 0.f) > 0);
+	CHECK(FontProvider::FindFallbackFontFaceIndex(Character(0x1F600), index));
+	CHECK(index == 0);
+	FontFaceHandleDefault* large_handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 32);
+	REQUIRE(large_handle);
+	CHECK(large_handle->GetStringWidth(emoji, 0.f) > handle->GetStringWidth(emoji, 0.f));
+
+	// Characters missing from all fallback fonts are remembered as well.
+	const int width_missing = emoji_handle->GetStringWidth(u8"Å", 0.f);
+	CHECK(FontProvider::FindFallbackFontFaceIndex(Character(0xC5), index));
+	CHECK(index == -1);
+
+	// Adding a fallback font face makes previously missing characters available.
+	CHECK(Rml::LoadFontFace("assets/LatoLatin-Regular.ttf", true));
+	CHECK(!FontProvider::FindFallbackFontFaceIndex(Character(0xC5), index));
+	CHECK(FontProvider::FindFallbackFontFaceIndex(Character(0x1F600), index));
+	CHECK(emoji_handle->GetStringWidth(u8"Å", 0.f) > width_missing);
+	CHECK(FontProvider::FindFallbackFontFaceIndex(Character(0xC5), index));
+	CHECK(index == 1);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.memory_budget")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_font_effects_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	auto referenced_handle = reinterpret_cast<FontFaceHandleDefault*>(document->GetChild(0)->GetFontFaceHandle());
+	REQUIRE(referenced_handle);
+
+	FontFaceHandleDefault* handle = FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 40);
+	REQUIRE(handle);
+	const int width = handle->GetStringWidth("Evicted text", 0.f);
+	const FontHandleStatistics initial_statistics = Rml::GetFontHandleStatistics();
+	CHECK(initial_statistics.memory_usage > 0);
+
+	// With a tiny budget, each new handle releases the resources of all other handles not referenced by any element.
+	Rml::SetFontMemoryBudget(1);
+	for (int size = 41; size < 45; size++)
+		REQUIRE(FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, size));
+
+	const FontHandleStatistics statistics = Rml::GetFontHandleStatistics();
+	CHECK(statistics.evictions >= 4);
+	CHECK(statistics.misses == initial_statistics.misses + 4);
+	CHECK(statistics.num_released_handles > 0);
+	CHECK(handle->IsReleased());
+	CHECK(handle->GetMemoryUsage() == 0);
+	CHECK(!referenced_handle->IsReleased());
+
+	// Released handles remain valid, and generate their glyphs again when used.
+	CHECK(handle->GetStringWidth("Evicted text", 0.f) == width);
+	CHECK(!handle->IsReleased());
+	CHECK(FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 40) == handle);
+	CHECK(Rml::GetFontHandleStatistics().hits == statistics.hits + 1);
+
+	// The document still renders, with geometry regenerated for any released handles.
+	context->Update();
+	context->Render();
+
+	// Handles are no longer referenced once the elements using them are destroyed.
+	document->Close();
+	context->Update();
+	REQUIRE(FontProvider::GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 45));
+	CHECK(referenced_handle->IsReleased());
+	CHECK(referenced_handle->GetMemoryUsage() == 0);
+
+	Rml::SetFontMemoryBudget(0);
+	TestsShell::ShutdownShell();
+}
@@ -27,7 +27,10 @@
  */
 
 #include "../../../Source/Core/GeometryDatabase.h"
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
 #include <RmlUi/Core/Geometry.h>
+#include <RmlUi/Core/GeometryUtilities.h>
 #include <RmlUi/Core/Types.h>
 #include <doctest.h>
 
@@ -66,3 +69,217 @@ TEST_CASE("Geometry database")
 	geometry_list.clear();
 	CHECK(ListMatchesDatabase(geometry_list));
 }
+
+TEST_CASE("Geometry database.arena")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer, which supports compiling geometry chunks.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const GeometryDatabase::ArenaStatistics stats_begin = GeometryDatabase::GetArenaStatistics();
+	const size_t quad_size = 4 * sizeof(Vertex) + 6 * sizeof(int);
+	constexpr int num_geometries = 100;
+
+	Vector<Geometry> geometry_list(num_geometries);
+	for (int i = 0; i < num_geometries; i++)
+	{
+		Vector<Vertex>& vertices = geometry_list[i].GetVertices();
+		Vector<int>& indices = geometry_list[i].GetIndices();
+		vertices.resize(4);
+		indices.resize(6);
+		GeometryUtilities::GenerateQuad(vertices.data(), indices.data(), Vector2f(float(i), 0.f), Vector2f(10.f), Colourb(255));
+	}
+
+	auto render_all = [&]() {
+		// Rendering the context compiles any modified arena chunks.
+		context->Render();
+		for (Geometry& geometry : geometry_list)
+			geometry.Render(Vector2f(0.f));
+	};
+
+	render_interface->ResetCounters();
+	const auto& counters = render_interface->GetCounters();
+
+	// All geometry should be placed in the arena during the first render, and then be compiled together.
+	render_all();
+	GeometryDatabase::ArenaStatistics stats = GeometryDatabase::GetArenaStatistics();
+	CHECK(stats.num_allocations == stats_begin.num_allocations + num_geometries);
+	CHECK(stats.used_bytes == stats_begin.used_bytes + num_geometries * quad_size);
+	CHECK(stats.used_bytes <= stats.reserved_bytes);
+	CHECK(counters.render_calls == num_geometries);
+	CHECK(counters.compile_geometry <= 1);
+
+	render_all();
+	CHECK(counters.render_calls == 2 * num_geometries);
+	CHECK(counters.compile_geometry <= 2);
+
+	for (const Geometry& geometry : geometry_list)
+		CHECK(geometry);
+
+	// No compilation should be needed when nothing changes.
+	const size_t num_compiles = counters.compile_geometry;
+	render_all();
+	CHECK(counters.compile_geometry == num_compiles);
+
+	// Accessing the data of a geometry should move it back out of the arena, intact.
+	Vector<Vertex>& vertices = geometry_list[10].GetVertices();
+	REQUIRE(vertices.size() == 4);
+	CHECK(vertices[0].position == Vector2f(10.f, 0.f));
+	CHECK(geometry_list[10].GetIndices() == Vector<int>{0, 3, 1, 1, 3, 2});
+	CHECK(GeometryDatabase::GetArenaStatistics().num_allocations == stats.num_allocations - 1);
+
+	// And then be placed back into the arena during the next render. Meanwhile, the other geometry is still rendered from the compiled chunk.
+	size_t num_chunk_renders = counters.render_chunk_calls;
+	render_all();
+	CHECK(GeometryDatabase::GetArenaStatistics().num_allocations == stats.num_allocations);
+	CHECK(counters.render_chunk_calls == num_chunk_renders + num_geometries - 1);
+
+	num_chunk_renders = counters.render_chunk_calls;
+	render_all();
+	CHECK(counters.render_chunk_calls == num_chunk_renders + num_geometries);
+
+	// Releasing all geometry should release the compiled chunks, and compile them again when rendered.
+	GeometryDatabase::ReleaseAll();
+	CHECK(counters.release_geometry >= counters.compile_geometry);
+	render_all();
+	CHECK(counters.compile_geometry > counters.release_geometry);
+
+	geometry_list.clear();
+	stats = GeometryDatabase::GetArenaStatistics();
+	CHECK(stats.num_allocations == stats_begin.num_allocations);
+	CHECK(stats.used_bytes == stats_begin.used_bytes);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Geometry database.arena_sharing")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer, which supports compiling geometry chunks.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const GeometryDatabase::ArenaStatistics stats_begin = GeometryDatabase::GetArenaStatistics();
+	const size_t quad_size = 4 * sizeof(Vertex) + 6 * sizeof(int);
+	constexpr int num_geometries = 100;
+
+	// Every other geometry is identical, these should all share a single allocation.
+	Vector<Geometry> geometry_list(num_geometries);
+	for (int i = 0; i < num_geometries; i++)
+	{
+		Vector<Vertex>& vertices = geometry_list[i].GetVertices();
+		Vector<int>& indices = geometry_list[i].GetIndices();
+		vertices.resize(4);
+		indices.resize(6);
+		const Vector2f origin = (i % 2 == 0 ? Vector2f(0.f) : Vector2f(float(i), 0.f));
+		GeometryUtilities::GenerateQuad(vertices.data(), indices.data(), origin, Vector2f(10.f), Colourb(255));
+	}
+
+	context->Render();
+	for (Geometry& geometry : geometry_list)
+		geometry.Render(Vector2f(float(&geometry - geometry_list.data()), 0.f));
+
+	GeometryDatabase::ArenaStatistics stats = GeometryDatabase::GetArenaStatistics();
+	CHECK(stats.num_references == stats_begin.num_references + num_geometries);
+	CHECK(stats.num_allocations == stats_begin.num_allocations + num_geometries / 2 + 1);
+	CHECK(stats.used_bytes == stats_begin.used_bytes + (num_geometries / 2 + 1) * quad_size);
+
+	// Modifying one of the shared geometries moves it out of the arena, leaving the others unaffected.
+	geometry_list[0].GetVertices()[0].colour = Colourb(0);
+	CHECK(geometry_list[0].GetVertices().size() == 4);
+	CHECK(geometry_list[2].GetVertices().size() == 4);
+	CHECK(geometry_list[2].GetVertices()[0].colour == Colourb(255));
+
+	stats = GeometryDatabase::GetArenaStatistics();
+	CHECK(stats.num_references == stats_begin.num_references + num_geometries - 2);
+	CHECK(stats.num_allocations == stats_begin.num_allocations + num_geometries / 2 + 1);
+
+	geometry_list.clear();
+	stats = GeometryDatabase::GetArenaStatistics();
+	CHECK(stats.num_references == stats_begin.num_references);
+	CHECK(stats.num_allocations == stats_begin.num_allocations);
+	CHECK(stats.used_bytes == stats_begin.used_bytes);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Geometry database.batch")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer, where we can disable the geometry arena.
+	if (!render_interface)
+		return;
+
+	// Without support for geometry chunks, all geometry is compiled separately. Start from a fresh shell so that support is detected again.
+	TestsShell::ShutdownShell();
+	render_interface->SetGeometryChunksSupported(false);
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	constexpr int num_geometries = 100;
+
+	Vector<Geometry> geometry_list(num_geometries);
+	for (int i = 0; i < num_geometries; i++)
+	{
+		Vector<Vertex>& vertices = geometry_list[i].GetVertices();
+		Vector<int>& indices = geometry_list[i].GetIndices();
+		vertices.resize(4);
+		indices.resize(6);
+		GeometryUtilities::GenerateQuad(vertices.data(), indices.data(), Vector2f(float(i), 0.f), Vector2f(10.f), Colourb(255));
+	}
+
+	auto render_all = [&]() {
+		// Rendering the context compiles any staged geometry.
+		context->Render();
+		for (Geometry& geometry : geometry_list)
+			geometry.Render(Vector2f(0.f));
+	};
+
+	render_interface->ResetCounters();
+	const auto& counters = render_interface->GetCounters();
+
+	// During the first render, the geometry is staged and rendered uncompiled.
+	render_all();
+	CHECK(counters.render_calls == num_geometries);
+	CHECK(counters.compile_geometry == 0);
+	CHECK(counters.compile_geometry_batch == 0);
+
+	// Then all of it is compiled in a single batch during the next render.
+	render_all();
+	CHECK(counters.render_calls == 2 * num_geometries);
+	CHECK(counters.compile_geometry == num_geometries);
+	CHECK(counters.compile_geometry_batch == 1);
+
+	render_all();
+	CHECK(counters.compile_geometry == num_geometries);
+	CHECK(counters.compile_geometry_batch == 1);
+
+	// Modified geometry is staged again, while geometry released before its batch is compiled is dropped from the batch.
+	geometry_list[10].GetVertices()[0].colour = Colourb(0);
+	geometry_list[10].Release();
+	geometry_list[20].Release();
+	geometry_list[30].Release();
+	render_all();
+	CHECK(counters.release_geometry == 3);
+	geometry_list[30].Release();
+	render_all();
+	CHECK(counters.compile_geometry == num_geometries + 2);
+	CHECK(counters.compile_geometry_batch == 2);
+
+	// Compiled geometry which has not been taken yet is released along with its geometry.
+	geometry_list[40].Release();
+	context->Render();
+	geometry_list.clear();
+	CHECK(counters.release_geometry == counters.compile_geometry);
+
+	render_interface->SetGeometryChunksSupported(true);
+	TestsShell::ShutdownShell();
+}
@@ -154,3 +154,81 @@ TEST_CASE("Math.Max")
 	CHECK(Math::Max<Vector2f>({2, 2}, {1, 1}) == Vector2f(2, 2));
 	CHECK(Math::Max<Vector2f>({2, 1}, {1, 2}) == Vector2f(2, 2));
 }
+
+TEST_CASE_TEMPLATE("Math.Matrix4", MatrixType, ColumnMajorMatrix4f, RowMajorMatrix4f)
+{
+	// Generate the matrices from a fixed sequence of pseudo-random numbers.
+	uint32_t seed = 1;
+	auto random = [&]() {
+		seed = seed * 1664525u + 1013904223u;
+		return float(int(seed >> 8) % 2000 - 1000) / 100.f;
+	};
+	auto random_matrix = [&](float diagonal) {
+		float components[16];
+		for (int i = 0; i < 16; i++)
+			components[i] = random() + (i % 5 == 0 ? diagonal : 0.f);
+		return MatrixType::FromRowMajor(components);
+	};
+	auto element = [](const MatrixType& m, int row, int column) { return float(m.GetRow(row)[column]); };
+
+	constexpr float tolerance = 1e-3f;
+
+	for (int iteration = 0; iteration < 100; iteration++)
+	{
+		const MatrixType a = random_matrix(0.f);
+		const MatrixType b = random_matrix(0.f);
+		const Vector4f v(random(), random(), random(), random());
+
+		const MatrixType product = a * b;
+		const Vector4f product_vector = a * v;
+
+		for (int i = 0; i < 4; i++)
+		{
+			double expected_vector = 0;
+			for (int k = 0; k < 4; k++)
+				expected_vector += double(element(a, i, k)) * double(v[k]);
+			CHECK(Math::Absolute(product_vector[i] - float(expected_vector)) < tolerance);
+
+			for (int j = 0; j < 4; j++)
+			{
+				double expected = 0;
+				for (int k = 0; k < 4; k++)
+					expected += double(element(a, i, k)) * double(element(b, k, j));
+				CHECK(Math::Absolute(element(product, i, j) - float(expected)) < tolerance);
+			}
+		}
+
+		// Make the matrix diagonally dominant so that it is well-conditioned.
+		const MatrixType m = random_matrix(50.f);
+		MatrixType inverse = m;
+		REQUIRE(inverse.Invert());
+
+		const MatrixType identity = m * inverse;
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				CHECK(Math::Absolute(element(identity, i, j) - (i == j ? 1.f : 0.f)) < tolerance);
+	}
+
+	// Invert a typical element transform, and project a point back into the element's space.
+	{
+		const MatrixType transform = MatrixType::Translate(400.f, 300.f, 0.f) * MatrixType::Perspective(500.f) * MatrixType::RotateY(0.6f) *
+			MatrixType::RotateZ(-0.3f) * MatrixType::Scale(1.5f, 0.5f, 1.f) * MatrixType::Translate(-50.f, -20.f, 0.f);
+		MatrixType inverse = transform;
+		REQUIRE(inverse.Invert());
+
+		const Vector4f point(120.f, 75.f, 0.f, 1.f);
+		const Vector3f result = (inverse * (transform * point)).PerspectiveDivide();
+		CHECK(Math::Absolute(result.x - point.x) < tolerance);
+		CHECK(Math::Absolute(result.y - point.y) < tolerance);
+		CHECK(Math::Absolute(result.z - point.z) < tolerance);
+	}
+
+	// Singular matrices can not be inverted.
+	{
+		MatrixType scale_zero = MatrixType::Scale(0.f, 1.f, 1.f);
+		CHECK(!scale_zero.Invert());
+
+		MatrixType repeated_row = MatrixType::FromRows({1, 2, 3, 4}, {1, 2, 3, 4}, {5, 6, 7, 9}, {2, 1, 0, 3});
+		CHECK(!repeated_row.Invert());
+	}
+}
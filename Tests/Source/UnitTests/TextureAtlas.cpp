@@ -0,0 +1,212 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../../Source/Core/TextureAtlas.h"
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static Vector<byte> CreateImageData(Vector2i dimensions)
+{
+	return Vector<byte>(size_t(dimensions.x * dimensions.y * 4), byte(255));
+}
+
+static bool RegionsOverlap(const Vector<Rectanglef>& regions)
+{
+	for (size_t i = 0; i < regions.size(); i++)
+	{
+		for (size_t j = i + 1; j < regions.size(); j++)
+		{
+			if (regions[i].Intersects(regions[j]))
+				return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("TextureAtlas")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	REQUIRE(TestsShell::GetContext());
+
+	render_interface->ResetCounters();
+	const auto& counters = render_interface->GetCounters();
+
+	TextureAtlas atlas;
+	Vector<int> image_indices;
+
+	for (int i = 0; i < 50; i++)
+	{
+		const Vector2i dimensions(8 + i, 64 - i);
+		image_indices.push_back(atlas.Add(CreateImageData(dimensions), dimensions));
+	}
+
+	CHECK(atlas.GetNumImages() == 50);
+	CHECK(atlas.GetNumPages() == 1);
+	CHECK(counters.generate_texture == 0);
+
+	auto get_regions = [&]() {
+		Vector<Rectanglef> regions;
+		for (int image_index : image_indices)
+		{
+			CHECK(atlas.GetHandle(image_index) != 0);
+			regions.push_back(atlas.GetRegion(image_index));
+		}
+		return regions;
+	};
+
+	// The page is generated once when the first image is used.
+	Vector<Rectanglef> regions = get_regions();
+	CHECK(counters.generate_texture == 1);
+	CHECK(!RegionsOverlap(regions));
+	for (const Rectanglef& region : regions)
+	{
+		CHECK(region.Left() > 0.f);
+		CHECK(region.Top() > 0.f);
+		CHECK(region.Right() < 1.f);
+		CHECK(region.Bottom() < 1.f);
+	}
+
+	SUBCASE("Remove")
+	{
+		// Removing a few images leaves the layout intact.
+		for (int i = 0; i < 10; i++)
+			atlas.Remove(image_indices[i]);
+		image_indices.erase(image_indices.begin(), image_indices.begin() + 10);
+
+		const Vector<Rectanglef> regions_after_remove = get_regions();
+		CHECK(Vector<Rectanglef>(regions.begin() + 10, regions.end()) == regions_after_remove);
+		CHECK(counters.generate_texture == 1);
+
+		// Once most of the page is unused, the remaining images are laid out again on a new texture.
+		for (int i = 0; i < 30; i++)
+			atlas.Remove(image_indices[i]);
+		image_indices.erase(image_indices.begin(), image_indices.begin() + 30);
+
+		CHECK(!RegionsOverlap(get_regions()));
+		CHECK(atlas.GetNumImages() == 10);
+		CHECK(counters.generate_texture == 2);
+		CHECK(counters.release_texture == 1);
+
+		// Removing every image releases the page.
+		for (int image_index : image_indices)
+			atlas.Remove(image_index);
+		CHECK(atlas.GetNumImages() == 0);
+		CHECK(atlas.GetNumPages() == 0);
+		CHECK(counters.release_texture == 2);
+	}
+
+	SUBCASE("Overflow")
+	{
+		// Add more images than can fit on a single page.
+		for (int i = 0; i < 300; i++)
+		{
+			const Vector2i dimensions(64, 64);
+			image_indices.push_back(atlas.Add(CreateImageData(dimensions), dimensions));
+		}
+
+		regions = get_regions();
+		CHECK(atlas.GetNumPages() == 2);
+		CHECK(counters.generate_texture == 3);
+		CHECK(counters.release_texture == 1);
+	}
+
+	SUBCASE("ReleaseTextures")
+	{
+		atlas.ReleaseTextures();
+		CHECK(counters.release_texture == 1);
+
+		// Pages are generated again on use, without moving any images.
+		CHECK(get_regions() == regions);
+		CHECK(counters.generate_texture == 2);
+	}
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("TextureAtlas.reload_image_data")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	REQUIRE(TestsShell::GetContext());
+
+	render_interface->ResetCounters();
+	render_interface->SetTextureDataSupported(true);
+	const auto& counters = render_interface->GetCounters();
+
+	TextureAtlas atlas;
+	Vector<int> image_indices;
+
+	// Images with a source, matching the dimensions of the texture data provided by the dummy renderer.
+	const Vector2i dimensions(16, 16);
+	for (int i = 0; i < 10; i++)
+		image_indices.push_back(atlas.Add(CreateImageData(dimensions), dimensions, "image.tga"));
+
+	// Images without a source keep their data.
+	const Vector2i dimensions_no_source(8, 8);
+	image_indices.push_back(atlas.Add(CreateImageData(dimensions_no_source), dimensions_no_source));
+
+	const size_t no_source_data_size = size_t(dimensions_no_source.x * dimensions_no_source.y * 4);
+	CHECK(atlas.GetImageDataSize() == 10 * size_t(dimensions.x * dimensions.y * 4) + no_source_data_size);
+
+	auto get_regions = [&]() {
+		Vector<Rectanglef> regions;
+		for (int image_index : image_indices)
+		{
+			CHECK(atlas.GetHandle(image_index) != 0);
+			regions.push_back(atlas.GetRegion(image_index));
+		}
+		return regions;
+	};
+
+	// The image data is released once the page has been generated.
+	const Vector<Rectanglef> regions = get_regions();
+	CHECK(counters.generate_texture == 1);
+	CHECK(counters.load_texture_data == 0);
+	CHECK(atlas.GetImageDataSize() == no_source_data_size);
+
+	// Generating the page again loads the data from the source, and releases it again afterwards.
+	atlas.ReleaseTextures();
+	CHECK(get_regions() == regions);
+	CHECK(counters.generate_texture == 2);
+	CHECK(counters.load_texture_data == 10);
+	CHECK(atlas.GetImageDataSize() == no_source_data_size);
+
+	render_interface->SetTextureDataSupported(false);
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,144 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../../Source/Core/TextureLayout.h"
+#include "../../../Source/Core/TextureLayoutSkyline.h"
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+// Returns true if any of the rectangles, including a pixel of padding to the right and below each, overlap.
+static bool RectanglesOverlap(const Vector<Rectanglei>& rectangles)
+{
+	for (size_t i = 0; i < rectangles.size(); i++)
+	{
+		for (size_t j = i + 1; j < rectangles.size(); j++)
+		{
+			const Rectanglei& a = rectangles[i];
+			const Rectanglei& b = rectangles[j];
+			if (a.Left() < b.Right() + 1 && b.Left() < a.Right() + 1 && a.Top() < b.Bottom() + 1 && b.Top() < a.Bottom() + 1)
+				return true;
+		}
+	}
+	return false;
+}
+
+static bool InsideTexture(const Rectanglei& rectangle, Vector2i texture_dimensions)
+{
+	return rectangle.Left() >= 1 && rectangle.Top() >= 1 && rectangle.Right() + 1 <= texture_dimensions.x &&
+		rectangle.Bottom() + 1 <= texture_dimensions.y;
+}
+
+TEST_CASE("TextureLayout")
+{
+	Vector<Vector2i> rectangle_dimensions;
+	for (int i = 0; i < 600; i++)
+		rectangle_dimensions.push_back(Vector2i(5 + (i * 7) % 19, 8 + (i * 11) % 17));
+
+	constexpr int max_texture_dimensions = 256;
+
+	auto generate_layout = [&](TextureLayout& layout, TextureLayoutPacking packing) {
+		for (int i = 0; i < (int)rectangle_dimensions.size(); i++)
+			layout.AddRectangle(i, rectangle_dimensions[i]);
+		REQUIRE(layout.GenerateLayout(max_texture_dimensions, packing));
+		REQUIRE(layout.GetNumRectangles() == (int)rectangle_dimensions.size());
+
+		int texture_area = 0;
+		for (int texture_index = 0; texture_index < layout.GetNumTextures(); texture_index++)
+		{
+			const Vector2i texture_dimensions = layout.GetTexture(texture_index).GetDimensions();
+			texture_area += texture_dimensions.x * texture_dimensions.y;
+
+			Vector<Rectanglei> placed_rectangles;
+			for (int i = 0; i < layout.GetNumRectangles(); i++)
+			{
+				TextureLayoutRectangle& rectangle = layout.GetRectangle(i);
+				REQUIRE(rectangle.IsPlaced());
+				CHECK(rectangle.GetDimensions() == rectangle_dimensions[rectangle.GetId()]);
+				if (rectangle.GetTextureIndex() != texture_index)
+					continue;
+
+				const Rectanglei placed_rectangle = Rectanglei::FromPositionSize(rectangle.GetPosition(), rectangle.GetDimensions());
+				CHECK(InsideTexture(placed_rectangle, texture_dimensions));
+				placed_rectangles.push_back(placed_rectangle);
+			}
+			CHECK(!RectanglesOverlap(placed_rectangles));
+		}
+		return texture_area;
+	};
+
+	TextureLayout row_layout;
+	const int row_texture_area = generate_layout(row_layout, TextureLayoutPacking::Rows);
+
+	TextureLayout skyline_layout;
+	const int skyline_texture_area = generate_layout(skyline_layout, TextureLayoutPacking::Skyline);
+
+	CHECK(skyline_layout.GetNumTextures() <= row_layout.GetNumTextures());
+	CHECK(skyline_texture_area <= row_texture_area);
+}
+
+TEST_CASE("TextureLayoutSkyline")
+{
+	const Vector2i texture_dimensions(128, 128);
+	TextureLayoutSkyline skyline(texture_dimensions);
+
+	// A reserved area, such as rectangles placed by another layout, must be kept clear.
+	const Rectanglei reserved = Rectanglei::FromPositionSize(Vector2i(1, 1), Vector2i(60, 30));
+	skyline.Reserve(reserved.Position(), reserved.Size());
+
+	// Insert rectangles one at a time until the texture is full.
+	Vector<Rectanglei> placed_rectangles = {reserved};
+	int num_failed = 0;
+	for (int i = 0; num_failed < 10; i++)
+	{
+		const Vector2i dimensions(4 + (i * 5) % 13, 6 + (i * 3) % 11);
+		Vector2i position;
+		if (!skyline.Allocate(dimensions, position))
+		{
+			num_failed += 1;
+			continue;
+		}
+
+		const Rectanglei placed_rectangle = Rectanglei::FromPositionSize(position, dimensions);
+		CHECK(InsideTexture(placed_rectangle, texture_dimensions));
+		placed_rectangles.push_back(placed_rectangle);
+	}
+
+	CHECK(!RectanglesOverlap(placed_rectangles));
+
+	int used_area = 0;
+	for (const Rectanglei& rectangle : placed_rectangles)
+		used_area += (rectangle.Width() + 1) * (rectangle.Height() + 1);
+
+	// Incremental insertion should still fill most of the texture.
+	CHECK(used_area > texture_dimensions.x * texture_dimensions.y * 8 / 10);
+
+	Vector2i position;
+	CHECK(!skyline.Allocate(texture_dimensions, position));
+}
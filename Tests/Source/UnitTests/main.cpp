@@ -30,5 +30,6 @@
 #include <doctest.h>
 
 // Include common tests source
+#include "../Common/InstrumentedRenderInterface.cpp"
 #include "../Common/TestsInterface.cpp"
 #include "../Common/TestsShell.cpp"